@@ -0,0 +1,226 @@
+// Arenas for compiled UTF-8-ready wildcard patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+//
+// An arena is a list of chunks, newest first, and hands out memory from 
+// the newest chunk by bumping an offset.  When the newest chunk has no 
+// room, a new one is added, of cbChunk bytes or of the size asked for, if 
+// that's larger.  So everything allocated from an arena sits packed 
+// together, without a heap header per allocation, and releasing the arena 
+// takes one free() per chunk.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildarena.h"
+
+#define WILD_ARENA_ALIGN  64     // Alignment of each chunk's data
+
+struct WildArenaChunk
+{
+	WildArenaChunk *pNext;         // The next older chunk
+	unsigned char  *pData;         // Following the chunk, unless fixed
+	size_t          cbData;
+	size_t          cbUsed;
+};
+
+struct WildArena
+{
+	WildArenaChunk *pChunks;       // Newest first
+	size_t          cbChunk;       // Least to add, or 0 for a fixed arena
+	size_t          cbAllocated;   // Bytes handed out, with padding
+	size_t          cbReserved;    // Bytes of chunk data
+	WildArenaChunk  fixed;         // The only chunk of a fixed arena
+};
+
+
+// Adds a chunk with room for at least cbData bytes at any alignment up to 
+// WILD_ARENA_ALIGN.  Returns false if memory for it can't be allocated.
+//
+bool WildArenaGrow(WildArena *pArena, size_t cbData)
+{
+	WildArenaChunk *pChunk;
+
+	if (cbData < pArena->cbChunk)
+	{
+		cbData = pArena->cbChunk;
+	}
+
+	if (cbData > SIZE_MAX - sizeof(WildArenaChunk) - WILD_ARENA_ALIGN)
+	{
+		return false;
+	}
+
+	pChunk = (WildArenaChunk *) malloc(sizeof(WildArenaChunk) + cbData + 
+	                                   WILD_ARENA_ALIGN);
+
+	if (!pChunk)
+	{
+		return false;
+	}
+
+	pChunk->pData = (unsigned char *) (((uintptr_t) (pChunk + 1) + 
+	    WILD_ARENA_ALIGN - 1) & ~(uintptr_t) (WILD_ARENA_ALIGN - 1));
+	pChunk->cbData = cbData;
+	pChunk->cbUsed = 0;
+	pChunk->pNext = pArena->pChunks;
+	pArena->pChunks = pChunk;
+	pArena->cbReserved += cbData;
+	return true;
+}
+
+
+// Creates an arena that grows by chunks of at least cbChunk bytes.  The 
+// first chunk is allocated right away, so that an arena sized for its 
+// contents keeps them in one block.  Returns NULL if memory for the arena 
+// can't be allocated.
+//
+WildArena *FastWildArenaCreate(size_t cbChunk)
+{
+	WildArena *pArena = (WildArena *) calloc(1, sizeof(WildArena));
+
+	if (!pArena)
+	{
+		return NULL;
+	}
+
+	pArena->cbChunk = cbChunk ? cbChunk : 1;
+
+	if (!WildArenaGrow(pArena, pArena->cbChunk))
+	{
+		free(pArena);
+		return NULL;
+	}
+
+	return pArena;
+}
+
+
+// Creates an arena over a buffer of cbBuffer bytes, which it never grows 
+// beyond.  The caller releases the buffer, after freeing the arena.  
+// Returns NULL if memory for the arena can't be allocated.
+//
+WildArena *FastWildArenaCreateFixed(void *pBuffer, size_t cbBuffer)
+{
+	WildArena *pArena = (WildArena *) calloc(1, sizeof(WildArena));
+
+	if (!pArena)
+	{
+		return NULL;
+	}
+
+	pArena->fixed.pData = (unsigned char *) pBuffer;
+	pArena->fixed.cbData = cbBuffer;
+	pArena->pChunks = &pArena->fixed;
+	pArena->cbReserved = cbBuffer;
+	return pArena;
+}
+
+
+// Allocates cbAlloc zeroed bytes from an arena, aligned to cbAlign, which 
+// is a power of 2.  Returns NULL if there's no room for them in a fixed 
+// arena, or if memory for another chunk can't be allocated.
+//
+void *FastWildArenaAlloc(WildArena *pArena, size_t cbAlloc, size_t cbAlign)
+{
+	WildArenaChunk *pChunk = pArena->pChunks;
+	uintptr_t       iAt;
+	size_t          cbPadding;
+
+	cbAlign = cbAlign ? cbAlign : 1;
+	iAt = ((uintptr_t) (pChunk->pData + pChunk->cbUsed) + cbAlign - 1) & 
+	      ~(uintptr_t) (cbAlign - 1);
+	cbPadding = iAt - (uintptr_t) (pChunk->pData + pChunk->cbUsed);
+
+	if (cbAlloc > pChunk->cbData - pChunk->cbUsed || 
+	    cbPadding > pChunk->cbData - pChunk->cbUsed - cbAlloc)
+	{
+		if (!pArena->cbChunk || cbAlign > WILD_ARENA_ALIGN || 
+		    !WildArenaGrow(pArena, cbAlloc))
+		{
+			return NULL;
+		}
+
+		pChunk = pArena->pChunks;
+		iAt = (uintptr_t) pChunk->pData;
+		cbPadding = 0;
+	}
+
+	pChunk->cbUsed += cbPadding + cbAlloc;
+	pArena->cbAllocated += cbPadding + cbAlloc;
+	memset((void *) iAt, 0, cbAlloc);
+	return (void *) iAt;
+}
+
+
+// Reports the bytes allocated from an arena so far, counting alignment 
+// padding, and the bytes its chunks occupy.
+//
+void FastWildArenaBytes(WildArena *pArena, size_t *pcbAllocated, 
+                        size_t *pcbReserved)
+{
+	*pcbAllocated = pArena->cbAllocated;
+	*pcbReserved = pArena->cbReserved;
+	return;
+}
+
+
+// Releases everything allocated from an arena, along with every chunk but 
+// the first.
+//
+void FastWildArenaReset(WildArena *pArena)
+{
+	while (pArena->pChunks->pNext)
+	{
+		WildArenaChunk *pChunk = pArena->pChunks;
+
+		pArena->pChunks = pChunk->pNext;
+		pArena->cbReserved -= pChunk->cbData;
+		free(pChunk);
+	}
+
+	pArena->pChunks->cbUsed = 0;
+	pArena->cbAllocated = 0;
+	return;
+}
+
+
+// Releases an arena, along with everything allocated from it.  The buffer 
+// of a fixed arena is left to the caller.
+//
+void FastWildArenaFree(WildArena *pArena)
+{
+	if (!pArena)
+	{
+		return;
+	}
+
+	while (pArena->pChunks && pArena->pChunks != &pArena->fixed)
+	{
+		WildArenaChunk *pChunk = pArena->pChunks;
+
+		pArena->pChunks = pChunk->pNext;
+		free(pChunk);
+	}
+
+	free(pArena);
+	return;
+}
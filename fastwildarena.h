@@ -0,0 +1,25 @@
+// Arenas, for keeping many compiled patterns and pattern sets together in 
+// a few large blocks of memory, and releasing them all at once.
+//
+// FastWildArenaCreate() creates an arena that grows, as needed, by chunks 
+// of at least cbChunk bytes.  FastWildArenaCreateFixed() creates one over 
+// a buffer that the caller provides and releases, and that never grows.  
+// FastWildArenaAlloc() hands out zeroed memory at the given power-of-2 
+// alignment, or NULL if there's no room for it.  Nothing allocated from an 
+// arena is released on its own.  FastWildArenaReset() releases everything 
+// allocated so far, keeping the arena's first chunk for reuse, and 
+// FastWildArenaFree() releases the arena along with everything in it.
+//
+// FastWildArenaBytes() reports the bytes allocated so far, counting 
+// alignment padding, and the bytes the arena's chunks occupy.
+#include <stddef.h>
+
+struct WildArena;
+
+WildArena *FastWildArenaCreate(size_t cbChunk);
+WildArena *FastWildArenaCreateFixed(void *pBuffer, size_t cbBuffer);
+void *FastWildArenaAlloc(WildArena *pArena, size_t cbAlloc, size_t cbAlign);
+void FastWildArenaBytes(WildArena *pArena, size_t *pcbAllocated, 
+                        size_t *pcbReserved);
+void FastWildArenaReset(WildArena *pArena);
+void FastWildArenaFree(WildArena *pArena);
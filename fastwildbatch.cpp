@@ -0,0 +1,756 @@
+// Batch routines for matching wildcards in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// When tame strings are scattered across a large heap, a loop that calls 
+// FastWildCompareUtf8() for each one stalls on the first cache miss of 
+// every string.  The routines here interleave several matches instead, in 
+// the style of asynchronous memory access chaining (AMAC): each match is 
+// a resumable state machine that issues a prefetch, and yields to the next 
+// match, whenever it is about to touch a cache line of its tame string 
+// that it hasn't prefetched yet.  By the time the match is resumed, its 
+// line has usually arrived.
+//
+// For short strings, a scalar match per string leaves most of a vector 
+// register unused.  FastWildCompareUtf8Lanes() instead transposes a batch 
+// of strings so that each string occupies one byte lane, and runs the 
+// pattern as a position automaton over all lanes at once: for each pattern 
+// position there's a vector whose lanes are set for the strings that have 
+// matched the pattern up to that position.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "fastwildcompare.h"
+#include "fastwildbatch.h"
+#include "fastwildutf8.h"
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define WILD_PREFETCH(p)  _mm_prefetch((const char *) (p), _MM_HINT_T0)
+#else
+#define WILD_PREFETCH(p)  __builtin_prefetch(p)
+#endif
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define WILD_LANES  32
+typedef __m256i WildLaneVector;
+#define LaneLoad(p)      _mm256_loadu_si256((const __m256i *) (p))
+#define LaneSplat(ch)    _mm256_set1_epi8((char) (ch))
+#define LaneZero()       _mm256_setzero_si256()
+#define LaneAnd(a, b)    _mm256_and_si256(a, b)
+#define LaneAndNot(a, b) _mm256_andnot_si256(a, b)
+#define LaneOr(a, b)     _mm256_or_si256(a, b)
+#define LaneEqual(a, b)  _mm256_cmpeq_epi8(a, b)
+#define LaneBits(a)      ((uint32_t) _mm256_movemask_epi8(a))
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WILD_LANES  16
+typedef __m128i WildLaneVector;
+#define LaneLoad(p)      _mm_loadu_si128((const __m128i *) (p))
+#define LaneSplat(ch)    _mm_set1_epi8((char) (ch))
+#define LaneZero()       _mm_setzero_si128()
+#define LaneAnd(a, b)    _mm_and_si128(a, b)
+#define LaneAndNot(a, b) _mm_andnot_si128(a, b)
+#define LaneOr(a, b)     _mm_or_si128(a, b)
+#define LaneEqual(a, b)  _mm_cmpeq_epi8(a, b)
+#define LaneBits(a)      ((uint32_t) _mm_movemask_epi8(a))
+#endif
+
+#define WILD_LANE_MAX_TAME  64   // Most bytes of a string run in a lane
+#define WILD_LANE_MAX_WILD  64   // Longest pattern, in bytes, run in lanes
+#define WILD_LANE_FEW  (WILD_LANES / 8)  // Lanes not worth running on
+
+#define WILD_CACHE_LINE   64     // Bytes per prefetched line
+#define WILD_READ_AHEAD   8      // Bytes read, at most, from a tame position
+#define WILD_BATCH_WIDTH  8      // Matches in flight at once
+#define WILD_PAGE         4096   // Smallest page size, for safe over-reads
+
+// Results of WildMatchResume().
+//
+#define WILD_MATCH_FALSE    0
+#define WILD_MATCH_TRUE     1
+#define WILD_MATCH_PENDING  2
+
+// Places to resume a match.  Each corresponds to the top of a loop in 
+// FastWildCompareUtf8(), where no state has yet been changed for the 
+// iteration and the match can simply be started over from that point.
+//
+#define WILD_STEP_UPPER          0   // Upper loop, before any '*'
+#define WILD_STEP_UPPER_SEARCH   1   // Search after the first '*'
+#define WILD_STEP_LOWER          2   // Lower loop
+#define WILD_STEP_LOWER_SEARCH   3   // Search after a further '*'
+#define WILD_STEP_LOWER_FALLBACK 4   // Fallback to a prospective match
+#define WILD_STEP_LOWER_END      5   // Check for the end, at the end
+
+// Everything needed to resume one match.
+//
+struct WildMatchState
+{
+	char   *pWild;
+	char   *pTame;
+	char   *pWildSequence;
+	char   *pTameSequence;
+	char   *pTameLimit;     // First tame byte not covered by a prefetch
+	size_t  iTame;          // Index of the tame string in the batch
+	int     iStep;          // Where to resume
+};
+
+
+// Returns true, after issuing a prefetch, if a read of tame content at 
+// pTame would touch a line that hasn't been prefetched for this match.  
+// Content before the limit has either been prefetched or already read, 
+// since every match only falls back to positions it has passed.
+//
+inline bool WildMatchNeedsPrefetch(WildMatchState *pState, char *pTame)
+{
+	if (pTame + WILD_READ_AHEAD <= pState->pTameLimit)
+	{
+		return false;
+	}
+
+	WILD_PREFETCH(pTame);
+	WILD_PREFETCH(pTame + WILD_READ_AHEAD - 1);
+	pState->pTameLimit = (char *) (((uintptr_t) pTame + WILD_READ_AHEAD + 
+	    WILD_CACHE_LINE - 1) & ~(uintptr_t) (WILD_CACHE_LINE - 1));
+	return true;
+}
+
+
+// Sets up a match and prefetches the start of its tame string.
+//
+inline void WildMatchStart(WildMatchState *pState, char *pWild, char *pTame,
+                           size_t iTame)
+{
+	pState->pWild = pWild;
+	pState->pTame = pTame;
+	pState->pTameLimit = NULL;
+	pState->iTame = iTame;
+	pState->iStep = WILD_STEP_UPPER;
+	WildMatchNeedsPrefetch(pState, pTame);
+}
+
+
+// Runs a match, as FastWildCompareUtf8() would, until it either completes 
+// or yields ahead of a likely cache miss.  Returns WILD_MATCH_TRUE or 
+// WILD_MATCH_FALSE when the match is complete, or WILD_MATCH_PENDING to be 
+// called again.  PERFORMS NO UTF-8 VALIDATION.
+//
+int WildMatchResume(WildMatchState *pState)
+{
+	char *pWild = pState->pWild;
+	char *pTame = pState->pTame;
+	int   iResult;
+
+	do
+	{
+		switch (pState->iStep)
+		{
+		case WILD_STEP_UPPER:
+			if (WildMatchNeedsPrefetch(pState, pTame))
+			{
+				iResult = WILD_MATCH_PENDING;
+				break;
+			}
+
+			// Check for the end from the start.
+			if (!*pTame)
+			{
+				while (*pWild == '*')
+				{
+					++pWild;
+				}
+
+				return !*pWild;        // "ab" matches "ab*".
+			}
+			else if (*pWild == '*')
+			{
+				// Got wild: set up for the second loop.
+				while (CodePointAdvance(&pWild) && *pWild == '*')
+				{
+					continue;
+				}
+
+				if (!*pWild)
+				{
+					return WILD_MATCH_TRUE;
+				}
+
+				pState->iStep = WILD_STEP_UPPER_SEARCH;
+				continue;
+			}
+			else if (!CodePointCompare(pWild, pTame) && *pWild != '?')
+			{
+				return WILD_MATCH_FALSE;
+			}
+
+			CodePointAdvance(&pWild);
+			CodePointAdvance(&pTame);
+			continue;
+
+		case WILD_STEP_UPPER_SEARCH:
+		case WILD_STEP_LOWER_SEARCH:
+			if (WildMatchNeedsPrefetch(pState, pTame))
+			{
+				iResult = WILD_MATCH_PENDING;
+				break;
+			}
+
+			// Search for the next prospective match.
+			if (*pWild != '?' && !CodePointCompare(pWild, pTame))
+			{
+				if (!CodePointAdvance(&pTame))
+				{
+					return WILD_MATCH_FALSE;
+				}
+
+				continue;
+			}
+
+			// Keep fallback positions for retry in case of incomplete match.
+			pState->pWildSequence = pWild;
+			pState->pTameSequence = pTame;
+			pState->iStep = pState->iStep == WILD_STEP_UPPER_SEARCH ?
+			                WILD_STEP_LOWER : WILD_STEP_LOWER_END;
+			continue;
+
+		case WILD_STEP_LOWER:
+			if (WildMatchNeedsPrefetch(pState, pTame))
+			{
+				iResult = WILD_MATCH_PENDING;
+				break;
+			}
+
+			if (*pWild == '*')
+			{
+				// Got wild again.
+				while (*(++pWild) == '*')
+				{
+					continue;
+				}
+
+				if (!*pWild)
+				{
+					return WILD_MATCH_TRUE;
+				}
+
+				if (!*pTame)
+				{
+					return WILD_MATCH_FALSE;
+				}
+
+				pState->iStep = WILD_STEP_LOWER_SEARCH;
+				continue;
+			}
+			else if (!CodePointCompare(pWild, pTame) && *pWild != '?')
+			{
+				if (!*pTame)
+				{
+					return WILD_MATCH_FALSE;
+				}
+
+				// A fine time for questions.
+				while (*pState->pWildSequence == '?')
+				{
+					++pState->pWildSequence;
+					CodePointAdvance(&pState->pTameSequence);
+				}
+
+				// Fall back, but never so far again.
+				pWild = pState->pWildSequence;
+				pState->iStep = WILD_STEP_LOWER_FALLBACK;
+				continue;
+			}
+
+			pState->iStep = WILD_STEP_LOWER_END;
+			continue;
+
+		case WILD_STEP_LOWER_FALLBACK:
+			if (WildMatchNeedsPrefetch(pState, pState->pTameSequence))
+			{
+				iResult = WILD_MATCH_PENDING;
+				break;
+			}
+
+			if (!CodePointAdvanceAndCompare(pWild, &pState->pTameSequence))
+			{
+				if (!*pState->pTameSequence)
+				{
+					return WILD_MATCH_FALSE;
+				}
+
+				continue;
+			}
+
+			pTame = pState->pTameSequence;
+			pState->iStep = WILD_STEP_LOWER_END;
+			continue;
+
+		case WILD_STEP_LOWER_END:
+			if (WildMatchNeedsPrefetch(pState, pTame))
+			{
+				iResult = WILD_MATCH_PENDING;
+				break;
+			}
+
+			// Another check for the end, at the end.
+			if (!*pTame)
+			{
+				return !*pWild;        // "*bc" matches "abc".
+			}
+
+			CodePointAdvance(&pWild);  // Everything's still a match.
+			CodePointAdvance(&pTame);
+			pState->iStep = WILD_STEP_LOWER;
+			continue;
+		}
+
+		break;
+	} while (true);
+
+	pState->pWild = pWild;
+	pState->pTame = pTame;
+	return iResult;
+}
+
+
+// Matches one pattern against a batch of null-terminated UTF-8 strings, 
+// with up to WILD_BATCH_WIDTH matches interleaved so that each one's cache 
+// misses overlap with the others' work.  PERFORMS NO UTF-8 VALIDATION.
+//
+void FastWildCompareUtf8Batch(char *pWild, char **ppTame, bool *pResults, 
+                              size_t cTame)
+{
+	WildMatchState rgStates[WILD_BATCH_WIDTH];
+	int    cActive = 0;
+	size_t iNext = 0;
+
+	while (cActive < WILD_BATCH_WIDTH && iNext < cTame)
+	{
+		WildMatchStart(&rgStates[cActive++], pWild, ppTame[iNext], iNext);
+		iNext++;
+	}
+
+	while (cActive)
+	{
+		for (int iState = 0; iState < cActive; iState++)
+		{
+			WildMatchState *pState = &rgStates[iState];
+			int iResult = WildMatchResume(pState);
+
+			if (iResult == WILD_MATCH_PENDING)
+			{
+				continue;
+			}
+
+			pResults[pState->iTame] = iResult == WILD_MATCH_TRUE;
+
+			if (iNext < cTame)
+			{
+				// Start the next match in the same slot.
+				WildMatchStart(pState, pWild, ppTame[iNext], iNext);
+				iNext++;
+			}
+			else
+			{
+				// Keep the slots in flight contiguous.
+				*pState = rgStates[--cActive];
+				iState--;
+			}
+		}
+	}
+
+	return;
+}
+
+
+#if defined(WILD_LANES)
+// One element of a pattern, as run over SIMD lanes: a '*', a '?', or a 
+// single byte of a literal code point.
+//
+#define WILD_LANE_STAR      0
+#define WILD_LANE_QUESTION  1
+#define WILD_LANE_BYTE      2
+
+struct WildLaneElement
+{
+	int            iKind;
+	unsigned char  chByte;
+	bool           bAfterQuestion;  // Whether a '?' precedes this position
+};
+
+
+// Transposes a block of 16 columns, starting at column iFirst, from the 
+// strings in 16 lanes starting at iLane into rgBlock[column][lane].  Only 
+// the lanes with a bit in iLive, whose strings haven't ended before 
+// iFirst, are read; the rest are left as nulls.  Reads past a string's 
+// terminating null only within a block that doesn't cross into a further 
+// page, and the bytes there don't matter, as the lane is done with by then.
+//
+void WildLaneTranspose(char **rgLaneTame, uint32_t iLive, int iLane,
+                       size_t iFirst, unsigned char (*rgBlock)[WILD_LANES])
+{
+	__m128i rgRows[16];
+	__m128i rgLow[16];
+	__m128i rgHigh[16];
+
+	for (int iRow = 0; iRow < 16; iRow++)
+	{
+		char *pRow = rgLaneTame[iLane + iRow] + iFirst;
+
+		if (!((iLive >> (iLane + iRow)) & 1))
+		{
+			rgRows[iRow] = _mm_setzero_si128();
+		}
+		else if (((uintptr_t) pRow & (WILD_PAGE - 1)) <= WILD_PAGE - 16)
+		{
+			rgRows[iRow] = _mm_loadu_si128((const __m128i *) pRow);
+		}
+		else
+		{
+			unsigned char rgPadded[16] = { 0 };
+
+			for (int iByte = 0; iByte < 16 && pRow[iByte]; iByte++)
+			{
+				rgPadded[iByte] = (unsigned char) pRow[iByte];
+			}
+
+			rgRows[iRow] = _mm_loadu_si128((const __m128i *) rgPadded);
+		}
+	}
+
+	// Interleave bytes, then pairs, then quads, then eights of them.
+	for (int iPair = 0; iPair < 8; iPair++)
+	{
+		rgLow[2 * iPair] = _mm_unpacklo_epi8(rgRows[2 * iPair], 
+		                                     rgRows[2 * iPair + 1]);
+		rgLow[2 * iPair + 1] = _mm_unpackhi_epi8(rgRows[2 * iPair], 
+		                                         rgRows[2 * iPair + 1]);
+	}
+
+	for (int iQuad = 0; iQuad < 4; iQuad++)
+	{
+		__m128i *pIn = &rgLow[4 * iQuad];
+		__m128i *pOut = &rgHigh[4 * iQuad];
+
+		pOut[0] = _mm_unpacklo_epi16(pIn[0], pIn[2]);
+		pOut[1] = _mm_unpackhi_epi16(pIn[0], pIn[2]);
+		pOut[2] = _mm_unpacklo_epi16(pIn[1], pIn[3]);
+		pOut[3] = _mm_unpackhi_epi16(pIn[1], pIn[3]);
+	}
+
+	for (int iHalf = 0; iHalf < 2; iHalf++)
+	{
+		__m128i *pIn = &rgHigh[8 * iHalf];
+		__m128i *pOut = &rgLow[8 * iHalf];
+
+		for (int iQuad = 0; iQuad < 4; iQuad++)
+		{
+			pOut[2 * iQuad] = _mm_unpacklo_epi32(pIn[iQuad], pIn[iQuad + 4]);
+			pOut[2 * iQuad + 1] = _mm_unpackhi_epi32(pIn[iQuad], 
+			                                         pIn[iQuad + 4]);
+		}
+	}
+
+	for (int iColumn = 0; iColumn < 8; iColumn++)
+	{
+		_mm_storeu_si128((__m128i *) &rgBlock[2 * iColumn][iLane], 
+		    _mm_unpacklo_epi64(rgLow[iColumn], rgLow[iColumn + 8]));
+		_mm_storeu_si128((__m128i *) &rgBlock[2 * iColumn + 1][iLane], 
+		    _mm_unpackhi_epi64(rgLow[iColumn], rgLow[iColumn + 8]));
+	}
+
+	return;
+}
+
+
+// Runs a parsed pattern over WILD_LANES strings, each in its own lane. 
+// The strings are transposed 16 columns at a time, as far as the matching 
+// goes, so that byte j of each string is in the lane for that string.  A 
+// lane drops out as its string ends or mismatches, or as it reaches a tail 
+// of the pattern made only of '*', which matches whatever follows.  Once 
+// no more than WILD_LANE_FEW lanes are left within the first 16 columns, 
+// where starting them over costs little, or once WILD_LANE_MAX_TAME bytes 
+// have been run, the lanes still running get a bit in *piDeferred, to be 
+// matched some other way.  Returns a bit for each lane whose string 
+// matches.
+//
+uint32_t WildLaneRun(WildLaneElement *rgElements, int cElements, 
+                     char **rgLaneTame, uint32_t *piDeferred)
+{
+	WildLaneVector rgStates[WILD_LANE_MAX_WILD + 1];
+	WildLaneVector rgNext[WILD_LANE_MAX_WILD + 1];
+	WildLaneVector vecOnes = LaneEqual(LaneZero(), LaneZero());
+	WildLaneVector vecMatched = LaneZero();
+	unsigned char  rgBlock[16][WILD_LANES];
+	uint32_t iLive = LaneBits(vecOnes);  // Lanes still running
+	int iFirstLive = 0;     // States before this one are empty in all lanes
+	int iTail = cElements;  // Elements from this one on are all '*'
+	int iState;
+
+	while (iTail > 0 && rgElements[iTail - 1].iKind == WILD_LANE_STAR)
+	{
+		iTail--;
+	}
+
+	// Every lane starts at the start of the pattern, and a '*' lets it 
+	// move on without consuming anything.
+	rgStates[0] = vecOnes;
+
+	for (iState = 0; iState < cElements; iState++)
+	{
+		rgStates[iState + 1] = rgElements[iState].iKind == WILD_LANE_STAR ?
+		                       rgStates[iState] : LaneZero();
+	}
+
+	*piDeferred = 0;
+
+	for (size_t iColumn = 0; ; iColumn++)
+	{
+		if (iColumn == WILD_LANE_MAX_TAME)
+		{
+			*piDeferred = iLive;
+			break;
+		}
+		else if (iColumn == 0)
+		{
+			// Most lanes often drop out at the first byte, so it's gathered 
+			// on its own, and the first block is transposed only after it.
+			for (int iLane = 0; iLane < WILD_LANES; iLane++)
+			{
+				rgBlock[0][iLane] = (unsigned char) rgLaneTame[iLane][0];
+			}
+		}
+		else if (iColumn == 1 || !(iColumn & 15))
+		{
+			for (int iLane = 0; iLane < WILD_LANES; iLane += 16)
+			{
+				WildLaneTranspose(rgLaneTame, iLive, iLane, iColumn & ~15, 
+				                  rgBlock);
+			}
+		}
+
+		WildLaneVector vecColumn = LaneLoad(rgBlock[iColumn & 15]);
+		WildLaneVector vecEnded = LaneEqual(vecColumn, LaneZero());
+		WildLaneVector vecTrailing = LaneEqual(
+		    LaneAnd(vecColumn, LaneSplat(0xC0)), LaneSplat(0x80));
+		WildLaneVector vecLeading = LaneAndNot(LaneOr(vecEnded, vecTrailing),
+		                                       vecOnes);
+		WildLaneVector vecAccepted = rgStates[iTail];
+		WildLaneVector vecLive = LaneZero();
+		int iNextFirstLive = cElements + 1;
+
+		// A lane that has reached the pattern's tail of '*' has matched, 
+		// whatever follows, as has a lane whose string ends here at the end 
+		// of the pattern.  Either way, its states all drop to zero.
+		if (iTail == cElements)
+		{
+			vecAccepted = LaneAnd(vecAccepted, vecEnded);
+		}
+
+		if (LaneBits(vecAccepted))
+		{
+			vecMatched = LaneOr(vecMatched, vecAccepted);
+
+			for (iState = iFirstLive; iState <= cElements; iState++)
+			{
+				rgStates[iState] = LaneAndNot(vecAccepted, rgStates[iState]);
+			}
+		}
+
+		rgNext[iFirstLive] = LaneZero();
+
+		for (iState = iFirstLive; iState < cElements; iState++)
+		{
+			WildLaneElement *pElement = &rgElements[iState];
+			WildLaneVector vecState = rgStates[iState];
+
+			rgNext[iState + 1] = LaneZero();
+
+			if (pElement->bAfterQuestion)
+			{
+				// The rest of a code point covered by a '?'.
+				rgNext[iState] = LaneOr(rgNext[iState], 
+				                        LaneAnd(vecState, vecTrailing));
+			}
+
+			if (pElement->iKind == WILD_LANE_STAR)
+			{
+				rgNext[iState] = LaneOr(rgNext[iState], 
+				                        LaneAndNot(vecEnded, vecState));
+			}
+			else if (pElement->iKind == WILD_LANE_QUESTION)
+			{
+				rgNext[iState + 1] = LaneAnd(vecState, vecLeading);
+			}
+			else
+			{
+				rgNext[iState + 1] = LaneAnd(vecState, LaneEqual(vecColumn, 
+				                             LaneSplat(pElement->chByte)));
+			}
+		}
+
+		if (rgElements[cElements - 1].iKind == WILD_LANE_QUESTION)
+		{
+			rgNext[cElements] = LaneOr(rgNext[cElements], 
+			    LaneAnd(rgStates[cElements], vecTrailing));
+		}
+
+		for (iState = iFirstLive; iState <= cElements; iState++)
+		{
+			if (iState < cElements && 
+			    rgElements[iState].iKind == WILD_LANE_STAR)
+			{
+				rgNext[iState + 1] = LaneOr(rgNext[iState + 1], 
+				                            rgNext[iState]);
+			}
+
+			rgStates[iState] = rgNext[iState];
+			vecLive = LaneOr(vecLive, rgNext[iState]);
+
+			if (iNextFirstLive > cElements && LaneBits(rgNext[iState]))
+			{
+				iNextFirstLive = iState;
+			}
+		}
+
+		// Strings drop out as they end, mismatch, or match early.  Stop once 
+		// none remain, or once too few remain early on to be worth running 
+		// in lanes.
+		iLive = LaneBits(vecLive);
+
+		uint32_t iRest = iLive;
+
+
+		for (int iFew = 0; iFew < WILD_LANE_FEW && iColumn < 16 && iRest; 
+		     iFew++)
+		{
+			iRest &= iRest - 1;
+		}
+
+		if (!iRest)
+		{
+			*piDeferred = iLive;
+			break;
+		}
+
+		iFirstLive = iNextFirstLive;
+	}
+
+	return LaneBits(vecMatched);
+}
+#endif  // WILD_LANES
+
+
+// Matches one pattern against a batch of short null-terminated UTF-8 
+// strings, WILD_LANES strings at a time.  Strings still undecided after 
+// WILD_LANE_MAX_TAME bytes, and patterns longer than WILD_LANE_MAX_WILD 
+// bytes, are matched via FastWildCompareUtf8() instead.  PERFORMS NO UTF-8 
+// VALIDATION.
+//
+void FastWildCompareUtf8Lanes(char *pWild, char **ppTame, bool *pResults, 
+                              size_t cTame)
+{
+	size_t iTame = 0;
+
+#if defined(WILD_LANES)
+	WildLaneElement rgElements[WILD_LANE_MAX_WILD];
+	int cElements = 0;
+	bool bAfterQuestion = false;
+
+	// Parse the pattern, collapsing runs of '*'.
+	for (char *pWildByte = pWild; *pWildByte; pWildByte++)
+	{
+		if (*pWildByte == '*' && cElements && 
+		    rgElements[cElements - 1].iKind == WILD_LANE_STAR)
+		{
+			continue;
+		}
+		else if (cElements == WILD_LANE_MAX_WILD)
+		{
+			cElements = -1;
+			break;
+		}
+
+		WildLaneElement *pElement = &rgElements[cElements++];
+
+		pElement->iKind = *pWildByte == '*' ? WILD_LANE_STAR : 
+		                  *pWildByte == '?' ? WILD_LANE_QUESTION : 
+		                                      WILD_LANE_BYTE;
+		pElement->chByte = (unsigned char) *pWildByte;
+		pElement->bAfterQuestion = bAfterQuestion;
+		bAfterQuestion = pElement->iKind == WILD_LANE_QUESTION;
+	}
+
+	if (cElements == 0)
+	{
+		// The empty pattern matches only the empty string.
+		for (; iTame < cTame; iTame++)
+		{
+			pResults[iTame] = !*ppTame[iTame];
+		}
+
+		return;
+	}
+
+	if (cElements > 0)
+	{
+		char *rgLaneTame[WILD_LANES];
+
+		for (; iTame < cTame; iTame += WILD_LANES)
+		{
+			int cLanes = cTame - iTame < WILD_LANES ? (int) (cTame - iTame) : 
+			                                          WILD_LANES;
+			uint32_t iDeferred;
+
+			// Unused lanes hold empty strings, which drop out at once.
+			for (int iLane = 0; iLane < WILD_LANES; iLane++)
+			{
+				rgLaneTame[iLane] = iLane < cLanes ? ppTame[iTame + iLane] : 
+				                                     (char *) "";
+			}
+
+			uint32_t iMatched = WildLaneRun(rgElements, cElements, 
+			                                rgLaneTame, &iDeferred);
+
+			for (int iLane = 0; iLane < cLanes; iLane++)
+			{
+				if ((iDeferred >> iLane) & 1)
+				{
+					pResults[iTame + iLane] = FastWildCompareUtf8(pWild, 
+					    rgLaneTame[iLane]);
+				}
+				else
+				{
+					pResults[iTame + iLane] = (iMatched >> iLane) & 1;
+				}
+			}
+		}
+
+		return;
+	}
+#endif  // WILD_LANES
+
+	for (iTame = 0; iTame < cTame; iTame++)
+	{
+		pResults[iTame] = FastWildCompareUtf8(pWild, ppTame[iTame]);
+	}
+
+	return;
+}
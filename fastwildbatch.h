@@ -0,0 +1,13 @@
+// Batch routines for matching one wildcard pattern against many strings.
+//
+// Matches null-terminated UTF-8 strings, scattered anywhere in memory, 
+// against one pattern.  Sets pResults[i] to the result that 
+// FastWildCompareUtf8(pWild, ppTame[i]) would return.
+void FastWildCompareUtf8Batch(char *pWild, char **ppTame, bool *pResults, 
+                              size_t cTame);
+
+// Matches one pattern against a batch of short null-terminated UTF-8 
+// strings, evaluating 16 strings (or 32, with AVX2) at once in SIMD lanes.  
+// Sets pResults[i] as FastWildCompareUtf8(pWild, ppTame[i]) would.
+void FastWildCompareUtf8Lanes(char *pWild, char **ppTame, bool *pResults, 
+                              size_t cTame);
@@ -0,0 +1,493 @@
+// A thread-safe cache of compiled UTF-8-ready wildcard patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// The cache is split into 16 shards by pattern hash.  Each shard is a 
+// chained hash table whose chains readers walk without locking, while 
+// inserts and evictions take the shard's lock.  Within a shard, entries 
+// are evicted in CLOCK order, which approximates least-recently-used 
+// order without a write to shared memory on every hit: a hit only sets 
+// the entry's referenced flag, if it's clear, and the clock hand gives 
+// each referenced entry a second chance.
+//
+// Entries are reference counted.  The shard's table holds one reference, 
+// and each reader holds one for each entry in its front cache, a small 
+// direct-mapped table of its own that serves most hits without touching 
+// anything shared.  An entry that loses its last reference is retired, 
+// and freed only once every reader that might still be walking past it 
+// has moved on, as tracked by epochs: a reader announces the current 
+// epoch while it walks a shard, and an entry retired in an epoch is freed 
+// once no reader has announced that epoch or an earlier one.  An evicted 
+// entry held in a front cache stays usable, since a compiled pattern 
+// never changes.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include "fastwildcompare.h"
+#include "fastwildliteral.h"
+#include "fastwildpattern.h"
+#include "fastwildcache.h"
+
+#define WILD_CACHE_SHARDS   16
+#define WILD_CACHE_READERS  128
+#define WILD_CACHE_FRONT    16       // Front cache entries per reader
+
+struct WildCacheEntry
+{
+	std::atomic<WildCacheEntry *> pNext;    // Next in the chain
+	std::atomic<uint32_t>         cRefs;
+	std::atomic<bool>             bReferenced;
+	uint64_t                      iHash;
+	WildPattern                  *pPattern;
+	uint64_t                      iRetired;  // Epoch of retirement
+	WildCacheEntry               *pNextRetired;
+	size_t                        cbWild;
+	char                          szWild[1];
+};
+
+struct alignas(64) WildCacheShard
+{
+	std::mutex                     lock;
+	std::atomic<WildCacheEntry *> *pChains;
+	uint32_t                       iChainMask;
+	WildCacheEntry               **pClock;   // Entries, in clock order
+	size_t                         cEntries;
+	size_t                         iHand;
+};
+
+struct alignas(64) WildCacheReader
+{
+	std::atomic<uint64_t>  iActive;          // Announced epoch, or 0
+	std::atomic<bool>      bOpen;
+	std::atomic<uint64_t>  cHits;
+	std::atomic<uint64_t>  cMisses;
+	WildPatternCache      *pCache;
+	WildCacheEntry        *rgFront[WILD_CACHE_FRONT];
+};
+
+struct WildPatternCache
+{
+	WildCacheShard         rgShards[WILD_CACHE_SHARDS];
+	WildCacheReader        rgReaders[WILD_CACHE_READERS];
+	size_t                 cMaxPerShard;
+	std::atomic<uint64_t>  iEpoch;
+	std::atomic<uint64_t>  cEvictions;
+	std::mutex             retiredLock;
+	WildCacheEntry        *pRetired;
+	void                  *pBlock;     // As allocated, before alignment
+};
+
+
+// Releases an entry along with its compiled pattern.
+//
+void WildCacheEntryFree(WildCacheEntry *pEntry)
+{
+	FastWildPatternFree(pEntry->pPattern);
+	pEntry->~WildCacheEntry();
+	free(pEntry);
+	return;
+}
+
+
+// Drops a reference to an entry.  If that was the last reference, retires 
+// the entry, and frees whichever retired entries no reader can still see.
+//
+void WildCacheRelease(WildPatternCache *pCache, WildCacheEntry *pEntry)
+{
+	if (pEntry->cRefs.fetch_sub(1) != 1)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(pCache->retiredLock);
+	uint64_t iOldest = UINT64_MAX;
+
+	pEntry->iRetired = pCache->iEpoch.fetch_add(1);
+	pEntry->pNextRetired = pCache->pRetired;
+	pCache->pRetired = pEntry;
+
+	for (size_t iReader = 0; iReader < WILD_CACHE_READERS; iReader++)
+	{
+		uint64_t iActive = pCache->rgReaders[iReader].iActive.load();
+
+		if (iActive && iActive < iOldest)
+		{
+			iOldest = iActive;
+		}
+	}
+
+	for (WildCacheEntry **ppRetired = &pCache->pRetired; *ppRetired; )
+	{
+		WildCacheEntry *pRetired = *ppRetired;
+
+		if (pRetired->iRetired < iOldest)
+		{
+			*ppRetired = pRetired->pNextRetired;
+			WildCacheEntryFree(pRetired);
+		}
+		else
+		{
+			ppRetired = &pRetired->pNextRetired;
+		}
+	}
+
+	return;
+}
+
+
+// Returns true if an entry holds the given pattern text.
+//
+inline bool WildCacheEntryIs(WildCacheEntry *pEntry, uint64_t iHash, 
+                             char *pWild, size_t cbWild)
+{
+	return pEntry->iHash == iHash && pEntry->cbWild == cbWild && 
+	       !memcmp(pEntry->szWild, pWild, cbWild);
+}
+
+
+// Looks up pattern text in a shard's chain and takes a reference to the 
+// entry found, if any.  Walks the chain without locking.
+//
+WildCacheEntry *WildCacheFind(WildCacheShard *pShard, uint64_t iHash, 
+                              char *pWild, size_t cbWild)
+{
+	for (WildCacheEntry *pEntry = 
+	         pShard->pChains[iHash & pShard->iChainMask].load(); 
+	     pEntry; pEntry = pEntry->pNext.load())
+	{
+		if (WildCacheEntryIs(pEntry, iHash, pWild, cbWild))
+		{
+			uint32_t cRefs = pEntry->cRefs.load();
+
+			// An entry without references is on its way out.
+			while (cRefs && !pEntry->cRefs.compare_exchange_weak(cRefs, 
+			                                                     cRefs + 1))
+			{
+				continue;
+			}
+
+			if (!cRefs)
+			{
+				return NULL;
+			}
+
+			if (!pEntry->bReferenced.load(std::memory_order_relaxed))
+			{
+				pEntry->bReferenced.store(true, std::memory_order_relaxed);
+			}
+
+			return pEntry;
+		}
+	}
+
+	return NULL;
+}
+
+
+// Unlinks the entry under a shard's clock hand that hasn't been used 
+// since the hand last passed it, making room for another entry.  The 
+// shard must be locked.
+//
+void WildCacheEvict(WildPatternCache *pCache, WildCacheShard *pShard)
+{
+	for (;;)
+	{
+		WildCacheEntry *pEntry = pShard->pClock[pShard->iHand];
+
+		if (pEntry->bReferenced.load(std::memory_order_relaxed))
+		{
+			pEntry->bReferenced.store(false, std::memory_order_relaxed);
+			pShard->iHand = (pShard->iHand + 1) % pShard->cEntries;
+			continue;
+		}
+
+		std::atomic<WildCacheEntry *> *ppLink = 
+		    &pShard->pChains[pEntry->iHash & pShard->iChainMask];
+
+		while (ppLink->load() != pEntry)
+		{
+			ppLink = &ppLink->load()->pNext;
+		}
+
+		ppLink->store(pEntry->pNext.load());
+		pShard->pClock[pShard->iHand] = pShard->pClock[--pShard->cEntries];
+		pCache->cEvictions.fetch_add(1, std::memory_order_relaxed);
+		WildCacheRelease(pCache, pEntry);
+
+		if (pShard->iHand >= pShard->cEntries)
+		{
+			pShard->iHand = 0;
+		}
+
+		return;
+	}
+}
+
+
+// Creates a cache that holds about cMaxPatterns compiled patterns.  
+// Returns NULL if memory for the cache can't be allocated.
+//
+WildPatternCache *FastWildCacheCreate(size_t cMaxPatterns)
+{
+	void             *pBlock = calloc(1, sizeof(WildPatternCache) + 63);
+	WildPatternCache *pCache;
+	uint32_t          cChains = 1;
+
+	if (!pBlock)
+	{
+		return NULL;
+	}
+
+	// The shards and readers are aligned to cache lines, so that threads 
+	// don't contend for lines they don't share.
+	pCache = new ((char *) pBlock + (-(uintptr_t) pBlock & 63)) 
+	    WildPatternCache();
+	pCache->pBlock = pBlock;
+	pCache->cMaxPerShard = 
+	    (cMaxPatterns + WILD_CACHE_SHARDS - 1) / WILD_CACHE_SHARDS;
+	pCache->cMaxPerShard += !pCache->cMaxPerShard;
+	pCache->iEpoch = 1;
+
+	while (cChains < pCache->cMaxPerShard)
+	{
+		cChains *= 2;
+	}
+
+	for (size_t iShard = 0; iShard < WILD_CACHE_SHARDS; iShard++)
+	{
+		WildCacheShard *pShard = &pCache->rgShards[iShard];
+
+		pShard->pChains = (std::atomic<WildCacheEntry *> *) 
+		    calloc(cChains, sizeof(std::atomic<WildCacheEntry *>));
+		pShard->pClock = (WildCacheEntry **) 
+		    malloc(pCache->cMaxPerShard * sizeof(WildCacheEntry *));
+		pShard->iChainMask = cChains - 1;
+
+		if (!pShard->pChains || !pShard->pClock)
+		{
+			FastWildCacheFree(pCache);
+			return NULL;
+		}
+	}
+
+	for (size_t iReader = 0; iReader < WILD_CACHE_READERS; iReader++)
+	{
+		pCache->rgReaders[iReader].pCache = pCache;
+	}
+
+	return pCache;
+}
+
+
+// Claims a reader for the calling thread.  Returns NULL if every reader 
+// is in use.
+//
+WildCacheReader *FastWildCacheReaderOpen(WildPatternCache *pCache)
+{
+	for (size_t iReader = 0; iReader < WILD_CACHE_READERS; iReader++)
+	{
+		WildCacheReader *pReader = &pCache->rgReaders[iReader];
+		bool             bOpen = false;
+
+		if (pReader->bOpen.compare_exchange_strong(bOpen, true))
+		{
+			return pReader;
+		}
+	}
+
+	return NULL;
+}
+
+
+// Matches a null-terminated UTF-8 tame string against a pattern, compiled 
+// once and then found in the reader's front cache or in the shared cache.  
+// If the pattern can't be compiled, matches it via FastWildCompareUtf8().  
+// PERFORMS NO UTF-8 VALIDATION.
+//
+bool FastWildCacheCompareUtf8(WildCacheReader *pReader, char *pWild, 
+                              char *pTame)
+{
+	WildPatternCache *pCache = pReader->pCache;
+	WildCacheEntry  **ppFront;
+	WildCacheEntry   *pEntry;
+	WildCacheShard   *pShard;
+	uint64_t          iHash = WILD_HASH_BASIS;
+	size_t            cbWild = 0;
+
+	while (pWild[cbWild])
+	{
+		iHash = WildHashStep(iHash, (unsigned char) pWild[cbWild++]);
+	}
+
+	ppFront = &pReader->rgFront[(iHash >> 32) % WILD_CACHE_FRONT];
+
+	if (*ppFront && WildCacheEntryIs(*ppFront, iHash, pWild, cbWild))
+	{
+		pReader->cHits.store(pReader->cHits.load(std::memory_order_relaxed) 
+		                     + 1, std::memory_order_relaxed);
+		return FastWildPatternCompareUtf8((*ppFront)->pPattern, pTame);
+	}
+
+	pShard = &pCache->rgShards[(iHash >> 40) % WILD_CACHE_SHARDS];
+	pReader->iActive.store(pCache->iEpoch.load());
+	pEntry = WildCacheFind(pShard, iHash, pWild, cbWild);
+	pReader->iActive.store(0);
+
+	if (pEntry)
+	{
+		pReader->cHits.store(pReader->cHits.load(std::memory_order_relaxed) 
+		                     + 1, std::memory_order_relaxed);
+	}
+	else
+	{
+		pReader->cMisses.store(pReader->cMisses.load(
+		    std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		pEntry = (WildCacheEntry *) malloc(sizeof(WildCacheEntry) + cbWild);
+
+		if (!pEntry)
+		{
+			return FastWildCompareUtf8(pWild, pTame);
+		}
+
+		new (pEntry) WildCacheEntry();
+		pEntry->iHash = iHash;
+		pEntry->cbWild = cbWild;
+		memcpy(pEntry->szWild, pWild, cbWild + 1);
+		pEntry->pPattern = FastWildPatternCompile(pWild);
+		pEntry->cRefs = 2;             // The shard's and the reader's
+
+		if (!pEntry->pPattern)
+		{
+			WildCacheEntryFree(pEntry);
+			return FastWildCompareUtf8(pWild, pTame);
+		}
+
+		std::lock_guard<std::mutex> guard(pShard->lock);
+		WildCacheEntry *pFound = WildCacheFind(pShard, iHash, pWild, cbWild);
+
+		if (pFound)
+		{
+			WildCacheEntryFree(pEntry);    // Another reader got here first
+			pEntry = pFound;
+		}
+		else
+		{
+			std::atomic<WildCacheEntry *> *pChain = 
+			    &pShard->pChains[iHash & pShard->iChainMask];
+
+			if (pShard->cEntries == pCache->cMaxPerShard)
+			{
+				WildCacheEvict(pCache, pShard);
+			}
+
+			pShard->pClock[pShard->cEntries++] = pEntry;
+			pEntry->pNext.store(pChain->load());
+			pChain->store(pEntry);
+		}
+	}
+
+	if (*ppFront)
+	{
+		WildCacheRelease(pCache, *ppFront);
+	}
+
+	*ppFront = pEntry;
+	return FastWildPatternCompareUtf8(pEntry->pPattern, pTame);
+}
+
+
+// Sums the hits, misses and evictions of every reader of a cache.
+//
+void FastWildCacheCounts(WildPatternCache *pCache, uint64_t *pcHits, 
+                         uint64_t *pcMisses, uint64_t *pcEvictions)
+{
+	*pcHits = *pcMisses = 0;
+
+	for (size_t iReader = 0; iReader < WILD_CACHE_READERS; iReader++)
+	{
+		*pcHits += pCache->rgReaders[iReader].cHits.load();
+		*pcMisses += pCache->rgReaders[iReader].cMisses.load();
+	}
+
+	*pcEvictions = pCache->cEvictions.load();
+	return;
+}
+
+
+// Releases a reader's front cache and makes the reader available to 
+// another thread.
+//
+void FastWildCacheReaderClose(WildCacheReader *pReader)
+{
+	for (size_t iFront = 0; iFront < WILD_CACHE_FRONT; iFront++)
+	{
+		if (pReader->rgFront[iFront])
+		{
+			WildCacheRelease(pReader->pCache, pReader->rgFront[iFront]);
+			pReader->rgFront[iFront] = NULL;
+		}
+	}
+
+	pReader->bOpen.store(false);
+	return;
+}
+
+
+// Releases a cache, along with every compiled pattern in it.  All of its 
+// readers must have been closed.
+//
+void FastWildCacheFree(WildPatternCache *pCache)
+{
+	if (!pCache)
+	{
+		return;
+	}
+
+	for (size_t iShard = 0; iShard < WILD_CACHE_SHARDS; iShard++)
+	{
+		WildCacheShard *pShard = &pCache->rgShards[iShard];
+
+		for (size_t iEntry = 0; iEntry < pShard->cEntries; iEntry++)
+		{
+			WildCacheEntryFree(pShard->pClock[iEntry]);
+		}
+
+		free(pShard->pChains);
+		free(pShard->pClock);
+	}
+
+	while (pCache->pRetired)
+	{
+		WildCacheEntry *pRetired = pCache->pRetired;
+
+		pCache->pRetired = pRetired->pNextRetired;
+		WildCacheEntryFree(pRetired);
+	}
+
+	void *pBlock = pCache->pBlock;
+
+	pCache->~WildPatternCache();
+	free(pBlock);
+	return;
+}
@@ -0,0 +1,30 @@
+// A thread-safe, bounded cache of compiled UTF-8-ready wildcard patterns, 
+// keyed by pattern text, for callers that receive the same patterns over 
+// and over.
+//
+// A cache is created by FastWildCacheCreate(), to hold about cMaxPatterns 
+// compiled patterns.  Each thread that uses it opens a reader, via 
+// FastWildCacheReaderOpen(), and matches through that reader via 
+// FastWildCacheCompareUtf8(), which compiles the pattern on a miss and 
+// otherwise matches as FastWildCompareUtf8() would.  A reader keeps a few 
+// recently used patterns of its own, and belongs to one thread at a time.  
+// Up to 128 readers can be open at once; FastWildCacheReaderOpen() returns 
+// NULL beyond that.  Every reader must be closed, via 
+// FastWildCacheReaderClose(), before the cache is freed.
+//
+// FastWildCacheCounts() reports the hits, misses and evictions so far, 
+// summed over all readers.
+#include <stddef.h>
+#include <stdint.h>
+
+struct WildPatternCache;
+struct WildCacheReader;
+
+WildPatternCache *FastWildCacheCreate(size_t cMaxPatterns);
+WildCacheReader *FastWildCacheReaderOpen(WildPatternCache *pCache);
+bool FastWildCacheCompareUtf8(WildCacheReader *pReader, char *pWild, 
+                              char *pTame);
+void FastWildCacheCounts(WildPatternCache *pCache, uint64_t *pcHits, 
+                         uint64_t *pcMisses, uint64_t *pcEvictions);
+void FastWildCacheReaderClose(WildCacheReader *pReader);
+void FastWildCacheFree(WildPatternCache *pCache);
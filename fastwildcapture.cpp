@@ -0,0 +1,230 @@
+// Capturing wildcard matches for UTF-8-ready patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// FastWildCompareUtf8() never needs to back up past the last '*' it has 
+// seen, because the content between two stars, once found at its leftmost 
+// place in the tame string, leaves the most room for whatever follows.  
+// So the pattern is matched here a segment at a time, each segment being 
+// the content between stars.  The first segment must match at the start 
+// of the tame string, each middle segment matches at the first place it 
+// can, and the last segment, if the pattern doesn't end with a '*', must 
+// end where the tame string does, which fixes its place once the code 
+// points remaining in the tame string are counted.  Each star's span runs 
+// from where the content before it ended to where the next segment was 
+// found.
+//
+// The spans of a segment's '?' wildcards are stored whenever the segment 
+// is tried at a place, since that's no more work than counting code 
+// points, and the spans from a try that fails are simply overwritten.
+//
+#include <stddef.h>
+#include <string.h>
+#include "fastwildcapture.h"
+#include "fastwildutf8.h"
+
+
+// Finds the end of the segment of a pattern that starts at pWild, which 
+// is the next '*' or the terminating null, along with the numbers of code 
+// points and '?' wildcards in the segment.
+//
+inline char *WildCaptureScan(char *pWild, size_t *pcCodePoints, 
+                             size_t *pcQuestions)
+{
+	*pcCodePoints = 0;
+	*pcQuestions = 0;
+
+	while (*pWild && *pWild != '*')
+	{
+		*pcQuestions += *pWild == '?';
+		(*pcCodePoints)++;
+		CodePointAdvance(&pWild);
+	}
+
+	return pWild;
+}
+
+
+// Matches a segment of a pattern, up to the next '*' or the terminating 
+// null, against the tame string at pTame, storing the span of each '?' 
+// from pSpans[iSpan] on, as far as cMaxSpans.  Returns the tame content 
+// that follows the segment, or NULL if the segment doesn't match there.
+//
+inline char *WildCaptureSegment(char *pWild, char *pTame, char *pStart, 
+                                WildSpan *pSpans, size_t cMaxSpans, 
+                                size_t iSpan)
+{
+	while (*pWild && *pWild != '*')
+	{
+		if (!*pTame)
+		{
+			return NULL;
+		}
+		else if (*pWild == '?')
+		{
+			char *pNext = pTame;
+
+			CodePointAdvance(&pNext);
+
+			if (iSpan < cMaxSpans)
+			{
+				pSpans[iSpan].iOffset = pTame - pStart;
+				pSpans[iSpan].cbSpan = pNext - pTame;
+			}
+
+			iSpan++;
+			pWild++;
+			pTame = pNext;
+		}
+		else if (!CodePointCompare(pWild, pTame))
+		{
+			return NULL;
+		}
+		else
+		{
+			CodePointAdvance(&pWild);
+			CodePointAdvance(&pTame);
+		}
+	}
+
+	return pTame;
+}
+
+
+// Stores a span, if there's room for it.
+//
+inline void WildCaptureSpan(WildSpan *pSpans, size_t cMaxSpans, 
+                            size_t iSpan, size_t iOffset, size_t cbSpan)
+{
+	if (iSpan < cMaxSpans)
+	{
+		pSpans[iSpan].iOffset = iOffset;
+		pSpans[iSpan].cbSpan = cbSpan;
+	}
+
+	return;
+}
+
+
+// Matches a null-terminated UTF-8 pattern against a null-terminated UTF-8 
+// tame string, as FastWildCompareUtf8() does, and on a match stores the 
+// spans of the tame string that the pattern's first cMaxSpans wildcards 
+// matched.  Sets *pcSpans, on a match, to the number of wildcards in the 
+// pattern, unless pcSpans is NULL.  PERFORMS NO UTF-8 VALIDATION.
+//
+bool FastWildCaptureUtf8(char *pWild, char *pTame, WildSpan *pSpans, 
+                         size_t cMaxSpans, size_t *pcSpans)
+{
+	char   *pStart = pTame;
+	char   *pEnd;
+	size_t  cCodePoints;
+	size_t  cQuestions;
+	size_t  iSpan = 0;
+
+	// The content ahead of the first '*' matches in place.
+	pEnd = WildCaptureScan(pWild, &cCodePoints, &cQuestions);
+	pTame = WildCaptureSegment(pWild, pTame, pStart, pSpans, cMaxSpans, 
+	                           iSpan);
+
+	if (!pTame || (!*pEnd && *pTame))
+	{
+		return false;                  // "abc" doesn't match "abd".
+	}
+
+	iSpan += cQuestions;
+	pWild = pEnd;
+
+	while (*pWild == '*')
+	{
+		char *pFound = pTame;
+		char *pAfter;
+
+		// Stars ahead of another star match nothing.
+		while (pWild[1] == '*')
+		{
+			WildCaptureSpan(pSpans, cMaxSpans, iSpan++, pTame - pStart, 0);
+			pWild++;
+		}
+
+		pEnd = WildCaptureScan(++pWild, &cCodePoints, &cQuestions);
+
+		if (!*pWild)
+		{
+			WildCaptureSpan(pSpans, cMaxSpans, iSpan++, pTame - pStart, 
+			                strlen(pTame));
+			break;                     // "ab*" matches "abcd".
+		}
+		else if (!*pEnd)
+		{
+			// The last segment ends where the tame string does.
+			char  *pCodePoint = pTame;
+			size_t cRemaining = *pTame != 0;
+
+			while (CodePointAdvance(&pCodePoint))
+			{
+				cRemaining++;
+			}
+
+			if (cRemaining < cCodePoints)
+			{
+				return false;          // "*bcd" doesn't match "abc".
+			}
+
+			for (; cRemaining > cCodePoints; cRemaining--)
+			{
+				CodePointAdvance(&pFound);
+			}
+
+			pAfter = WildCaptureSegment(pWild, pFound, pStart, pSpans, 
+			                            cMaxSpans, iSpan + 1);
+
+			if (!pAfter)
+			{
+				return false;          // "*bc" doesn't match "abcd".
+			}
+		}
+		else
+		{
+			// A middle segment matches at the first place it can.
+			while (((*pWild != '?' && !CodePointCompare(pWild, pFound)) || 
+			        !(pAfter = WildCaptureSegment(pWild, pFound, pStart, 
+			                                      pSpans, cMaxSpans, 
+			                                      iSpan + 1))))
+			{
+				if (!CodePointAdvance(&pFound))
+				{
+					return false;      // "*a*b" doesn't match "ac".
+				}
+			}
+		}
+
+		WildCaptureSpan(pSpans, cMaxSpans, iSpan, pTame - pStart, 
+		                pFound - pTame);
+		iSpan += 1 + cQuestions;
+		pTame = pAfter;
+		pWild = pEnd;
+	}
+
+	if (pcSpans)
+	{
+		*pcSpans = iSpan;
+	}
+
+	return true;
+}
@@ -0,0 +1,31 @@
+// Capturing what each wildcard matched, for UTF-8-ready wildcard patterns.
+//
+// FastWildCaptureUtf8() returns what FastWildCompareUtf8() would, and on 
+// a match also stores the span of the tame string that each '*' and '?' 
+// matched, in the order the wildcards appear in the pattern, as a byte 
+// offset from the start of the tame string and a length in bytes.  Spans 
+// are stored for as many as cMaxSpans wildcards, and *pcSpans is set to 
+// the number of wildcards in the pattern, if pcSpans isn't NULL, so that 
+// a short pSpans array shows up as a count larger than cMaxSpans.  Nothing 
+// is allocated.  The contents of pSpans are undefined on a mismatch.
+//
+// Each '*' matches as little as it can, given what the wildcards to its 
+// left matched, which is how FastWildCompareUtf8() finds a match.  Of 
+// consecutive stars, all but the last match nothing, and a '?' matches 
+// exactly one code point.
+#if !defined(FASTWILDCAPTURE_H)
+#define FASTWILDCAPTURE_H
+
+#include <stddef.h>
+
+// The bytes of a tame string that one wildcard matched.
+struct WildSpan
+{
+	size_t iOffset;       // From the start of the tame string
+	size_t cbSpan;
+};
+
+bool FastWildCaptureUtf8(char *pWild, char *pTame, WildSpan *pSpans, 
+                         size_t cMaxSpans, size_t *pcSpans);
+
+#endif  // FASTWILDCAPTURE_H
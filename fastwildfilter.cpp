@@ -0,0 +1,494 @@
+// Filtering names by a wildcard pattern as it's typed, in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// A pattern that implicitly ends with '*' is a series of parts separated 
+// by stars, each made of literal content and '?' wildcards, where the last 
+// part is followed by the implied '*'.  It matches a name if the first 
+// part matches the name's start and each later part can go somewhere 
+// after the part before it, and as FastWildCompareUtf8() does, each part 
+// can go at the first place it matches.  Where the last part goes, in 
+// each selected name, is all the state needed for appending to it.
+//
+// A code point appended to the last part either matches the content that 
+// follows where that part went, so the part stays put, or else the part 
+// has to move to the next place it matches as a whole, which can only be 
+// further along the name.  The first part can't move, so a name that it 
+// stops matching is dropped.  An appended '*' starts a new, empty last 
+// part where the previous one ended.
+//
+// Each level of the filter holds the selection for the pattern up to one 
+// more code point than the level before it, with level 0 being all of the 
+// names, for the empty pattern.  Levels come and go last in, first out, so 
+// they're kept one after another in a pair of arrays that only grow, and 
+// the memory a keystroke writes to has mostly been written to before.
+//
+// The few bytes of each name that follow the last part are copied along 
+// with its place, so that a code point typed can mostly be matched without 
+// touching the name itself.  Only one name in several may be selected, 
+// and reading each of those from its own cache line would cost more than 
+// reading every name in order does.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildfilter.h"
+#include "fastwildutf8.h"
+
+// Where the last part of a pattern matched a name, no more than 4 GB long.
+struct WildFilterPlace
+{
+	uint32_t iStart;             // Byte offsets within the name
+	uint32_t iEnd;
+	uint64_t iNext;              // Bytes at iEnd, and their count on top
+};
+
+#define WILD_FILTER_AHEAD  7     // Most bytes kept in iNext
+
+// The selection for the pattern up to some code point.
+struct WildFilterLevel
+{
+	size_t cbWild;        // Bytes of the pattern covered
+	size_t iFirst;        // Where the selection starts in the arrays
+	size_t cSelected;
+};
+
+struct WildFilter
+{
+	char           **ppNames;
+	size_t           cNames;
+	char            *pWild;           // Covering at least the top level
+	size_t           cbMaxWild;       // Room in pWild
+	WildFilterLevel *pLevels;
+	size_t           cLevels;
+	size_t           cMaxLevels;
+	size_t          *piSelected;      // Ascending name indexes, by level
+	WildFilterPlace *pPlaces;         // One per entry of piSelected
+	size_t           cMaxSelected;    // Room in both
+};
+
+
+// Matches cbPart bytes of a pattern, made of literal content and '?' 
+// wildcards, at the start of null-terminated content.  Returns a pointer 
+// past the matched content, or NULL if the part doesn't match there.
+//
+inline char *WildFilterCompare(char *pPart, size_t cbPart, char *pName)
+{
+	for (char *pPartEnd = pPart + cbPart; pPart < pPartEnd; pPart++)
+	{
+		if (*pPart != '?')
+		{
+			if (*pPart != *pName++)
+			{
+				return NULL;
+			}
+		}
+		else if (!*pName)
+		{
+			return NULL;
+		}
+		else
+		{
+			while ((*++pName & 0xC0) == 0x80)
+			{
+			}
+		}
+	}
+
+	return pName;
+}
+
+
+// Packs the bytes of a UTF-8 code point into an integer, the first byte 
+// lowest.
+//
+inline uint64_t WildFilterPack(char *pCodePoint, size_t cbCodePoint)
+{
+	uint64_t iPacked = 0;
+
+	for (size_t iByte = 0; iByte < cbCodePoint; iByte++)
+	{
+		iPacked |= (uint64_t) (unsigned char) pCodePoint[iByte] << (8 * iByte);
+	}
+
+	return iPacked;
+}
+
+
+// Copies the bytes of a name that follow the last part of a pattern into 
+// its place, as far as the terminating null or as many as there's room 
+// for.
+//
+inline void WildFilterFill(WildFilterPlace *pPlace, char *pName)
+{
+	char    *pNext = pName + pPlace->iEnd;
+	uint64_t cbNext = 0;
+
+	pPlace->iNext = 0;
+
+	while (cbNext < WILD_FILTER_AHEAD)
+	{
+		pPlace->iNext |= (uint64_t) (unsigned char) *pNext << (8 * cbNext++);
+
+		if (!*pNext++)
+		{
+			break;
+		}
+	}
+
+	pPlace->iNext |= cbNext << (8 * WILD_FILTER_AHEAD);
+	return;
+}
+
+
+// Matches a code point appended to the last part of a pattern, packed by 
+// WildFilterPack(), against the bytes copied into a name's place, and 
+// advances the place past it.  Returns false if it doesn't match, or if 
+// not enough bytes were copied to tell.
+//
+inline bool WildFilterAhead(WildFilterPlace *pPlace, uint64_t iCodePoint, 
+                            size_t cbCodePoint)
+{
+	size_t   cbNext = (size_t) (pPlace->iNext >> (8 * WILD_FILTER_AHEAD));
+	uint64_t iBytes = pPlace->iNext & ((1ULL << (8 * WILD_FILTER_AHEAD)) - 1);
+
+	if (iCodePoint == '?')
+	{
+		if (!(iBytes & 0xFF))
+		{
+			return false;              // No code point, or not known
+		}
+
+		cbCodePoint = CodePointBytes((unsigned char) iBytes);
+	}
+	else if (cbCodePoint <= cbNext && 
+	         (iBytes & ((1ULL << (8 * cbCodePoint)) - 1)) != iCodePoint)
+	{
+		return false;
+	}
+
+	if (cbCodePoint > cbNext)
+	{
+		return false;
+	}
+
+	pPlace->iEnd += (uint32_t) cbCodePoint;
+	pPlace->iNext = (iBytes >> (8 * cbCodePoint)) | 
+	                ((uint64_t) (cbNext - cbCodePoint) << 
+	                 (8 * WILD_FILTER_AHEAD));
+	return true;
+}
+
+
+// Matches a code point appended to the last part of a pattern against the 
+// content of a name that follows where that part matched, advancing the 
+// place past it.  Returns false if it doesn't match.
+//
+inline bool WildFilterAppend(WildFilterPlace *pPlace, char *pName, 
+                             char *pCodePoint, uint64_t iCodePoint, 
+                             size_t cbCodePoint)
+{
+	char *pAfter;
+
+	if (WildFilterAhead(pPlace, iCodePoint, cbCodePoint))
+	{
+		return true;
+	}
+
+	pAfter = WildFilterCompare(pCodePoint, cbCodePoint, pName + pPlace->iEnd);
+
+	if (!pAfter)
+	{
+		return false;
+	}
+
+	pPlace->iEnd = (uint32_t) (pAfter - pName);
+	WildFilterFill(pPlace, pName);
+	return true;
+}
+
+
+// Adds a level for the pattern up to the cbCodePoint-byte code point that 
+// follows the top level's part of pFilter->pWild, selecting from the names 
+// that the top level selected.  Returns false if memory runs out.
+//
+bool WildFilterExtend(WildFilter *pFilter, size_t cbCodePoint)
+{
+	WildFilterLevel *pLevel;
+	WildFilterLevel *pNext;
+	char            *pCodePoint;
+	char            *pPart;
+	size_t           cbPart;
+	size_t           cSelected = 0;
+	uint64_t         iCodePoint;
+	size_t          *piSelected;
+	WildFilterPlace *pPlaces;
+	size_t          *piNextSelected;
+	WildFilterPlace *pNextPlaces;
+
+	if (pFilter->cLevels == pFilter->cMaxLevels)
+	{
+		WildFilterLevel *pGrown = (WildFilterLevel *) realloc( 
+		    pFilter->pLevels, 2 * pFilter->cMaxLevels * 
+		    sizeof(WildFilterLevel));
+
+		if (!pGrown)
+		{
+			return false;
+		}
+
+		pFilter->pLevels = pGrown;
+		pFilter->cMaxLevels *= 2;
+	}
+
+	pLevel = &pFilter->pLevels[pFilter->cLevels - 1];
+	pNext = pLevel + 1;
+	pNext->cbWild = pLevel->cbWild + cbCodePoint;
+	pNext->iFirst = pLevel->iFirst + pLevel->cSelected;
+
+	// There must be room for every name the top level selected.
+	if (pNext->iFirst + pLevel->cSelected > pFilter->cMaxSelected)
+	{
+		size_t cMaxSelected = 2 * pFilter->cMaxSelected;
+		size_t *piGrown;
+		WildFilterPlace *pGrown;
+
+		piGrown = (size_t *) realloc(pFilter->piSelected, 
+		                             cMaxSelected * sizeof(size_t));
+		pFilter->piSelected = piGrown ? piGrown : pFilter->piSelected;
+		pGrown = (WildFilterPlace *) realloc(pFilter->pPlaces, 
+		    cMaxSelected * sizeof(WildFilterPlace));
+		pFilter->pPlaces = pGrown ? pGrown : pFilter->pPlaces;
+
+		if (!piGrown || !pGrown)
+		{
+			return false;
+		}
+
+		pFilter->cMaxSelected = cMaxSelected;
+	}
+
+	piSelected = pFilter->piSelected + pLevel->iFirst;
+	pPlaces = pFilter->pPlaces + pLevel->iFirst;
+	piNextSelected = pFilter->piSelected + pNext->iFirst;
+	pNextPlaces = pFilter->pPlaces + pNext->iFirst;
+
+	// The last part runs from the last '*' to the new code point's end.
+	pCodePoint = pFilter->pWild + pLevel->cbWild;
+
+	for (pPart = pCodePoint + cbCodePoint; 
+	     pPart > pFilter->pWild && pPart[-1] != '*'; pPart--)
+	{
+	}
+
+	cbPart = pCodePoint + cbCodePoint - pPart;
+	iCodePoint = WildFilterPack(pCodePoint, cbCodePoint);
+
+	for (size_t iSelected = 0; iSelected < pLevel->cSelected; iSelected++)
+	{
+		size_t          iName = piSelected[iSelected];
+		char           *pName = pFilter->ppNames[iName];
+		WildFilterPlace place = pPlaces[iSelected];
+
+		if (*pCodePoint == '*')
+		{
+			place.iStart = place.iEnd;
+		}
+		else if (!WildFilterAppend(&place, pName, pCodePoint, iCodePoint, 
+		                           cbCodePoint))
+		{
+			// The last part moves to the next place it matches.
+			char *pAt = pName + place.iStart;
+			char *pAfter = NULL;
+
+			if (pPart == pFilter->pWild)
+			{
+				continue;              // "abd" doesn't match "abc...".
+			}
+
+			while (*pAt)
+			{
+				while ((*++pAt & 0xC0) == 0x80)
+				{
+				}
+
+				if (*pPart != '?' && !(pAt = strchr(pAt, *pPart)))
+				{
+					break;
+				}
+
+				if ((pAfter = WildFilterCompare(pPart, cbPart, pAt)))
+				{
+					break;
+				}
+			}
+
+			if (!pAt || !pAfter)
+			{
+				continue;              // "*ab" doesn't match "...ac...".
+			}
+
+			place.iStart = (uint32_t) (pAt - pName);
+			place.iEnd = (uint32_t) (pAfter - pName);
+			WildFilterFill(&place, pName);
+		}
+
+		piNextSelected[cSelected] = iName;
+		pNextPlaces[cSelected++] = place;
+	}
+
+	pNext->cSelected = cSelected;
+	pFilter->cLevels++;
+	return true;
+}
+
+
+// Creates a filter over cNames null-terminated names, which must stay in 
+// place while the filter is in use.  Returns NULL if memory for the filter 
+// can't be allocated.
+//
+WildFilter *FastWildFilterCreate(char **ppNames, size_t cNames)
+{
+	WildFilter *pFilter = (WildFilter *) calloc(1, sizeof(WildFilter));
+
+	if (!pFilter)
+	{
+		return NULL;
+	}
+
+	pFilter->ppNames = ppNames;
+	pFilter->cNames = cNames;
+	pFilter->cbMaxWild = 64;
+	pFilter->pWild = (char *) malloc(pFilter->cbMaxWild);
+	pFilter->cMaxLevels = 16;
+	pFilter->pLevels = (WildFilterLevel *) malloc(pFilter->cMaxLevels * 
+	                                              sizeof(WildFilterLevel));
+	pFilter->cMaxSelected = 2 * cNames + 1;
+	pFilter->piSelected = (size_t *) malloc(pFilter->cMaxSelected * 
+	                                        sizeof(size_t));
+	pFilter->pPlaces = (WildFilterPlace *) malloc(pFilter->cMaxSelected * 
+	                                              sizeof(WildFilterPlace));
+
+	if (!pFilter->pWild || !pFilter->pLevels || !pFilter->piSelected || 
+	    !pFilter->pPlaces)
+	{
+		FastWildFilterFree(pFilter);
+		return NULL;
+	}
+
+	// Level 0, for the empty pattern, selects every name.
+	pFilter->pLevels[0].cbWild = 0;
+	pFilter->pLevels[0].iFirst = 0;
+	pFilter->pLevels[0].cSelected = cNames;
+	pFilter->cLevels = 1;
+	memset(pFilter->pPlaces, 0, cNames * sizeof(WildFilterPlace));
+
+	for (size_t iName = 0; iName < cNames; iName++)
+	{
+		pFilter->piSelected[iName] = iName;
+	}
+
+	return pFilter;
+}
+
+
+// Selects the names that a pattern matches as though it ended with '*', 
+// reusing the selections made for earlier patterns that start the same 
+// way.  Sets *ppiSelected to the filter's array of the selected names' 
+// ascending indexes, good until the next call, and *pcSelected to their 
+// number.  Returns false if memory runs out, in which case the selection 
+// is for as much of the pattern as memory allowed.  PERFORMS NO UTF-8 
+// VALIDATION.
+//
+bool FastWildFilterUtf8(WildFilter *pFilter, char *pWild, 
+                        size_t **ppiSelected, size_t *pcSelected)
+{
+	size_t           cbWild = strlen(pWild);
+	size_t           cbCommon = 0;
+	WildFilterLevel *pTop = &pFilter->pLevels[pFilter->cLevels - 1];
+	bool             bExtended = true;
+
+	while (cbCommon < pTop->cbWild && cbCommon < cbWild && 
+	       pFilter->pWild[cbCommon] == pWild[cbCommon])
+	{
+		cbCommon++;
+	}
+
+	// The levels for content that's been deleted or changed are dropped.
+	while (pTop->cbWild > cbCommon)
+	{
+		pTop--;
+		pFilter->cLevels--;
+	}
+
+	if (cbWild >= pFilter->cbMaxWild)
+	{
+		char *pGrown = (char *) realloc(pFilter->pWild, 2 * cbWild);
+
+		if (pGrown)
+		{
+			pFilter->pWild = pGrown;
+			pFilter->cbMaxWild = 2 * cbWild;
+		}
+		else
+		{
+			bExtended = false;
+		}
+	}
+
+	if (bExtended)
+	{
+		memcpy(pFilter->pWild, pWild, cbWild + 1);
+	}
+
+	while (bExtended && pTop->cbWild < cbWild)
+	{
+		size_t cbCodePoint = CodePointBytes(pWild[pTop->cbWild]);
+
+		if (cbCodePoint > cbWild - pTop->cbWild)
+		{
+			cbCodePoint = cbWild - pTop->cbWild;
+		}
+
+		bExtended = WildFilterExtend(pFilter, cbCodePoint);
+		pTop = &pFilter->pLevels[pFilter->cLevels - 1];
+	}
+
+	*ppiSelected = pFilter->piSelected + pTop->iFirst;
+	*pcSelected = pTop->cSelected;
+	return bExtended;
+}
+
+
+// Releases a filter.
+//
+void FastWildFilterFree(WildFilter *pFilter)
+{
+	if (pFilter)
+	{
+		free(pFilter->piSelected);
+		free(pFilter->pPlaces);
+		free(pFilter->pLevels);
+		free(pFilter->pWild);
+		free(pFilter);
+	}
+
+	return;
+}
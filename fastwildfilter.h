@@ -0,0 +1,36 @@
+// Filtering a list of names by a UTF-8-ready wildcard pattern that's 
+// being typed, one keystroke at a time.
+//
+// FastWildFilterCreate() makes a filter over an array of null-terminated 
+// names, which the caller keeps in place for as long as the filter is in 
+// use.  FastWildFilterUtf8() selects the names that the pattern matches 
+// as though it ended with '*', so that a name is selected once what's 
+// been typed matches its start, or anywhere within it if the pattern 
+// starts with '*'.  It sets *ppiSelected to the filter's own array of the 
+// ascending indexes of the selected names, good until the next call, and 
+// *pcSelected to their number.  It returns false if memory runs out, in 
+// which case the filter is left as it was for some shorter pattern, and 
+// the next call can still succeed.  FastWildFilterFree() releases it.
+//
+// Appending content to a pattern that implicitly ends with '*' can only 
+// narrow its selection, so the filter keeps the selection for each code 
+// point of the pattern typed so far, along with where the part of the 
+// pattern after its last '*' matched each selected name.  A code point 
+// appended to the pattern is tried only against the names selected 
+// before, mostly by comparing it with the content following that part, 
+// and deleting from the end of the pattern takes the selection made for 
+// the shorter pattern.  A pattern that differs from the last elsewhere 
+// is treated as deletions down to where they agree, then appends.
+#if !defined(FASTWILDFILTER_H)
+#define FASTWILDFILTER_H
+
+#include <stddef.h>
+
+struct WildFilter;
+
+WildFilter *FastWildFilterCreate(char **ppNames, size_t cNames);
+bool FastWildFilterUtf8(WildFilter *pFilter, char *pWild, 
+                        size_t **ppiSelected, size_t *pcSelected);
+void FastWildFilterFree(WildFilter *pFilter);
+
+#endif  // FASTWILDFILTER_H
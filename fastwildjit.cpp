@@ -0,0 +1,623 @@
+// x86-64 JIT compilation of UTF-8-ready wildcard patterns.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// The upper loop of FastWildCompareUtf8() walks the pattern up to its first
+// '*' one code point at a time, comparing each literal and stepping over a
+// code point for each '?'.  For a long-lived pattern that walk is the same
+// every time, so it's emitted here as straight-line machine code: literal
+// bytes become unrolled compares at fixed displacements, and each '?'
+// becomes an inlined copy of CodePointAdvance().
+//
+// Each '*' is followed by a segment of literals and '?'s that ends at the 
+// next '*' or at the end of the pattern.  Any '?'s that open a segment are 
+// moved ahead of the '*', which matches the same strings, so every segment 
+// opens with a literal.  A segment becomes a search loop: a memchr-style 
+// scan for the first byte of that literal, stepping through the tame 
+// string as CodePointAdvance() does, then the same unrolled compares as 
+// for the prefix.  A mismatch resumes the scan past the code point where 
+// the candidate started, and running out of tame string fails the whole 
+// match, since no later start could fit the segment either.  The last 
+// segment also has to end where the tame string ends, so it's retried 
+// until it does.  Taking the leftmost match of each segment in turn is 
+// enough, because a match that starts later can't end any sooner.
+//
+// The emitted routine thus matches the whole pattern, and the interpreter 
+// takes over only for a pattern that ends in a truncated code point.
+//
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildcompare.h"
+#include "fastwildjit.h"
+#include "fastwildutf8.h"
+
+#if !defined(FASTWILD_DISABLE_JIT) && (defined(__x86_64__) || defined(_M_X64))
+#define FASTWILD_JIT  1
+#endif
+
+#if defined(FASTWILD_JIT)
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#endif  // FASTWILD_JIT
+
+typedef bool (*WildJitMatchRoutine)(char *pTame);
+
+struct WildJitPattern
+{
+	char                 *pWild;        // Private copy of the pattern
+	WildJitMatchRoutine   pfnMatch;     // Emitted code, or NULL to interpret
+	size_t                cbMapping;    // Size of the executable mapping
+};
+
+
+#if defined(FASTWILD_JIT)
+// Bytes of machine code emitted, at most, for each byte of the pattern, 
+// by kind, and for the prologue, epilogue, and failure path.
+//
+#define JIT_BYTES_PER_LITERAL  13
+#define JIT_BYTES_PER_QUESTION 64
+#define JIT_BYTES_PER_STAR     128
+#define JIT_BYTES_FIXED        32
+
+// A buffer of machine code under construction, plus the locations of
+// 32-bit branch displacements that are to be pointed at the failure path, 
+// and at the retry path of the segment being emitted.
+//
+struct JitEmitter
+{
+	unsigned char *pCode;
+	size_t         cbCode;
+	size_t        *pFailFixups;
+	size_t         cFailFixups;
+	size_t        *pRetryFixups;
+	size_t         cRetryFixups;
+};
+
+
+inline void JitEmit(JitEmitter *pEmitter, unsigned char chByte)
+{
+	pEmitter->pCode[pEmitter->cbCode++] = chByte;
+}
+
+
+inline void JitEmit32(JitEmitter *pEmitter, int iValue)
+{
+	memcpy(pEmitter->pCode + pEmitter->cbCode, &iValue, sizeof(iValue));
+	pEmitter->cbCode += sizeof(iValue);
+}
+
+
+// Emits a 32-bit conditional branch, with opcode 0x0F chOpcode, to the
+// failure path.  The displacement is fixed up once the path is placed.
+//
+inline void JitEmitBranchToFail(JitEmitter *pEmitter, unsigned char chOpcode)
+{
+	JitEmit(pEmitter, 0x0F);
+	JitEmit(pEmitter, chOpcode);
+	pEmitter->pFailFixups[pEmitter->cFailFixups++] = pEmitter->cbCode;
+	JitEmit32(pEmitter, 0);
+}
+
+
+// Emits a 32-bit conditional branch, with opcode 0x0F chOpcode, to the
+// retry path of the current segment, which is placed after its compares.
+//
+inline void JitEmitBranchToRetry(JitEmitter *pEmitter, unsigned char chOpcode)
+{
+	JitEmit(pEmitter, 0x0F);
+	JitEmit(pEmitter, chOpcode);
+	pEmitter->pRetryFixups[pEmitter->cRetryFixups++] = pEmitter->cbCode;
+	JitEmit32(pEmitter, 0);
+}
+
+
+// Points the 32-bit branch displacements at the given locations to iTarget.
+//
+void JitFixup(JitEmitter *pEmitter, size_t *pFixups, size_t cFixups, 
+              size_t iTarget)
+{
+	for (size_t iFixup = 0; iFixup < cFixups; iFixup++)
+	{
+		size_t iAt = pFixups[iFixup];
+		int iRelative = (int) (iTarget - (iAt + sizeof(int)));
+		memcpy(pEmitter->pCode + iAt, &iRelative, sizeof(iRelative));
+	}
+
+	return;
+}
+
+
+// Emits "add rax, iDisplacement" to bring a pending displacement into the
+// tame pointer, which lives in rax throughout the emitted routine.
+//
+inline void JitEmitCommitDisplacement(JitEmitter *pEmitter, int iDisplacement)
+{
+	if (iDisplacement)
+	{
+		JitEmit(pEmitter, 0x48);                       // add rax, imm32
+		JitEmit(pEmitter, 0x05);
+		JitEmit32(pEmitter, iDisplacement);
+	}
+}
+
+
+// Emits an inlined CodePointAdvance() past the nonzero byte at rax, which 
+// is also in edx.  Each continuation byte is counted only if it is 
+// nonzero, just as in the interpreted routine.
+//
+void JitEmitAdvance(JitEmitter *pEmitter)
+{
+	static const unsigned char rgLimits[] =
+	{
+		SINGLETON_LIMIT, TWOFER_LIMIT, THREESOME_LIMIT
+	};
+
+	JitEmit(pEmitter, 0xB9);                           // mov ecx, 1
+	JitEmit32(pEmitter, 1);
+
+	for (int iByte = 0; iByte < 3; iByte++)
+	{
+		JitEmit(pEmitter, 0x80);                       // cmp dl, limit
+		JitEmit(pEmitter, 0xFA);
+		JitEmit(pEmitter, rgLimits[iByte]);
+		JitEmit(pEmitter, 0x76);                       // jbe next
+		JitEmit(pEmitter, 8);
+		JitEmit(pEmitter, 0x80);                       // cmp [rax+n], 0
+		JitEmit(pEmitter, 0x78);
+		JitEmit(pEmitter, (unsigned char) (iByte + 1));
+		JitEmit(pEmitter, 0x00);
+		JitEmit(pEmitter, 0x74);                       // je next
+		JitEmit(pEmitter, 2);
+		JitEmit(pEmitter, 0xFF);                       // inc ecx
+		JitEmit(pEmitter, 0xC1);
+	}
+
+	JitEmit(pEmitter, 0x48);                           // add rax, rcx
+	JitEmit(pEmitter, 0x01);
+	JitEmit(pEmitter, 0xC8);
+}
+
+
+// Emits the code for a '?', which checks for the terminating null and then 
+// advances past a code point.
+//
+void JitEmitQuestion(JitEmitter *pEmitter)
+{
+	JitEmit(pEmitter, 0x0F);                           // movzx edx, [rax]
+	JitEmit(pEmitter, 0xB6);
+	JitEmit(pEmitter, 0x10);
+	JitEmit(pEmitter, 0x85);                           // test edx, edx
+	JitEmit(pEmitter, 0xD2);
+	JitEmitBranchToFail(pEmitter, 0x84);               // je fail
+	JitEmitAdvance(pEmitter);
+}
+
+
+// Points the 8-bit branch displacement at iAt to the current location.
+//
+inline void JitFixup8(JitEmitter *pEmitter, size_t iAt)
+{
+	pEmitter->pCode[iAt] = (unsigned char) (pEmitter->cbCode - (iAt + 1));
+}
+
+
+// Emits "cmp byte [rax+iDisplacement], chByte" and a branch, to the 
+// failure path or to the retry path, for a mismatch.
+//
+inline void JitEmitCompare(JitEmitter *pEmitter, int iDisplacement, 
+                           unsigned char chByte, bool bRetry)
+{
+	JitEmit(pEmitter, 0x80);                           // cmp [rax+disp], imm
+	JitEmit(pEmitter, 0xB8);
+	JitEmit32(pEmitter, iDisplacement);
+	JitEmit(pEmitter, chByte);
+
+	if (bRetry)
+	{
+		JitEmitBranchToRetry(pEmitter, 0x85);          // jne retry
+	}
+	else
+	{
+		JitEmitBranchToFail(pEmitter, 0x85);           // jne fail
+	}
+}
+
+
+// Emits compares for the literals and '?'s from pWild up to pWildEnd, 
+// where a '*' or the terminating null follows.  Tame bytes matched beyond 
+// rax are tallied in *piDisplacement.  A literal mismatch goes to the 
+// retry path if bRetry is set, or else to the failure path.  Returns false 
+// if the run ends in a truncated code point.
+//
+bool JitEmitRun(JitEmitter *pEmitter, char *pWild, char *pWildEnd, 
+                int *piDisplacement, bool bRetry)
+{
+	while (pWild < pWildEnd)
+	{
+		if (*pWild == '?')
+		{
+			JitEmitCommitDisplacement(pEmitter, *piDisplacement);
+			*piDisplacement = 0;
+			JitEmitQuestion(pEmitter);
+			pWild++;
+			continue;
+		}
+
+		unsigned char chLead = *(unsigned char *) pWild;
+		int cbCodePoint = 1 + (chLead > SINGLETON_LIMIT) +
+		                  (chLead > TWOFER_LIMIT) + (chLead > THREESOME_LIMIT);
+
+		for (int iByte = 0; iByte < cbCodePoint; iByte++)
+		{
+			if (pWild + iByte >= pWildEnd)
+			{
+				return false;
+			}
+
+			JitEmitCompare(pEmitter, (*piDisplacement)++, 
+			               (unsigned char) pWild[iByte], bRetry);
+		}
+
+		pWild += cbCodePoint;
+	}
+
+	return true;
+}
+
+
+// Emits the search loop for a segment that opens with a literal at pWild 
+// and ends at pWildEnd, with rax pointing where the search begins.  If 
+// the segment is the last, the tame string has to end where it does.  
+// Leaves rax just past the match.  Returns false if the segment contains 
+// a truncated code point.
+//
+bool JitEmitSegment(JitEmitter *pEmitter, char *pWild, char *pWildEnd, 
+                    bool bLast)
+{
+	unsigned char chLead = *(unsigned char *) pWild;
+	int cbCodePoint = 1 + (chLead > SINGLETON_LIMIT) +
+	                  (chLead > TWOFER_LIMIT) + (chLead > THREESOME_LIMIT);
+	int iDisplacement = 1;   // The scan matches the lead byte at rax.
+	size_t iScan = pEmitter->cbCode;
+
+	if (pWild + cbCodePoint > pWildEnd)
+	{
+		return false;
+	}
+
+	JitEmit(pEmitter, 0x0F);                           // scan: movzx edx, [rax]
+	JitEmit(pEmitter, 0xB6);
+	JitEmit(pEmitter, 0x10);
+	JitEmit(pEmitter, 0x80);                           // cmp dl, lead
+	JitEmit(pEmitter, 0xFA);
+	JitEmit(pEmitter, chLead);
+	JitEmit(pEmitter, 0x74);                           // je candidate
+	size_t iToCandidate = pEmitter->cbCode;
+	JitEmit(pEmitter, 0);
+	JitEmit(pEmitter, 0x85);                           // test edx, edx
+	JitEmit(pEmitter, 0xD2);
+	JitEmitBranchToFail(pEmitter, 0x84);               // je fail
+
+	// Most bytes stand alone, and the rest start code points that are 
+	// stepped over as CodePointAdvance() would.
+	size_t iAdvance = pEmitter->cbCode;
+	JitEmit(pEmitter, 0x80);                           // advance: cmp dl, limit
+	JitEmit(pEmitter, 0xFA);
+	JitEmit(pEmitter, SINGLETON_LIMIT);
+	JitEmit(pEmitter, 0x77);                           // ja multibyte
+	size_t iToMultibyte = pEmitter->cbCode;
+	JitEmit(pEmitter, 0);
+	JitEmit(pEmitter, 0x48);                           // inc rax
+	JitEmit(pEmitter, 0xFF);
+	JitEmit(pEmitter, 0xC0);
+	JitEmit(pEmitter, 0xEB);                           // jmp scan
+	JitEmit(pEmitter, (unsigned char) (iScan - (pEmitter->cbCode + 1)));
+	JitFixup8(pEmitter, iToMultibyte);
+	JitEmitAdvance(pEmitter);                          // multibyte:
+	JitEmit(pEmitter, 0xEB);                           // jmp scan
+	JitEmit(pEmitter, (unsigned char) (iScan - (pEmitter->cbCode + 1)));
+	JitFixup8(pEmitter, iToCandidate);
+	JitEmit(pEmitter, 0x49);                           // candidate: mov r8, rax
+	JitEmit(pEmitter, 0x89);
+	JitEmit(pEmitter, 0xC0);
+
+	for (int iByte = 1; iByte < cbCodePoint; iByte++)
+	{
+		JitEmitCompare(pEmitter, iDisplacement++, 
+		               (unsigned char) pWild[iByte], true);
+	}
+
+	if (!JitEmitRun(pEmitter, pWild + cbCodePoint, pWildEnd, 
+	                &iDisplacement, true))
+	{
+		return false;
+	}
+
+	if (bLast)
+	{
+		JitEmitCompare(pEmitter, iDisplacement, 0x00, true);
+	}
+
+	JitEmitCommitDisplacement(pEmitter, iDisplacement);
+	JitEmit(pEmitter, 0xEB);                           // jmp done
+	size_t iToDone = pEmitter->cbCode;
+	JitEmit(pEmitter, 0);
+
+	// The retry path resumes the scan past the candidate's code point.
+	JitFixup(pEmitter, pEmitter->pRetryFixups, pEmitter->cRetryFixups, 
+	         pEmitter->cbCode);
+	pEmitter->cRetryFixups = 0;
+	JitEmit(pEmitter, 0x4C);                           // mov rax, r8
+	JitEmit(pEmitter, 0x89);
+	JitEmit(pEmitter, 0xC0);
+	JitEmit(pEmitter, 0x0F);                           // movzx edx, [rax]
+	JitEmit(pEmitter, 0xB6);
+	JitEmit(pEmitter, 0x10);
+	JitEmit(pEmitter, 0xE9);                           // jmp advance
+	JitEmit32(pEmitter, (int) (iAdvance - (pEmitter->cbCode + sizeof(int))));
+	JitFixup8(pEmitter, iToDone);                      // done:
+	return true;
+}
+
+
+// Emits the routine that matches the whole pattern into a buffer sized for 
+// it.  Returns the number of bytes emitted, or 0 if the pattern contains a 
+// truncated code point (which is left to the interpreter).
+//
+size_t JitEmitPattern(JitEmitter *pEmitter, char *pWild)
+{
+	int iDisplacement = 0;   // Tame bytes matched beyond rax, so far
+	char *pWildEnd = pWild;
+
+#if defined(_WIN32)
+	JitEmit(pEmitter, 0x48);                           // mov rax, rcx
+	JitEmit(pEmitter, 0x89);
+	JitEmit(pEmitter, 0xC8);
+#else
+	JitEmit(pEmitter, 0x48);                           // mov rax, rdi
+	JitEmit(pEmitter, 0x89);
+	JitEmit(pEmitter, 0xF8);
+#endif
+
+	while (*pWildEnd && *pWildEnd != '*')
+	{
+		pWildEnd++;
+	}
+
+	if (!JitEmitRun(pEmitter, pWild, pWildEnd, &iDisplacement, false))
+	{
+		return 0;
+	}
+
+	if (!*pWildEnd)
+	{
+		// No '*' at all: the tame string has to end right here.
+		JitEmitCompare(pEmitter, iDisplacement, 0x00, false);
+	}
+
+	JitEmitCommitDisplacement(pEmitter, iDisplacement);
+	pWild = pWildEnd;
+
+	while (*pWild)
+	{
+		// Step over the stars, and over any '?'s among them, as though 
+		// the '?'s came first.
+		while (*pWild == '*' || *pWild == '?')
+		{
+			if (*pWild++ == '?')
+			{
+				JitEmitQuestion(pEmitter);
+			}
+		}
+
+		if (!*pWild)
+		{
+			break;                                     // "ab*" matches "abc".
+		}
+
+		for (pWildEnd = pWild; *pWildEnd && *pWildEnd != '*'; pWildEnd++)
+		{
+			continue;
+		}
+
+		if (!JitEmitSegment(pEmitter, pWild, pWildEnd, !*pWildEnd))
+		{
+			return 0;
+		}
+
+		pWild = pWildEnd;
+	}
+
+	JitEmit(pEmitter, 0xB8);                           // mov eax, 1
+	JitEmit32(pEmitter, 1);
+	JitEmit(pEmitter, 0xC3);                           // ret
+
+	// The failure path returns false.
+	JitFixup(pEmitter, pEmitter->pFailFixups, pEmitter->cFailFixups, 
+	         pEmitter->cbCode);
+	JitEmit(pEmitter, 0x31);                           // xor eax, eax
+	JitEmit(pEmitter, 0xC0);
+	JitEmit(pEmitter, 0xC3);                           // ret
+	return pEmitter->cbCode;
+}
+
+
+// Copies emitted code into a fresh mapping and makes it executable (and no
+// longer writable).  Returns NULL if that can't be arranged.
+//
+void *JitMapExecutable(unsigned char *pCode, size_t cbCode, size_t *pcbMapping)
+{
+#if defined(_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	size_t cbPage = info.dwPageSize;
+#else
+	size_t cbPage = (size_t) sysconf(_SC_PAGESIZE);
+#endif
+	size_t cbMapping = (cbCode + cbPage - 1) & ~(cbPage - 1);
+
+#if defined(_WIN32)
+	void *pMapping = VirtualAlloc(NULL, cbMapping, MEM_COMMIT | MEM_RESERVE,
+	                              PAGE_READWRITE);
+	DWORD dwOldProtect;
+
+	if (!pMapping)
+	{
+		return NULL;
+	}
+
+	memcpy(pMapping, pCode, cbCode);
+
+	if (!VirtualProtect(pMapping, cbMapping, PAGE_EXECUTE_READ,
+	                    &dwOldProtect))
+	{
+		VirtualFree(pMapping, 0, MEM_RELEASE);
+		return NULL;
+	}
+
+	FlushInstructionCache(GetCurrentProcess(), pMapping, cbMapping);
+#else
+	void *pMapping = mmap(NULL, cbMapping, PROT_READ | PROT_WRITE,
+	                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (pMapping == MAP_FAILED)
+	{
+		return NULL;
+	}
+
+	memcpy(pMapping, pCode, cbCode);
+
+	if (mprotect(pMapping, cbMapping, PROT_READ | PROT_EXEC))
+	{
+		munmap(pMapping, cbMapping);
+		return NULL;
+	}
+#endif
+
+	*pcbMapping = cbMapping;
+	return pMapping;
+}
+#endif  // FASTWILD_JIT
+
+
+// Compiles a null-terminated UTF-8 pattern.  Returns NULL only if memory
+// for the pattern can't be allocated.  Whether or not native code could be
+// emitted, the result can be passed to FastWildJitCompareUtf8().
+//
+WildJitPattern *FastWildJitCompile(char *pWild)
+{
+	WildJitPattern *pPattern =
+	    (WildJitPattern *) malloc(sizeof(WildJitPattern));
+	size_t cbWild = strlen(pWild);
+
+	if (!pPattern)
+	{
+		return NULL;
+	}
+
+	pPattern->pWild = (char *) malloc(cbWild + 1);
+	pPattern->pfnMatch = NULL;
+	pPattern->cbMapping = 0;
+
+	if (!pPattern->pWild)
+	{
+		free(pPattern);
+		return NULL;
+	}
+
+	memcpy(pPattern->pWild, pWild, cbWild + 1);
+
+#if defined(FASTWILD_JIT)
+	JitEmitter emitter;
+
+	emitter.cbCode = 0;
+	emitter.cFailFixups = 0;
+	emitter.cRetryFixups = 0;
+	emitter.pCode = (unsigned char *) malloc(JIT_BYTES_FIXED + cbWild * 
+	    (JIT_BYTES_PER_LITERAL + JIT_BYTES_PER_QUESTION + JIT_BYTES_PER_STAR));
+	emitter.pFailFixups = (size_t *) malloc((2 * cbWild + 1) *
+	                                        sizeof(size_t));
+	emitter.pRetryFixups = (size_t *) malloc((cbWild + 1) * sizeof(size_t));
+
+	if (emitter.pCode && emitter.pFailFixups && emitter.pRetryFixups &&
+	    JitEmitPattern(&emitter, pPattern->pWild))
+	{
+		pPattern->pfnMatch = (WildJitMatchRoutine) JitMapExecutable(
+		    emitter.pCode, emitter.cbCode, &pPattern->cbMapping);
+	}
+
+	free(emitter.pCode);
+	free(emitter.pFailFixups);
+	free(emitter.pRetryFixups);
+#endif  // FASTWILD_JIT
+
+	return pPattern;
+}
+
+
+// Matches a null-terminated UTF-8 tame string against a compiled pattern.
+// Returns the same result as FastWildCompareUtf8() for the original pattern.
+// PERFORMS NO UTF-8 VALIDATION.
+//
+bool FastWildJitCompareUtf8(WildJitPattern *pPattern, char *pTame)
+{
+	if (!pPattern->pfnMatch)
+	{
+		return FastWildCompareUtf8(pPattern->pWild, pTame);
+	}
+
+	return pPattern->pfnMatch(pTame);
+}
+
+
+// Returns true if the pattern has been compiled to native code, or false
+// if FastWildJitCompareUtf8() interprets it.
+//
+bool FastWildJitIsNative(WildJitPattern *pPattern)
+{
+	return pPattern->pfnMatch != NULL;
+}
+
+
+// Releases a compiled pattern and any executable mapping it holds.
+//
+void FastWildJitFree(WildJitPattern *pPattern)
+{
+	if (!pPattern)
+	{
+		return;
+	}
+
+#if defined(FASTWILD_JIT)
+	if (pPattern->pfnMatch)
+	{
+#if defined(_WIN32)
+		VirtualFree((void *) pPattern->pfnMatch, 0, MEM_RELEASE);
+#else
+		munmap((void *) pPattern->pfnMatch, pPattern->cbMapping);
+#endif
+	}
+#endif  // FASTWILD_JIT
+
+	free(pPattern->pWild);
+	free(pPattern);
+}
@@ -0,0 +1,11 @@
+// x86-64 JIT compilation of UTF-8-ready wildcard patterns.
+//
+// A compiled pattern keeps its own copy of the wild string.  When JIT
+// compilation is unavailable (non-x86-64 builds, FASTWILD_DISABLE_JIT, or a
+// failure to map executable memory), it falls back to FastWildCompareUtf8().
+struct WildJitPattern;
+
+WildJitPattern *FastWildJitCompile(char *pWild);
+bool FastWildJitCompareUtf8(WildJitPattern *pPattern, char *pTame);
+bool FastWildJitIsNative(WildJitPattern *pPattern);
+void FastWildJitFree(WildJitPattern *pPattern);
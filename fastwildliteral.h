@@ -0,0 +1,119 @@
+// Literal content helpers shared by the routines for matching compiled 
+// wildcard patterns.
+//
+#if !defined(FASTWILDLITERAL_H)
+#define FASTWILDLITERAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define WILD_HASH_BASIS  0xCBF29CE484222325ULL   // FNV-1a
+#define WILD_HASH_PRIME  0x100000001B3ULL
+
+// Finds the first occurrence of a literal in a run of bytes of known 
+// length, via vector compares where available.  Returns NULL if there's no 
+// occurrence.  Defined in fastwildpattern.cpp.
+//
+char *WildFindLiteral(char *pContent, size_t cbContent, char *pLiteral,
+                      size_t cbLiteral);
+
+
+// Returns the index of the lowest set bit in a nonzero mask.
+//
+inline int WildLowestBit(unsigned int iMask)
+{
+#if defined(_MSC_VER)
+	unsigned long iBit;
+	_BitScanForward(&iBit, iMask);
+	return (int) iBit;
+#else
+	return __builtin_ctz(iMask);
+#endif
+}
+
+
+// Hashes one more byte of literal content.
+//
+inline uint64_t WildHashStep(uint64_t iHash, unsigned char chByte)
+{
+	return (iHash ^ chByte) * WILD_HASH_PRIME;
+}
+
+
+// Estimates how common a byte is in typical text, file paths, and logs, 
+// on a scale of 0 (rare) to 255 (common).  Lowercase letters are ranked in 
+// order of their frequency in English text.
+//
+inline int WildByteFrequency(unsigned char chByte)
+{
+	static const char rgCommon[] = " etaoinsrhldcu/.mfpgwy_b0123456789v-k";
+	const char *pCommon = 
+	    chByte ? (const char *) memchr(rgCommon, chByte, sizeof(rgCommon) - 1)
+	           : NULL;
+
+	if (pCommon)
+	{
+		return 255 - 4 * (int) (pCommon - rgCommon);
+	}
+	else if (chByte >= 'A' && chByte <= 'Z')
+	{
+		return 64;
+	}
+	else if (chByte >= 0x80)
+	{
+		return 48;                     // Part of a multiple-byte code point
+	}
+
+	return 16;
+}
+
+
+// Among the runs of literal content in part of a pattern, delimited by '*' 
+// and '?' wildcards, finds the one whose rarest byte is least common, 
+// preferring longer runs among equals.  Returns the frequency of that byte, 
+// or 256 if there's no literal content, in which case *pcbRun is 0.
+//
+inline int WildRarestRun(char *pContent, size_t cbContent, char **ppRun, 
+                         size_t *pcbRun)
+{
+	char *pEnd = pContent + cbContent;
+	int   iRarest = 256;
+
+	*ppRun = NULL;
+	*pcbRun = 0;
+
+	while (pContent < pEnd)
+	{
+		char *pRunEnd = pContent;
+		int   iFrequency = 256;
+
+		while (pRunEnd < pEnd && *pRunEnd != '*' && *pRunEnd != '?')
+		{
+			int iByte = WildByteFrequency(*(unsigned char *) pRunEnd++);
+
+			if (iByte < iFrequency)
+			{
+				iFrequency = iByte;
+			}
+		}
+
+		if (iFrequency < iRarest || (iFrequency == iRarest && 
+		    (size_t) (pRunEnd - pContent) > *pcbRun))
+		{
+			iRarest = iFrequency;
+			*ppRun = pContent;
+			*pcbRun = pRunEnd - pContent;
+		}
+
+		pContent = pRunEnd + 1;
+	}
+
+	return iRarest;
+}
+
+#endif  // FASTWILDLITERAL_H
@@ -0,0 +1,275 @@
+// Replaceable pattern sets of UTF-8-ready wildcard patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Each published set is a version.  Readers reach the current version 
+// through one atomic pointer, and writers replace it with an atomic 
+// exchange, in the manner of read-copy-update.  A replaced version is 
+// retired with the epoch of its replacement, and freed once every reader 
+// in the middle of a match has entered in a later epoch.  Entering stores 
+// the current epoch in the reader's own cache line, and then loads the 
+// current version, so a reader that entered before a version was replaced 
+// is never missed.  Writers are serialized with each other, but compile 
+// their sets before taking the lock.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include "fastwildset.h"
+#include "fastwildlive.h"
+
+#define WILD_LIVE_READERS  128
+
+struct WildLiveVersion
+{
+	WildPatternSet        *pSet;
+	size_t                 cPatterns;
+	uint64_t               iRetired;   // Epoch of retirement
+	WildLiveVersion       *pNextRetired;
+};
+
+struct alignas(64) WildLiveReader
+{
+	std::atomic<uint64_t>  iActive;    // Announced epoch, or 0
+	std::atomic<bool>      bOpen;
+	WildLiveSet           *pLive;
+};
+
+struct WildLiveSet
+{
+	WildLiveReader                  rgReaders[WILD_LIVE_READERS];
+	std::atomic<WildLiveVersion *>  pCurrent;
+	std::atomic<uint64_t>           iEpoch;
+	std::mutex                      writerLock;
+	WildLiveVersion                *pRetired;
+	void                           *pBlock;   // As allocated
+};
+
+
+// Compiles a version of a set.  Returns NULL if memory for it can't be 
+// allocated.
+//
+WildLiveVersion *WildLiveVersionCompile(char **ppWild, size_t cWild)
+{
+	WildLiveVersion *pVersion = 
+	    (WildLiveVersion *) calloc(1, sizeof(WildLiveVersion));
+
+	if (!pVersion)
+	{
+		return NULL;
+	}
+
+	pVersion->pSet = FastWildSetCompile(ppWild, cWild);
+	pVersion->cPatterns = cWild;
+
+	if (!pVersion->pSet)
+	{
+		free(pVersion);
+		return NULL;
+	}
+
+	return pVersion;
+}
+
+
+// Frees the retired versions that no reader can still be using.  The 
+// writer lock must be held.
+//
+void WildLiveReclaim(WildLiveSet *pLive)
+{
+	uint64_t iOldest = UINT64_MAX;
+
+	for (size_t iReader = 0; iReader < WILD_LIVE_READERS; iReader++)
+	{
+		uint64_t iActive = pLive->rgReaders[iReader].iActive.load();
+
+		if (iActive && iActive < iOldest)
+		{
+			iOldest = iActive;
+		}
+	}
+
+	for (WildLiveVersion **ppRetired = &pLive->pRetired; *ppRetired; )
+	{
+		WildLiveVersion *pRetired = *ppRetired;
+
+		if (pRetired->iRetired < iOldest)
+		{
+			*ppRetired = pRetired->pNextRetired;
+			FastWildSetFree(pRetired->pSet);
+			free(pRetired);
+		}
+		else
+		{
+			ppRetired = &pRetired->pNextRetired;
+		}
+	}
+
+	return;
+}
+
+
+// Creates a live set from an array of null-terminated UTF-8 patterns.  
+// Returns NULL if memory for the set can't be allocated.
+//
+WildLiveSet *FastWildLiveCreate(char **ppWild, size_t cWild)
+{
+	void            *pBlock = calloc(1, sizeof(WildLiveSet) + 63);
+	WildLiveVersion *pVersion = WildLiveVersionCompile(ppWild, cWild);
+	WildLiveSet     *pLive;
+
+	if (!pBlock || !pVersion)
+	{
+		free(pBlock);
+
+		if (pVersion)
+		{
+			FastWildSetFree(pVersion->pSet);
+			free(pVersion);
+		}
+
+		return NULL;
+	}
+
+	// Readers are aligned to cache lines, so that announcing an epoch 
+	// doesn't disturb other readers.
+	pLive = new ((char *) pBlock + (-(uintptr_t) pBlock & 63)) WildLiveSet();
+	pLive->pBlock = pBlock;
+	pLive->pCurrent = pVersion;
+	pLive->iEpoch = 1;
+
+	for (size_t iReader = 0; iReader < WILD_LIVE_READERS; iReader++)
+	{
+		pLive->rgReaders[iReader].pLive = pLive;
+	}
+
+	return pLive;
+}
+
+
+// Compiles a set from an array of null-terminated UTF-8 patterns and 
+// makes it current, retiring the set it replaces.  Returns false, leaving 
+// the current set in place, if memory for the new set can't be allocated.
+//
+bool FastWildLivePublish(WildLiveSet *pLive, char **ppWild, size_t cWild)
+{
+	WildLiveVersion *pVersion = WildLiveVersionCompile(ppWild, cWild);
+
+	if (!pVersion)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> guard(pLive->writerLock);
+	WildLiveVersion *pReplaced = pLive->pCurrent.exchange(pVersion);
+
+	pReplaced->iRetired = pLive->iEpoch.fetch_add(1);
+	pReplaced->pNextRetired = pLive->pRetired;
+	pLive->pRetired = pReplaced;
+	WildLiveReclaim(pLive);
+	return true;
+}
+
+
+// Claims a reader for the calling thread.  Returns NULL if every reader 
+// is in use.
+//
+WildLiveReader *FastWildLiveReaderOpen(WildLiveSet *pLive)
+{
+	for (size_t iReader = 0; iReader < WILD_LIVE_READERS; iReader++)
+	{
+		WildLiveReader *pReader = &pLive->rgReaders[iReader];
+		bool            bOpen = false;
+
+		if (pReader->bOpen.compare_exchange_strong(bOpen, true))
+		{
+			return pReader;
+		}
+	}
+
+	return NULL;
+}
+
+
+// Returns the current set, and its number of patterns, which stays valid 
+// until FastWildLiveExit().
+//
+WildPatternSet *FastWildLiveEnter(WildLiveReader *pReader, 
+                                  size_t *pcPatterns)
+{
+	WildLiveSet     *pLive = pReader->pLive;
+	WildLiveVersion *pVersion;
+
+	pReader->iActive.store(pLive->iEpoch.load());
+	pVersion = pLive->pCurrent.load();
+	*pcPatterns = pVersion->cPatterns;
+	return pVersion->pSet;
+}
+
+
+// Ends a reader's use of the set returned by FastWildLiveEnter().
+//
+void FastWildLiveExit(WildLiveReader *pReader)
+{
+	pReader->iActive.store(0, std::memory_order_release);
+	return;
+}
+
+
+// Makes a reader available to another thread.
+//
+void FastWildLiveReaderClose(WildLiveReader *pReader)
+{
+	pReader->bOpen.store(false);
+	return;
+}
+
+
+// Releases a live set, along with its current and retired sets.  All of 
+// its readers must have been closed.
+//
+void FastWildLiveFree(WildLiveSet *pLive)
+{
+	if (!pLive)
+	{
+		return;
+	}
+
+	WildLiveVersion *pCurrent = pLive->pCurrent.load();
+	void            *pBlock = pLive->pBlock;
+
+	FastWildSetFree(pCurrent->pSet);
+	free(pCurrent);
+
+	while (pLive->pRetired)
+	{
+		WildLiveVersion *pRetired = pLive->pRetired;
+
+		pLive->pRetired = pRetired->pNextRetired;
+		FastWildSetFree(pRetired->pSet);
+		free(pRetired);
+	}
+
+	pLive->~WildLiveSet();
+	free(pBlock);
+	return;
+}
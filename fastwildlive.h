@@ -0,0 +1,31 @@
+// Pattern sets that can be replaced while other threads match against 
+// them, for rules that change while matching is under way.
+//
+// A live set is created by FastWildLiveCreate() from an array of 
+// null-terminated patterns.  FastWildLivePublish() compiles a replacement 
+// set, without holding up any reader, and makes it current; it returns 
+// false, leaving the current set in place, if the replacement can't be 
+// compiled.  Sets that have been replaced are released by a later 
+// FastWildLivePublish(), or by FastWildLiveFree(), once no reader can 
+// still be using them.
+//
+// Each thread that matches opens a reader, via FastWildLiveReaderOpen(), 
+// which returns NULL if all 128 readers are in use.  FastWildLiveEnter() 
+// returns the current set, along with its number of patterns, for use 
+// with FastWildSetCompareUtf8() until FastWildLiveExit().  Neither waits 
+// on anything.  Every reader must be closed, via FastWildLiveReaderClose(), 
+// before the live set is freed.
+#include <stddef.h>
+
+struct WildPatternSet;
+struct WildLiveSet;
+struct WildLiveReader;
+
+WildLiveSet *FastWildLiveCreate(char **ppWild, size_t cWild);
+bool FastWildLivePublish(WildLiveSet *pLive, char **ppWild, size_t cWild);
+WildLiveReader *FastWildLiveReaderOpen(WildLiveSet *pLive);
+WildPatternSet *FastWildLiveEnter(WildLiveReader *pReader, 
+                                  size_t *pcPatterns);
+void FastWildLiveExit(WildLiveReader *pReader);
+void FastWildLiveReaderClose(WildLiveReader *pReader);
+void FastWildLiveFree(WildLiveSet *pLive);
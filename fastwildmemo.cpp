@@ -0,0 +1,410 @@
+// A concurrent memo of wildcard match results in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// The memo is a table of 64-byte buckets, aligned to cache lines, so that 
+// a lookup touches one line.  Each bucket holds seven entries and a clock 
+// hand.  An entry is one 64-bit word: the upper 62 bits of the pair's 
+// fingerprint, a referenced bit, and the result bit.  The fingerprint is 
+// never 0 in those bits, so a 0 word is an empty entry.  Lookups and 
+// inserts are lock-free, via atomic loads, stores and compare-and-swaps 
+// on the entry words.  A lookup that hits sets the entry's referenced bit, 
+// if it's clear.  An insert takes an empty entry if the bucket has one, 
+// and otherwise sweeps the bucket's clock hand, clearing referenced bits, 
+// until it finds an entry without one to replace.  Concurrent inserts may 
+// replace each other's entries, which costs only a later miss.
+//
+// Fingerprints are hashed 8 bytes at a time, since the strings worth 
+// memoizing are long.  The tame string's hash is seeded with the 
+// pattern's.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <new>
+#include "fastwildcompare.h"
+#include "fastwildbatch.h"
+#include "fastwildmemo.h"
+
+#define WILD_MEMO_ENTRIES   7        // Entries per bucket
+#define WILD_MEMO_COUNTERS  16       // Counter lines, to spread contention
+#define WILD_MEMO_RESULT    1ULL
+#define WILD_MEMO_USED      2ULL
+#define WILD_MEMO_FLAGS     3ULL
+#define WILD_MEMO_LOCAL     64       // Batch entries kept on the stack
+
+#define WILD_HASH_K1  0x9E3779B97F4A7C15ULL
+#define WILD_HASH_K2  0xC2B2AE3D27D4EB4FULL
+
+struct alignas(64) WildMemoBucket
+{
+	std::atomic<uint64_t>  rgEntries[WILD_MEMO_ENTRIES];
+	std::atomic<uint64_t>  iHand;
+};
+
+struct alignas(64) WildMemoCounter
+{
+	std::atomic<uint64_t>  cHits;
+	std::atomic<uint64_t>  cMisses;
+};
+
+struct WildMemo
+{
+	WildMemoCounter        rgCounters[WILD_MEMO_COUNTERS];
+	WildMemoBucket        *pBuckets;   // Following the memo, in its block
+	size_t                 iBucketMask;
+	void                  *pBlock;     // As allocated, before alignment
+	size_t                 cbBlock;
+};
+
+// A tame string in a batch, while removing duplicates.
+//
+struct WildMemoTame
+{
+	uint64_t               iFingerprint;
+	size_t                 iTame;
+};
+
+
+// Hashes a run of bytes, 8 at a time, from a seed.
+//
+inline uint64_t WildMemoHash(char *pContent, size_t cbContent, uint64_t iSeed)
+{
+	uint64_t iHash = iSeed ^ (cbContent * WILD_HASH_K1);
+	uint64_t iWord;
+
+	for (; cbContent >= 8; pContent += 8, cbContent -= 8)
+	{
+		memcpy(&iWord, pContent, 8);
+		iHash = (iHash ^ (iWord * WILD_HASH_K2)) * WILD_HASH_K1;
+		iHash ^= iHash >> 29;
+	}
+
+	iWord = 0;
+	memcpy(&iWord, pContent, cbContent);
+	iHash = (iHash ^ (iWord * WILD_HASH_K2)) * WILD_HASH_K1;
+
+	// Final mixing, as in MurmurHash3.
+	iHash ^= iHash >> 33;
+	iHash *= 0xFF51AFD7ED558CCDULL;
+	iHash ^= iHash >> 33;
+	iHash *= 0xC4CEB9FE1A85EC53ULL;
+	iHash ^= iHash >> 33;
+	return iHash;
+}
+
+
+// Returns the fingerprint of a tame string, given its pattern's hash, with 
+// the flag bits clear and never 0.
+//
+inline uint64_t WildMemoFingerprint(uint64_t iWildHash, char *pTame)
+{
+	uint64_t iHash = WildMemoHash(pTame, strlen(pTame), iWildHash);
+
+	return (iHash & ~WILD_MEMO_FLAGS) | ((iHash & ~WILD_MEMO_FLAGS) == 0) << 2;
+}
+
+
+// Returns the bucket for a fingerprint, picked by its low bits above the 
+// flag bits.
+//
+inline WildMemoBucket *WildMemoBucketFor(WildMemo *pMemo, uint64_t iFingerprint)
+{
+	return &pMemo->pBuckets[(iFingerprint >> 2) & pMemo->iBucketMask];
+}
+
+
+// Looks up a fingerprint.  Returns 1 or 0 for a memoized result, or -1 if 
+// there's none.
+//
+int WildMemoFind(WildMemo *pMemo, uint64_t iFingerprint)
+{
+	WildMemoBucket  *pBucket = WildMemoBucketFor(pMemo, iFingerprint);
+	WildMemoCounter *pCounter = 
+	    &pMemo->rgCounters[(iFingerprint >> 58) % WILD_MEMO_COUNTERS];
+
+	for (int iEntry = 0; iEntry < WILD_MEMO_ENTRIES; iEntry++)
+	{
+		uint64_t iWord = pBucket->rgEntries[iEntry].load(
+		    std::memory_order_relaxed);
+
+		if ((iWord & ~WILD_MEMO_FLAGS) == iFingerprint)
+		{
+			if (!(iWord & WILD_MEMO_USED))
+			{
+				pBucket->rgEntries[iEntry].compare_exchange_strong(iWord, 
+				    iWord | WILD_MEMO_USED, std::memory_order_relaxed);
+			}
+
+			pCounter->cHits.fetch_add(1, std::memory_order_relaxed);
+			return (int) (iWord & WILD_MEMO_RESULT);
+		}
+	}
+
+	pCounter->cMisses.fetch_add(1, std::memory_order_relaxed);
+	return -1;
+}
+
+
+// Stores a result for a fingerprint, in an empty entry or else in place 
+// of the first entry under the clock hand that hasn't been used lately.
+//
+void WildMemoStore(WildMemo *pMemo, uint64_t iFingerprint, bool bResult)
+{
+	WildMemoBucket *pBucket = WildMemoBucketFor(pMemo, iFingerprint);
+	uint64_t        iNew = iFingerprint | (bResult ? WILD_MEMO_RESULT : 0);
+
+	for (int iEntry = 0; iEntry < WILD_MEMO_ENTRIES; iEntry++)
+	{
+		uint64_t iEmpty = 0;
+
+		if (pBucket->rgEntries[iEntry].compare_exchange_strong(iEmpty, iNew, 
+		        std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+
+	for (int iSweep = 0; iSweep < 2 * WILD_MEMO_ENTRIES; iSweep++)
+	{
+		int      iEntry = (int) (pBucket->iHand.fetch_add(1, 
+		    std::memory_order_relaxed) % WILD_MEMO_ENTRIES);
+		uint64_t iWord = pBucket->rgEntries[iEntry].load(
+		    std::memory_order_relaxed);
+
+		if (iWord & WILD_MEMO_USED)
+		{
+			pBucket->rgEntries[iEntry].compare_exchange_strong(iWord, 
+			    iWord & ~WILD_MEMO_USED, std::memory_order_relaxed);
+		}
+		else if (pBucket->rgEntries[iEntry].compare_exchange_strong(iWord, 
+		             iNew, std::memory_order_relaxed))
+		{
+			return;
+		}
+	}
+
+	return;
+}
+
+
+// Creates a memo occupying about cbMemo bytes: the largest power of 2 
+// number of buckets that fits, and at least one.  Returns NULL if memory 
+// for the memo can't be allocated.
+//
+WildMemo *FastWildMemoCreate(size_t cbMemo)
+{
+	size_t    cBuckets = 1;
+	size_t    cbBlock;
+	void     *pBlock;
+	WildMemo *pMemo;
+
+	while (cBuckets * 2 * sizeof(WildMemoBucket) <= cbMemo)
+	{
+		cBuckets *= 2;
+	}
+
+	cbBlock = sizeof(WildMemo) + cBuckets * sizeof(WildMemoBucket) + 63;
+	pBlock = calloc(1, cbBlock);
+
+	if (!pBlock)
+	{
+		return NULL;
+	}
+
+	// The memo and its buckets share one block, aligned to a cache line.
+	pMemo = new ((char *) pBlock + (-(uintptr_t) pBlock & 63)) WildMemo();
+	pMemo->pBuckets = (WildMemoBucket *) (pMemo + 1);
+	pMemo->iBucketMask = cBuckets - 1;
+	pMemo->pBlock = pBlock;
+	pMemo->cbBlock = cbBlock;
+	return pMemo;
+}
+
+
+// Matches a null-terminated UTF-8 tame string against a pattern, via the 
+// memoized result for the pair if there is one.  PERFORMS NO UTF-8 
+// VALIDATION.
+//
+bool FastWildMemoCompareUtf8(WildMemo *pMemo, char *pWild, char *pTame)
+{
+	uint64_t iFingerprint = WildMemoFingerprint(
+	    WildMemoHash(pWild, strlen(pWild), 0), pTame);
+	int      iResult = WildMemoFind(pMemo, iFingerprint);
+	bool     bResult;
+
+	if (iResult >= 0)
+	{
+		return iResult == 1;
+	}
+
+	bResult = FastWildCompareUtf8(pWild, pTame);
+	WildMemoStore(pMemo, iFingerprint, bResult);
+	return bResult;
+}
+
+
+// Orders tame strings in a batch by fingerprint.
+//
+int WildMemoTameOrder(const void *pLeft, const void *pRight)
+{
+	const WildMemoTame *pLeftTame = (const WildMemoTame *) pLeft;
+	const WildMemoTame *pRightTame = (const WildMemoTame *) pRight;
+
+	return pLeftTame->iFingerprint < pRightTame->iFingerprint ? -1 : 
+	       pLeftTame->iFingerprint > pRightTame->iFingerprint;
+}
+
+
+// Matches a batch of null-terminated UTF-8 tame strings against one 
+// pattern.  The tame strings are sorted by fingerprint, so that each 
+// distinct one is looked up once, and the ones not in the memo are matched 
+// together via FastWildCompareUtf8Batch().  If memory for sorting can't be 
+// allocated, each tame string is looked up on its own.
+//
+void FastWildMemoCompareUtf8Batch(WildMemo *pMemo, char *pWild, 
+                                  char **ppTame, bool *pResults, 
+                                  size_t cTame)
+{
+	WildMemoTame  rgLocalTames[WILD_MEMO_LOCAL];
+	char         *rgLocalMisses[WILD_MEMO_LOCAL];
+	size_t        rgLocalHeads[WILD_MEMO_LOCAL];
+	bool          rgLocalResults[WILD_MEMO_LOCAL];
+	WildMemoTame *pTames = rgLocalTames;
+	char        **ppMisses = rgLocalMisses;
+	size_t       *pHeads = rgLocalHeads;
+	bool         *pMissResults = rgLocalResults;
+	uint64_t      iWildHash = WildMemoHash(pWild, strlen(pWild), 0);
+	size_t        cMisses = 0;
+
+	if (cTame > WILD_MEMO_LOCAL)
+	{
+		pTames = (WildMemoTame *) malloc(cTame * (sizeof(WildMemoTame) + 
+		    sizeof(char *) + sizeof(size_t) + sizeof(bool)));
+
+		if (!pTames)
+		{
+			for (size_t iTame = 0; iTame < cTame; iTame++)
+			{
+				pResults[iTame] = 
+				    FastWildMemoCompareUtf8(pMemo, pWild, ppTame[iTame]);
+			}
+
+			return;
+		}
+
+		ppMisses = (char **) (pTames + cTame);
+		pHeads = (size_t *) (ppMisses + cTame);
+		pMissResults = (bool *) (pHeads + cTame);
+	}
+
+	for (size_t iTame = 0; iTame < cTame; iTame++)
+	{
+		pTames[iTame].iFingerprint = 
+		    WildMemoFingerprint(iWildHash, ppTame[iTame]);
+		pTames[iTame].iTame = iTame;
+	}
+
+	qsort(pTames, cTame, sizeof(WildMemoTame), WildMemoTameOrder);
+
+	// Looks up the first of each run of duplicates.
+	for (size_t iSorted = 0; iSorted < cTame; iSorted++)
+	{
+		int iResult;
+
+		if (iSorted && pTames[iSorted].iFingerprint == 
+		               pTames[iSorted - 1].iFingerprint)
+		{
+			continue;
+		}
+
+		iResult = WildMemoFind(pMemo, pTames[iSorted].iFingerprint);
+
+		if (iResult >= 0)
+		{
+			pResults[pTames[iSorted].iTame] = iResult == 1;
+		}
+		else
+		{
+			ppMisses[cMisses] = ppTame[pTames[iSorted].iTame];
+			pHeads[cMisses++] = iSorted;
+		}
+	}
+
+	FastWildCompareUtf8Batch(pWild, ppMisses, pMissResults, cMisses);
+
+	for (size_t iMiss = 0; iMiss < cMisses; iMiss++)
+	{
+		WildMemoTame *pTame = &pTames[pHeads[iMiss]];
+
+		pResults[pTame->iTame] = pMissResults[iMiss];
+		WildMemoStore(pMemo, pTame->iFingerprint, pMissResults[iMiss]);
+	}
+
+	// Copies each run's result to the rest of the run.
+	for (size_t iSorted = 1; iSorted < cTame; iSorted++)
+	{
+		if (pTames[iSorted].iFingerprint == pTames[iSorted - 1].iFingerprint)
+		{
+			pResults[pTames[iSorted].iTame] = 
+			    pResults[pTames[iSorted - 1].iTame];
+		}
+	}
+
+	if (pTames != rgLocalTames)
+	{
+		free(pTames);
+	}
+
+	return;
+}
+
+
+// Reports the hits and misses of a memo so far, and its size in bytes.
+//
+void FastWildMemoCounts(WildMemo *pMemo, uint64_t *pcHits, 
+                        uint64_t *pcMisses, size_t *pcbMemo)
+{
+	*pcHits = *pcMisses = 0;
+
+	for (size_t iCounter = 0; iCounter < WILD_MEMO_COUNTERS; iCounter++)
+	{
+		*pcHits += pMemo->rgCounters[iCounter].cHits.load();
+		*pcMisses += pMemo->rgCounters[iCounter].cMisses.load();
+	}
+
+	*pcbMemo = pMemo->cbBlock;
+	return;
+}
+
+
+// Releases a memo.
+//
+void FastWildMemoFree(WildMemo *pMemo)
+{
+	if (!pMemo)
+	{
+		return;
+	}
+
+	free(pMemo->pBlock);
+	return;
+}
@@ -0,0 +1,29 @@
+// A memo of match results, for callers that match the same pattern and 
+// tame string pairs over and over.
+//
+// A memo is created by FastWildMemoCreate() with a fixed size, in bytes, 
+// and can be shared by any number of threads.  FastWildMemoCompareUtf8() 
+// returns what FastWildCompareUtf8() would, looking the pair up first by 
+// a 64-bit fingerprint of the pattern and the tame string.  Results are 
+// trusted on a fingerprint match, so a result can be wrong when two pairs 
+// share a fingerprint, which is expected about once in 2^61 lookups.
+//
+// FastWildMemoCompareUtf8Batch() sets pResults[i] as 
+// FastWildMemoCompareUtf8(pMemo, pWild, ppTame[i]) would, looking up and 
+// matching each distinct tame string in the batch only once.
+//
+// FastWildMemoCounts() reports the hits and misses so far, and the bytes 
+// the memo occupies.
+#include <stddef.h>
+#include <stdint.h>
+
+struct WildMemo;
+
+WildMemo *FastWildMemoCreate(size_t cbMemo);
+bool FastWildMemoCompareUtf8(WildMemo *pMemo, char *pWild, char *pTame);
+void FastWildMemoCompareUtf8Batch(WildMemo *pMemo, char *pWild, 
+                                  char **ppTame, bool *pResults, 
+                                  size_t cTame);
+void FastWildMemoCounts(WildMemo *pMemo, uint64_t *pcHits, 
+                        uint64_t *pcMisses, size_t *pcbMemo);
+void FastWildMemoFree(WildMemo *pMemo);
@@ -0,0 +1,371 @@
+// Bit-parallel NFA matching of UTF-8-ready wildcard patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Each pattern is laid out as a run of positions in one long bit vector, 
+// in the manner of a Glushkov automaton: a start position, then one 
+// position per byte of literal content, one per '?', and one per run of 
+// '*' wildcards.  A set bit means that the pattern, up to and including 
+// that position, matches the tame string up to the current byte.  For 
+// each tame byte, every pattern advances at once, in the manner of the 
+// Shift-And algorithm:
+//
+//     D = ((D << 1) & Accepts[byte]) | (D & Loops[byte])
+//     D |= (D << 1) & Stars
+//
+// Accepts[byte] has the bits of the positions that can consume the byte.  
+// Loops[byte] has the bits of the '*' positions, which can consume any 
+// byte and stay put, along with the bits of the '?' positions if the byte 
+// continues a multiple-byte code point.  A '?' position consumes the lead 
+// byte of a code point, and then keeps its bit set through the rest of 
+// the code point.  The last step sets the bit of each '*' position that 
+// follows a set bit, since a '*' can match nothing.  A pattern matches if 
+// the bit of its last position is set at the end of the tame string.
+//
+// Start positions are set only before the first byte, which anchors each 
+// pattern at the start of the tame string.  Words of the bit vector that 
+// are clear, with nothing to shift into them, are skipped, and matching 
+// stops early once every bit is clear.
+//
+// Byte values with the same Accepts vector share one copy of it, so that 
+// the vectors for the bytes that actually appear in the patterns are few 
+// enough to stay in cache.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildcompare.h"
+#include "fastwildnfa.h"
+
+#define WILD_NFA_WORD  64        // Bits per word of the bit vector
+
+struct WildNfaSet
+{
+	size_t         cPatterns;
+	size_t         cWords;         // Words per bit vector
+	size_t         cClasses;       // Distinct Accepts vectors
+	unsigned char  rgClass[256];   // Accepts vector for each byte value
+	uint64_t      *pAccepts;       // One bit vector per class
+	uint64_t      *pStars;         // Bits of '*' positions
+	uint64_t      *pLoops;         // Bits of '*' and '?' positions
+	uint64_t      *pStart;         // Bits set before the first byte
+	size_t        *pLast;          // Last position of each pattern
+	char         **ppWild;         // Private copies of the patterns
+};
+
+
+// Sets a bit in a bit vector.
+//
+inline void WildNfaBitSet(uint64_t *pBits, size_t iBit)
+{
+	pBits[iBit / WILD_NFA_WORD] |= (uint64_t) 1 << (iBit % WILD_NFA_WORD);
+	return;
+}
+
+
+// Returns whether a bit is set in a bit vector.
+//
+inline bool WildNfaBitTest(uint64_t *pBits, size_t iBit)
+{
+	return (pBits[iBit / WILD_NFA_WORD] >> (iBit % WILD_NFA_WORD)) & 1;
+}
+
+
+// Counts the positions of a null-terminated pattern, including its start 
+// position.
+//
+size_t WildNfaPositions(char *pWild)
+{
+	size_t cPositions = 1;
+
+	for (; *pWild; pWild++)
+	{
+		cPositions += *pWild != '*' || pWild[1] != '*';
+	}
+
+	return cPositions;
+}
+
+
+// Collapses the Accepts vectors of byte values that have the same one.  
+// Continuation bytes keep classes of their own, since they alone loop on 
+// '?' positions.  The vectors are compacted in place.
+//
+void WildNfaClassify(WildNfaSet *pNfa)
+{
+	size_t cbVector = pNfa->cWords * sizeof(uint64_t);
+	bool   rgContinues[256];
+
+	for (int iByte = 0; iByte < 256; iByte++)
+	{
+		uint64_t *pAccepts = pNfa->pAccepts + iByte * pNfa->cWords;
+		bool      bContinues = (iByte & 0xC0) == 0x80;
+		size_t    iClass = 0;
+
+		while (iClass < pNfa->cClasses && 
+		       (rgContinues[iClass] != bContinues || 
+		        memcmp(pNfa->pAccepts + iClass * pNfa->cWords, pAccepts, 
+		               cbVector)))
+		{
+			iClass++;
+		}
+
+		if (iClass == pNfa->cClasses)
+		{
+			memmove(pNfa->pAccepts + iClass * pNfa->cWords, pAccepts, 
+			        cbVector);
+			rgContinues[iClass] = bContinues;
+			pNfa->cClasses++;
+		}
+
+		pNfa->rgClass[iByte] = (unsigned char) iClass;
+	}
+
+	return;
+}
+
+
+// Compiles an array of null-terminated UTF-8 patterns into one automaton.  
+// Returns NULL if memory for it can't be allocated.
+//
+WildNfaSet *FastWildNfaCompile(char **ppWild, size_t cWild)
+{
+	WildNfaSet *pNfa = (WildNfaSet *) calloc(1, sizeof(WildNfaSet));
+	size_t      cPositions = 0;
+	size_t      iPosition = 0;
+	size_t      cbWild = 0;
+	char       *pCopy;
+
+	if (!pNfa)
+	{
+		return NULL;
+	}
+
+	for (size_t iWild = 0; iWild < cWild; iWild++)
+	{
+		cPositions += WildNfaPositions(ppWild[iWild]);
+		cbWild += strlen(ppWild[iWild]) + 1;
+	}
+
+	pNfa->cPatterns = cWild;
+	pNfa->cWords = cPositions / WILD_NFA_WORD + 1;
+	pNfa->pAccepts = (uint64_t *) calloc(259 * pNfa->cWords, 
+	                                     sizeof(uint64_t));
+	pNfa->pLast = (size_t *) malloc((cWild + 1) * sizeof(size_t));
+	pNfa->ppWild = (char **) malloc((cWild + 1) * sizeof(char *) + cbWild);
+
+	if (!pNfa->pAccepts || !pNfa->pLast || !pNfa->ppWild)
+	{
+		FastWildNfaFree(pNfa);
+		return NULL;
+	}
+
+	pNfa->pStars = pNfa->pAccepts + 256 * pNfa->cWords;
+	pNfa->pLoops = pNfa->pStars + pNfa->cWords;
+	pNfa->pStart = pNfa->pLoops + pNfa->cWords;
+	pCopy = (char *) (pNfa->ppWild + cWild + 1);
+
+	for (size_t iWild = 0; iWild < cWild; iWild++)
+	{
+		pNfa->ppWild[iWild] = pCopy;
+		strcpy(pCopy, ppWild[iWild]);
+		pCopy += strlen(pCopy) + 1;
+	}
+
+	for (size_t iWild = 0; iWild < cWild; iWild++)
+	{
+		WildNfaBitSet(pNfa->pStart, iPosition);
+
+		for (unsigned char *pWild = (unsigned char *) ppWild[iWild]; 
+		     *pWild; pWild++)
+		{
+			if (*pWild == '*')
+			{
+				if (pWild[1] == '*')
+				{
+					continue;
+				}
+
+				WildNfaBitSet(pNfa->pStars, ++iPosition);
+
+				// A leading '*' matches before the first byte.
+				if (WildNfaBitTest(pNfa->pStart, iPosition - 1))
+				{
+					WildNfaBitSet(pNfa->pStart, iPosition);
+				}
+			}
+			else if (*pWild == '?')
+			{
+				WildNfaBitSet(pNfa->pLoops, ++iPosition);
+
+				// Any byte that isn't a continuation byte starts a code point.
+				for (int iByte = 1; iByte < 256; iByte++)
+				{
+					if ((iByte & 0xC0) != 0x80)
+					{
+						WildNfaBitSet(pNfa->pAccepts + iByte * pNfa->cWords, 
+						              iPosition);
+					}
+				}
+			}
+			else
+			{
+				WildNfaBitSet(pNfa->pAccepts + *pWild * pNfa->cWords, 
+				              ++iPosition);
+			}
+		}
+
+		pNfa->pLast[iWild] = iPosition++;
+	}
+
+	for (size_t iWord = 0; iWord < pNfa->cWords; iWord++)
+	{
+		pNfa->pLoops[iWord] |= pNfa->pStars[iWord];
+	}
+
+	WildNfaClassify(pNfa);
+	return pNfa;
+}
+
+
+// Returns the number of words of state that matching against an 
+// automaton takes.
+//
+size_t FastWildNfaStateWords(WildNfaSet *pNfa)
+{
+	return pNfa->cWords;
+}
+
+
+// Matches a null-terminated UTF-8 tame string against every pattern in an 
+// automaton, setting the bits of the patterns that match.  The state of 
+// the match is kept in pState, of FastWildNfaStateWords() words, which the 
+// caller can reuse from one call to the next.  If pState is NULL, the state 
+// is kept on the stack when it's small enough, or else allocated for the 
+// call.  PERFORMS NO UTF-8 VALIDATION.
+//
+void FastWildNfaCompareUtf8State(WildNfaSet *pNfa, char *pTame,
+                                 uint64_t *pMatches, uint64_t *pState)
+{
+	size_t    cWords = pNfa->cWords;
+	uint64_t  rgLocal[64];
+	uint64_t *pAllocated = NULL;
+	bool      bAny = true;
+
+	if (!pState && cWords <= 64)
+	{
+		pState = rgLocal;
+	}
+	else if (!pState)
+	{
+		pState = pAllocated = (uint64_t *) malloc(cWords * 8);
+	}
+
+	memset(pMatches, 0, (pNfa->cPatterns + 63) / 64 * sizeof(uint64_t));
+
+	if (!pState)
+	{
+		// Without room for the state, fall back to one pattern at a time.
+		for (size_t iPattern = 0; iPattern < pNfa->cPatterns; iPattern++)
+		{
+			if (FastWildCompareUtf8(pNfa->ppWild[iPattern], pTame))
+			{
+				WildNfaBitSet(pMatches, iPattern);
+			}
+		}
+
+		return;
+	}
+
+	memcpy(pState, pNfa->pStart, cWords * sizeof(uint64_t));
+
+	for (unsigned char *pByte = (unsigned char *) pTame; *pByte && bAny; 
+	     pByte++)
+	{
+		uint64_t *pAccepts = pNfa->pAccepts + pNfa->rgClass[*pByte] * cWords;
+		uint64_t *pLoops = (*pByte & 0xC0) == 0x80 ? pNfa->pLoops 
+		                                           : pNfa->pStars;
+		uint64_t  iCarry = 0;          // Top bit of the previous old word
+		uint64_t  iClosure = 0;        // Top bit of the previous new word
+
+		bAny = false;
+
+		for (size_t iWord = 0; iWord < cWords; iWord++)
+		{
+			uint64_t iOld = pState[iWord];
+			uint64_t iNew;
+
+			if (!(iOld | iCarry | iClosure))
+			{
+				continue;
+			}
+
+			// No '*' follows another, so the closure only needs the bits 
+			// set before it, which keeps the words independent.
+			iNew = (((iOld << 1) | iCarry) & pAccepts[iWord]) | 
+			       (iOld & pLoops[iWord]);
+			iCarry = iOld >> 63;
+			pState[iWord] = iNew | 
+			    (((iNew << 1) | iClosure) & pNfa->pStars[iWord]);
+			iClosure = iNew >> 63;
+			bAny |= pState[iWord] != 0;
+		}
+	}
+
+	for (size_t iPattern = 0; bAny && iPattern < pNfa->cPatterns; iPattern++)
+	{
+		if (WildNfaBitTest(pState, pNfa->pLast[iPattern]))
+		{
+			WildNfaBitSet(pMatches, iPattern);
+		}
+	}
+
+	free(pAllocated);
+	return;
+}
+
+
+// Matches a null-terminated UTF-8 tame string against every pattern in an 
+// automaton, setting the bits of the patterns that match.  PERFORMS NO 
+// UTF-8 VALIDATION.
+//
+void FastWildNfaCompareUtf8(WildNfaSet *pNfa, char *pTame,
+                            uint64_t *pMatches)
+{
+	FastWildNfaCompareUtf8State(pNfa, pTame, pMatches, NULL);
+	return;
+}
+
+
+// Releases an automaton.
+//
+void FastWildNfaFree(WildNfaSet *pNfa)
+{
+	if (!pNfa)
+	{
+		return;
+	}
+
+	free(pNfa->pAccepts);
+	free(pNfa->pLast);
+	free(pNfa->ppWild);
+	free(pNfa);
+	return;
+}
@@ -0,0 +1,32 @@
+// Bit-parallel NFA matching of one string against many UTF-8-ready 
+// wildcard patterns at once.
+//
+// The patterns are compiled together, by FastWildNfaCompile(), into one 
+// position automaton.  FastWildNfaCompareUtf8() sets bit (i % 64) of 
+// pMatches[i / 64] if pattern i matches the tame string, as 
+// FastWildCompareUtf8() would, and clears it otherwise.  The pMatches 
+// array needs (cWild + 63) / 64 words.
+//
+// Past 4,096 positions, the state of a match no longer fits on the stack, 
+// and FastWildNfaCompareUtf8() allocates it for each call.  Callers that 
+// match many strings against a large automaton can instead pass state of 
+// FastWildNfaStateWords() words, per thread, to 
+// FastWildNfaCompareUtf8State(), and reuse it from one call to the next.
+//
+// The automaton pays off for patterns anchored at the start, whose bits 
+// die out within the first few bytes.  Patterns that start with '*' keep 
+// their bits alive through every byte, and for fewer than about 1,000 
+// such patterns, or about 2,000 mixed with anchored ones, matching each 
+// compiled pattern from FastWildPatternCompile() in turn is faster.
+#include <stddef.h>
+#include <stdint.h>
+
+struct WildNfaSet;
+
+WildNfaSet *FastWildNfaCompile(char **ppWild, size_t cWild);
+size_t FastWildNfaStateWords(WildNfaSet *pNfa);
+void FastWildNfaCompareUtf8(WildNfaSet *pNfa, char *pTame,
+                            uint64_t *pMatches);
+void FastWildNfaCompareUtf8State(WildNfaSet *pNfa, char *pTame,
+                                 uint64_t *pMatches, uint64_t *pState);
+void FastWildNfaFree(WildNfaSet *pNfa);
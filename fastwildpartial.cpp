@@ -0,0 +1,266 @@
+// Partial matching of UTF-8-ready wildcard patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// A pattern is a series of parts separated by stars, each part made of 
+// literal content and '?' wildcards.  Until the first '*' is reached, the 
+// tame content must match the first part in place, so appended content 
+// can only extend that match or end it.  Once a '*' is reached, any tame 
+// string can yet match, since whatever's missing can be appended, and 
+// the question becomes whether it matches as is.
+//
+// That's settled the way FastWildCompareUtf8() settles it: each part 
+// between stars goes at the first place it matches after the part before 
+// it, and the last part, if the pattern doesn't end with '*', must match 
+// the end of the tame content.  Since appending content never changes 
+// where a part was placed, a state need only record which part is to be 
+// placed next and where the search for it stands, and a search that runs 
+// into the end of the content stops there, to pick up where it left off 
+// when more is appended.  The last part is never placed for good, since 
+// the end of the content moves, so it's checked against the end of the 
+// content each time, at a cost that depends only on its length.
+//
+#include <stddef.h>
+#include <string.h>
+#include "fastwildpartial.h"
+#include "fastwildutf8.h"
+
+
+// Compares a part of a pattern, up to the next '*' or the terminating 
+// null, with tame content that ends at pEnd, advancing *ppPart and *ppTame 
+// past what matches.  Returns WILD_PARTIAL_FULL_MATCH if the whole part 
+// matches, WILD_PARTIAL_POSSIBLE if the content ends first, or 
+// WILD_PARTIAL_NO.
+//
+inline int WildPartialCompare(char **ppPart, char **ppTame, char *pEnd)
+{
+	char *pPart = *ppPart;
+	char *pTame = *ppTame;
+	int   iResult = WILD_PARTIAL_FULL_MATCH;
+
+	while (*pPart && *pPart != '*')
+	{
+		if (pTame == pEnd)
+		{
+			iResult = WILD_PARTIAL_POSSIBLE;
+			break;
+		}
+		else if (*pPart == '?')
+		{
+			size_t cbCodePoint = CodePointBytes(*(unsigned char *) pTame);
+
+			if (cbCodePoint > (size_t) (pEnd - pTame))
+			{
+				iResult = WILD_PARTIAL_POSSIBLE;
+				break;
+			}
+
+			pTame += cbCodePoint;
+			pPart++;
+		}
+		else if (*pPart != *pTame)
+		{
+			return WILD_PARTIAL_NO;
+		}
+		else
+		{
+			pPart++;
+			pTame++;
+		}
+	}
+
+	*ppPart = pPart;
+	*ppTame = pTame;
+	return iResult;
+}
+
+
+// Checks whether the last part of a pattern, running from pPart to the 
+// terminating null, matches the end of tame content that runs from pFrom 
+// to pEnd.
+//
+inline bool WildPartialTail(char *pPart, char *pFrom, char *pEnd)
+{
+	char *pStart = pEnd;
+
+	for (char *pChar = pPart; *pChar; pChar++)
+	{
+		if ((*pChar & 0xC0) == 0x80)
+		{
+			continue;                  // Not the start of a code point
+		}
+		else if (pStart == pFrom)
+		{
+			return false;              // "*bcd" doesn't match "abc".
+		}
+
+		while (--pStart > pFrom && (*pStart & 0xC0) == 0x80)
+		{
+		}
+	}
+
+	return WildPartialCompare(&pPart, &pStart, pEnd) == 
+	       WILD_PARTIAL_FULL_MATCH && pStart == pEnd;
+}
+
+
+// Sets up the state for matching a pattern against a tame string that's 
+// empty so far.
+//
+void FastWildPartialStart(WildPartial *pState)
+{
+	pState->iWild = 0;
+	pState->iTame = 0;
+	pState->iSearch = 0;
+	pState->bFloating = false;
+	pState->bNoMatch = false;
+	return;
+}
+
+
+// Extends the matching of a pattern to cbTame bytes of tame content, of 
+// which the first pState->iTame bytes are the ones the state has already 
+// seen.  Returns WILD_PARTIAL_FULL_MATCH if the pattern matches the 
+// content, WILD_PARTIAL_POSSIBLE if it could match the content with more 
+// appended, or WILD_PARTIAL_NO.  PERFORMS NO UTF-8 VALIDATION.
+//
+int FastWildPartialExtendUtf8(char *pWild, WildPartial *pState, char *pTame, 
+                              size_t cbTame)
+{
+	char *pEnd = pTame + cbTame;
+	char *pPart = pWild + pState->iWild;
+	char *pAt = pTame + pState->iSearch;
+
+	pState->iTame = cbTame;
+
+	if (pState->bNoMatch)
+	{
+		return WILD_PARTIAL_NO;
+	}
+	else if (!pState->bFloating)
+	{
+		// The content ahead of the first '*' matches in place.
+		switch (WildPartialCompare(&pPart, &pAt, pEnd))
+		{
+		case WILD_PARTIAL_NO:
+			pState->bNoMatch = true;
+			return WILD_PARTIAL_NO;    // "abc" can't match "abd...".
+
+		case WILD_PARTIAL_POSSIBLE:
+			pState->iWild = pPart - pWild;
+			pState->iSearch = pAt - pTame;
+			return WILD_PARTIAL_POSSIBLE;
+
+		default:
+			pState->iWild = pPart - pWild;
+			pState->iSearch = pAt - pTame;
+
+			if (!*pPart)
+			{
+				pState->bNoMatch = pAt != pEnd;
+				return pAt == pEnd ? WILD_PARTIAL_FULL_MATCH 
+				                   : WILD_PARTIAL_NO;
+			}
+
+			pState->bFloating = true;
+			break;
+		}
+	}
+
+	for (;;)
+	{
+		char *pPartEnd;
+
+		while (*pPart == '*')
+		{
+			pPart++;
+		}
+
+		pState->iWild = pPart - pWild;
+
+		if (!*pPart)
+		{
+			return WILD_PARTIAL_FULL_MATCH;    // "ab*" matches "abcd".
+		}
+
+		for (pPartEnd = pPart; *pPartEnd && *pPartEnd != '*'; pPartEnd++)
+		{
+		}
+
+		if (!*pPartEnd)
+		{
+			return WildPartialTail(pPart, pAt, pEnd) ? 
+			       WILD_PARTIAL_FULL_MATCH : WILD_PARTIAL_POSSIBLE;
+		}
+
+		// A middle part goes at the first place it matches, so the 
+		// search picks up wherever it ran out of content before.
+		for (;;)
+		{
+			char *pMatchPart = pPart;
+			char *pMatchTame = pAt;
+			int   iResult;
+
+			if (*pPart != '?')
+			{
+				pAt = (char *) memchr(pAt, *pPart, pEnd - pAt);
+				pAt = pAt ? pAt : pEnd;
+				pMatchTame = pAt;
+			}
+
+			if (pAt == pEnd)
+			{
+				pState->iSearch = pAt - pTame;
+				return WILD_PARTIAL_POSSIBLE;
+			}
+
+			iResult = WildPartialCompare(&pMatchPart, &pMatchTame, pEnd);
+
+			if (iResult == WILD_PARTIAL_FULL_MATCH)
+			{
+				pPart = pMatchPart;
+				pAt = pMatchTame;
+				pState->iSearch = pAt - pTame;
+				break;
+			}
+			else if (iResult == WILD_PARTIAL_POSSIBLE)
+			{
+				pState->iSearch = pAt - pTame;
+				return WILD_PARTIAL_POSSIBLE;
+			}
+
+			pAt += CodePointBytes(*(unsigned char *) pAt);
+			pAt = pAt < pEnd ? pAt : pEnd;
+		}
+	}
+}
+
+
+// Matches a pattern against a null-terminated tame string, returning 
+// WILD_PARTIAL_FULL_MATCH if it matches, WILD_PARTIAL_POSSIBLE if it could 
+// match the string with more appended, or WILD_PARTIAL_NO.  PERFORMS NO 
+// UTF-8 VALIDATION.
+//
+int FastWildPartialUtf8(char *pWild, char *pTame)
+{
+	WildPartial state;
+
+	FastWildPartialStart(&state);
+	return FastWildPartialExtendUtf8(pWild, &state, pTame, strlen(pTame));
+}
@@ -0,0 +1,43 @@
+// Partial matching, for finding whether a tame string could yet match a 
+// UTF-8-ready wildcard pattern once more content is appended to it.
+//
+// FastWildPartialUtf8() returns WILD_PARTIAL_FULL_MATCH if the pattern 
+// matches the tame string, as FastWildCompareUtf8() would find, else 
+// WILD_PARTIAL_POSSIBLE if it would match the string with some content 
+// appended, else WILD_PARTIAL_NO, meaning that nothing appended to the 
+// string can make it match.  A walk of a tree of names can stop going 
+// deeper wherever a path gets WILD_PARTIAL_NO.
+//
+// The incremental form keeps a WildPartial state for a tame string that 
+// grows at the end, as a path does while a tree is walked.  The state is 
+// set up by FastWildPartialStart(), and FastWildPartialExtendUtf8() takes 
+// the whole tame content so far, whose first pState->iTame bytes must be 
+// the ones it was given before, and looks only at what's new, returning 
+// what FastWildPartialUtf8() would.  A state is a plain structure, so a 
+// tree walk can keep a copy per level and go back to it on returning from 
+// a subtree.  The tame content needn't be null-terminated.
+#if !defined(FASTWILDPARTIAL_H)
+#define FASTWILDPARTIAL_H
+
+#include <stddef.h>
+
+#define WILD_PARTIAL_NO          0   // No content appended can match
+#define WILD_PARTIAL_POSSIBLE    1   // Some content appended may match
+#define WILD_PARTIAL_FULL_MATCH  2   // Matches as is
+
+// How far the matching of a pattern against a growing tame string has got.
+struct WildPartial
+{
+	size_t iWild;         // Pattern content yet to be matched or placed
+	size_t iTame;         // Tame bytes looked at so far
+	size_t iSearch;       // Where the next part of the pattern is sought
+	bool   bFloating;     // Past the pattern's first '*'
+	bool   bNoMatch;
+};
+
+int FastWildPartialUtf8(char *pWild, char *pTame);
+void FastWildPartialStart(WildPartial *pState);
+int FastWildPartialExtendUtf8(char *pWild, WildPartial *pState, char *pTame, 
+                              size_t cbTame);
+
+#endif  // FASTWILDPARTIAL_H
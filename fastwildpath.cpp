@@ -0,0 +1,371 @@
+// Path-aware wildcard matching, for UTF-8-ready patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+//
+// A pattern is a series of segments separated by "**" components, each 
+// segment being a series of components that must match as many 
+// consecutive components of the path, since '*' and '?' don't match '/'.  
+// So every segment covers a fixed number of path components, and the 
+// segments can be placed the way FastWildCompareUtf8() places the parts 
+// between stars: the first at the start of the path, the last at its end, 
+// and each other one at the first place it matches after the one before 
+// it.  Placing a segment as early as it goes leaves the most room for the 
+// ones after it, so no placement is ever revisited.  The only way "**" 
+// differs from a star is that a trailing "**" must match something, even 
+// if only the empty component after a trailing '/'.
+//
+// Within a component, stars are matched with one place to fall back to, 
+// as FastWildCompareUtf8() matches them, with the end of the component 
+// standing in for the end of the string.  Components are delimited by 
+// looking for '/' and the terminating null 16 bytes at a time, where SSE2 
+// is available.  The loads are aligned, so though they read past the 
+// null, they never read into a page that the string doesn't reach.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "fastwildliteral.h"
+#include "fastwildpath.h"
+#include "fastwildutf8.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WILD_PATH_SSE2  1
+#endif
+
+#define WILD_PATH_CHUNK  16      // Bytes per aligned load
+
+
+// Finds the '/' or the terminating null that ends the component starting 
+// at pContent, in a path or a pattern.
+//
+inline char *WildPathSeparator(char *pContent)
+{
+#if defined(WILD_PATH_SSE2)
+	__m128i      vecSlash = _mm_set1_epi8('/');
+	__m128i      vecNull = _mm_setzero_si128();
+	size_t       iSkip = (uintptr_t) pContent & (WILD_PATH_CHUNK - 1);
+	char        *pChunk = pContent - iSkip;
+	unsigned int iEnds;
+
+	// The first load starts at or before pContent, so its lower bytes are 
+	// ignored.
+	for (;;)
+	{
+		__m128i vecChunk = _mm_load_si128((const __m128i *) pChunk);
+
+		iEnds = _mm_movemask_epi8(_mm_or_si128( 
+		    _mm_cmpeq_epi8(vecChunk, vecSlash), 
+		    _mm_cmpeq_epi8(vecChunk, vecNull))) >> iSkip << iSkip;
+
+		if (iEnds)
+		{
+			return pChunk + WildLowestBit(iEnds);
+		}
+
+		pChunk += WILD_PATH_CHUNK;
+		iSkip = 0;
+	}
+#else
+	while (*pContent && *pContent != '/')
+	{
+		pContent++;
+	}
+
+	return pContent;
+#endif  // WILD_PATH_SSE2
+}
+
+
+// Returns whether a component of a pattern, running from pWild to 
+// pWildEnd, is a "**" component, made of two or more stars and nothing 
+// else.
+//
+inline bool WildPathGlobstar(char *pWild, char *pWildEnd)
+{
+	if (pWildEnd - pWild < 2)
+	{
+		return false;
+	}
+
+	while (pWild < pWildEnd && *pWild == '*')
+	{
+		pWild++;
+	}
+
+	return pWild == pWildEnd;
+}
+
+
+// Finds the first place, at or after pTame and before pTameEnd, where the 
+// content after a star in a component of a pattern, at pWild, could start 
+// to match: pTame itself for a '?', else the next byte like its first.  
+// Returns NULL if there's no such place.
+//
+inline char *WildPathStarStop(char *pWild, char *pTame, char *pTameEnd)
+{
+	if (*pWild != '?')
+	{
+		while (pTame < pTameEnd && *pTame != *pWild)
+		{
+			pTame++;
+		}
+
+		if (pTame == pTameEnd)
+		{
+			return NULL;               // "*c" doesn't match "ab".
+		}
+	}
+
+	return pTame;
+}
+
+
+// Matches a component of a pattern, running from pWild to pWildEnd, with 
+// a component of a path, running from pTame to pTameEnd.  PERFORMS NO 
+// UTF-8 VALIDATION.
+//
+inline bool WildPathComponent(char *pWild, char *pWildEnd, char *pTame, 
+                              char *pTameEnd)
+{
+	char *pWildSequence = NULL;    // Just past the last '*' so far
+	char *pTameSequence = NULL;    // Where that star's match ends for now
+
+	for (;;)
+	{
+		if (pWild < pWildEnd && *pWild == '*')
+		{
+			while (++pWild < pWildEnd && *pWild == '*')
+			{
+			}
+
+			if (pWild == pWildEnd)
+			{
+				return true;           // "a*" matches "abc".
+			}
+
+			pWildSequence = pWild;
+			pTameSequence = WildPathStarStop(pWild, pTame, pTameEnd);
+
+			if (!pTameSequence)
+			{
+				return false;
+			}
+
+			pTame = pTameSequence;
+			continue;
+		}
+		else if (pTame == pTameEnd)
+		{
+			return pWild == pWildEnd;  // "ab?" doesn't match "ab".
+		}
+		else if (pWild < pWildEnd && *pWild == '?')
+		{
+			size_t cbCodePoint = CodePointBytes(*(unsigned char *) pTame);
+
+			pTame += cbCodePoint < (size_t) (pTameEnd - pTame) ? 
+			         cbCodePoint : pTameEnd - pTame;
+			pWild++;
+			continue;
+		}
+		else if (pWild < pWildEnd && *pWild == *pTame)
+		{
+			pWild++;
+			pTame++;
+			continue;
+		}
+		else if (!pWildSequence)
+		{
+			return false;              // "ab" doesn't match "ac".
+		}
+
+		// Let the last star match one more code point, and try again 
+		// from there.
+		size_t cbCodePoint = 
+		    CodePointBytes(*(unsigned char *) pTameSequence);
+
+		pTameSequence += cbCodePoint < (size_t) (pTameEnd - pTameSequence) ? 
+		                 cbCodePoint : pTameEnd - pTameSequence;
+		pTameSequence = WildPathStarStop(pWildSequence, pTameSequence, 
+		                                 pTameEnd);
+
+		if (!pTameSequence)
+		{
+			return false;
+		}
+
+		pWild = pWildSequence;
+		pTame = pTameSequence;
+	}
+}
+
+
+// Matches cComponents components of a pattern, starting at pWild, with as 
+// many consecutive components of a path, starting at *ppTame, and on a 
+// match moves *ppTame past them, to NULL if they end the path.  A NULL 
+// *ppTame has no components left.
+//
+inline bool WildPathSegment(char *pWild, size_t cComponents, char **ppTame)
+{
+	char *pTame = *ppTame;
+
+	for (size_t iComponent = 0; iComponent < cComponents; iComponent++)
+	{
+		char *pWildEnd = WildPathSeparator(pWild);
+		char *pTameEnd;
+
+		if (!pTame)
+		{
+			return false;              // "a/b" doesn't match "a".
+		}
+
+		pTameEnd = WildPathSeparator(pTame);
+
+		if (!WildPathComponent(pWild, pWildEnd, pTame, pTameEnd))
+		{
+			return false;
+		}
+
+		pWild = pWildEnd + 1;
+		pTame = *pTameEnd ? pTameEnd + 1 : NULL;
+	}
+
+	*ppTame = pTame;
+	return true;
+}
+
+
+// Matches a path against a pattern in which '*' and '?' don't match '/', 
+// while a "**" component matches any number of whole components, or, at 
+// the end of the pattern, anything at all after the '/' before it.  
+// Returns true on a match.  PERFORMS NO UTF-8 VALIDATION.
+//
+bool FastWildPathCompareUtf8(char *pWild, char *pTame)
+{
+	char *pAt = pTame;                 // The next path component, if any
+	bool  bAnchored = true;            // No "**" seen yet
+
+	for (;;)
+	{
+		char   *pSegment = pWild;
+		size_t  cComponents = 0;
+		bool    bGlobstar = false;
+
+		// The segment runs up to the next "**" component, or to the end of 
+		// the pattern, after which pWild is NULL.
+		while (pWild)
+		{
+			char *pWildEnd = WildPathSeparator(pWild);
+
+			bGlobstar = WildPathGlobstar(pWild, pWildEnd);
+			cComponents += !bGlobstar;
+			pWild = *pWildEnd ? pWildEnd + 1 : NULL;
+
+			if (bGlobstar)
+			{
+				break;
+			}
+		}
+
+		if (bAnchored)
+		{
+			// The first segment matches at the start of the path.
+			if (!WildPathSegment(pSegment, cComponents, &pAt))
+			{
+				return false;
+			}
+			else if (!bGlobstar)
+			{
+				return !pAt;           // "a/b" doesn't match "a/b/c".
+			}
+
+			bAnchored = false;
+		}
+		else if (bGlobstar)
+		{
+			// A segment between two "**" components matches wherever it 
+			// first can.  Its first component is tried against each path 
+			// component in turn, and the rest of it only where that matches.
+			char *pFirstEnd = WildPathSeparator(pSegment);
+
+			while (cComponents)
+			{
+				char *pTameEnd;
+				char *pTry;
+
+				if (!pAt)
+				{
+					return false;      // "**/a/**" doesn't match "b/c".
+				}
+
+				pTameEnd = WildPathSeparator(pAt);
+				pTry = *pTameEnd ? pTameEnd + 1 : NULL;
+
+				if (WildPathComponent(pSegment, pFirstEnd, pAt, pTameEnd) && 
+				    WildPathSegment(pFirstEnd + 1, cComponents - 1, &pTry))
+				{
+					pAt = pTry;
+					break;
+				}
+
+				pAt = *pTameEnd ? pTameEnd + 1 : NULL;
+			}
+		}
+		else
+		{
+			// The last segment matches the last components of the path, 
+			// which must start no earlier than pAt.
+			char *pStart;
+
+			if (!pAt)
+			{
+				return false;          // "a/**/b" doesn't match "a".
+			}
+
+			pStart = pAt + strlen(pAt);
+
+			for (size_t iComponent = 1;; iComponent++)
+			{
+				while (pStart > pAt && pStart[-1] != '/')
+				{
+					pStart--;
+				}
+
+				if (iComponent == cComponents)
+				{
+					break;
+				}
+				else if (pStart == pAt)
+				{
+					return false;      // "**/a/b" doesn't match "b".
+				}
+
+				pStart--;
+			}
+
+			return WildPathSegment(pSegment, cComponents, &pStart);
+		}
+
+		if (!pWild)
+		{
+			return pAt != NULL;        // "a/**" matches "a/b", not "a".
+		}
+	}
+}
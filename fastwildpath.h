@@ -0,0 +1,23 @@
+// Path-aware matching of UTF-8-ready wildcard patterns against file paths.
+//
+// FastWildPathCompareUtf8() matches as FastWildCompareUtf8() does, except 
+// that '*' and '?' never match '/', so that a pattern such as "src/*.c" 
+// matches "src/main.c" but not "src/net/http.c".  A component of the 
+// pattern that's made of two or more stars and nothing else, such as the 
+// "**" in "src/**/*.c", matches any number of whole components, including 
+// none, so that "src/**/*.c" matches "src/main.c" and "src/net/http.c".  A 
+// trailing "/**" matches everything inside a directory, so that "src/**" 
+// matches "src/main.c" and "src/net/" but not "src" itself, and a pattern 
+// of "**" matches every path.  Stars next to anything else in a component, 
+// as in "a**b", match as one '*' does.  These are the rules git follows 
+// for .gitignore files and glob pathspecs, which zsh and bash (with 
+// globstar set) share for "**/".
+//
+// Paths are matched as they are, without being split into components, and 
+// the pattern needs no compiling.
+#if !defined(FASTWILDPATH_H)
+#define FASTWILDPATH_H
+
+bool FastWildPathCompareUtf8(char *pWild, char *pTame);
+
+#endif  // FASTWILDPATH_H
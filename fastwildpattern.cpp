@@ -0,0 +1,1022 @@
+// Compiled UTF-8-ready wildcard patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// FastWildCompareUtf8() has nothing to analyze ahead of time: it takes in 
+// the pattern as it goes.  When a pattern is used many times, though, some 
+// analysis up front lets each match skip work that depends only on the 
+// pattern.
+//
+// A pattern without any '*' is a fixed shape: a run of literal bytes with 
+// '?' positions in it.  It's compiled into a byte template plus masks, and 
+// is then matched a 16-byte chunk at a time via masked vector compares. 
+// Each '?' is expected to cover a single-byte code point.  Where a tame 
+// string has a multiple-byte code point in a '?' position instead, the 
+// rest of the tame string is compared that many bytes further along, less 
+// one.  Only malformed UTF-8 in a '?' position leaves the match to 
+// FastWildCompareUtf8().
+//
+// Most patterns in practice have one of a few simple shapes: "literal", 
+// "literal*", "*literal", or "*literal*", maybe with '?' wildcards padding 
+// the literal.  Each of these shapes is recognized at compile time and 
+// matched via a template compare, a suffix compare at a known byte length, 
+// or a vectorized search for the literal.
+//
+// Any other pattern with a '*' in it is anchored at both ends: the content 
+// ahead of its first '*' has to match the start of the tame string, and the 
+// content after its last '*' has to match the end.  Both anchors are checked 
+// before anything else, the trailing one by stepping back from the end of 
+// the tame string, so that most mismatches are found without a scan.  Only 
+// then are the segments between stars searched for, in order, within the 
+// window between the anchors.  Since each segment is bounded by stars, the 
+// leftmost occurrence of each one is as good as any other.
+//
+// Every literal run in those segments has to be somewhere in the window.  
+// When there's more to the segments than one run of literal content, the 
+// run that's rarest in typical text, judged by a fixed byte-frequency 
+// model, is searched for first, and its absence rejects the tame string 
+// before the in-order search starts.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildcompare.h"
+#include "fastwildliteral.h"
+#include "fastwildarena.h"
+#include "fastwildpattern.h"
+#include "fastwildutf8.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define WILD_TEMPLATE_SSE2  1
+#endif
+
+#define WILD_CHUNK       16      // Bytes per template chunk
+#define WILD_PAGE        4096    // Smallest page size, for safe over-reads
+
+// Pattern shapes, where "?*" stands for any run of '*' and '?' wildcards 
+// that includes at least one '*', and "lit" stands for literal content.
+//
+#define WILD_SHAPE_GENERAL  0    // Anything else
+#define WILD_SHAPE_EXACT    1    // "l?t"   (the template, end anchored)
+#define WILD_SHAPE_PREFIX   2    // "l?t?*" (the template, then code points)
+#define WILD_SHAPE_SUFFIX   3    // "?*lit" or "?*lit?"
+#define WILD_SHAPE_INFIX    4    // "?*lit?*"
+#define WILD_SHAPE_MINIMUM  5    // "?*"    (a minimum number of code points)
+#define WILD_SHAPE_ANCHORED 6    // "l?t*s?g*...*l?t", any anchor maybe empty
+
+// Content between two stars of an anchored shape.
+//
+struct WildSegment
+{
+	uint32_t       iContent;       // Where the content starts in the pattern
+	uint32_t       cbContent;
+	bool           bQuestion;      // Whether the content includes any '?'
+};
+
+// Results of comparing a tame string against a star-free template.
+//
+#define WILD_TEMPLATE_NO_MATCH   0
+#define WILD_TEMPLATE_MATCH      1
+#define WILD_TEMPLATE_UNDECIDED  2
+#define WILD_TEMPLATE_CONTINUE   3   // No decision within the bytes compared
+
+// A compiled pattern is one block of memory: the WildPattern, then its 
+// segments, then its template, then its private copy of the pattern.  It 
+// refers to its parts by 32-bit offset from its own start, and to places 
+// in the pattern by byte position, rather than by pointer, so the block 
+// can be copied anywhere, as into a set image, and matched where it lands.
+//
+struct WildPattern
+{
+	uint32_t       iWild;          // Offset of the private copy of the pattern
+	uint32_t       cbWild;         // Length of the pattern in bytes
+	int            iShape;         // One of the WILD_SHAPE_* values
+	bool           bArena;         // Whether it's in an arena
+
+	// Literal content for a suffix or infix shape, with the number of code 
+	// points required before it and after it.  The number after a suffix 
+	// is exact, while the others are minimums.
+	uint32_t       iLiteral;
+	uint32_t       cbLiteral;
+	size_t         cBefore;
+	size_t         cAfter;
+
+	// Template for an exact or prefix shape, in WILD_CHUNK-byte chunks that 
+	// cover every template byte plus the terminating null.  The template 
+	// bytes are followed by as many care bytes, and then as many question 
+	// bytes.  A care byte is 0xFF where the tame byte has to equal the 
+	// template byte, and a question byte is 0xFF where the tame string has 
+	// to have a code point, of however many bytes.  The template byte is 0 
+	// where the care byte is 0.  For a prefix, the terminating null is a 
+	// don't-care.
+	uint32_t       cbTemplate;
+	uint32_t       cChunks;
+	uint32_t       iTemplate;
+
+	// Anchors and segments for an anchored shape.  The leading anchor is 
+	// the first cbLead bytes of the pattern.
+	uint32_t       cbLead;
+	uint32_t       iTrail;
+	uint32_t       cbTrail;
+	uint32_t       cSegments;
+	uint32_t       iSegments;
+
+	// The rarest literal run within the segments of an anchored shape, to 
+	// be searched for ahead of them, or 0 bytes if that's not worthwhile.
+	uint32_t       iRare;
+	uint32_t       cbRare;
+};
+
+
+// Returns the private copy of a compiled pattern's pattern.
+//
+inline char *WildPatternText(WildPattern *pPattern)
+{
+	return (char *) pPattern + pPattern->iWild;
+}
+
+
+// Returns the template bytes of a compiled pattern's template, which the 
+// care bytes and question bytes follow, each cChunks chunks further along.
+//
+inline unsigned char *WildPatternTemplate(WildPattern *pPattern)
+{
+	return (unsigned char *) pPattern + pPattern->iTemplate;
+}
+
+
+// Compares a null-terminated tame string against a star-free template, one 
+// byte at a time, over the template positions from iFirst to iLast.  The 
+// tame string is *pcbShift bytes further along than the template, for the 
+// multiple-byte code points that '?' positions have covered, and a '?' 
+// that covers one here adds the rest of it to *pcbShift.  Stops at the tame 
+// string's terminating null.  Returns WILD_TEMPLATE_UNDECIDED only for 
+// malformed UTF-8 in a '?' position, and WILD_TEMPLATE_CONTINUE if that 
+// range of the template doesn't include its end.
+//
+int WildTemplateCompareBytes(WildPattern *pPattern, char *pTame,
+                             size_t iFirst, size_t iLast, size_t *pcbShift)
+{
+	unsigned char *pTemplate = WildPatternTemplate(pPattern);
+	unsigned char *pCare = pTemplate + pPattern->cChunks * WILD_CHUNK;
+	unsigned char *pQuestion = pCare + pPattern->cChunks * WILD_CHUNK;
+
+	if (iLast > pPattern->cbTemplate)
+	{
+		iLast = pPattern->cbTemplate;
+	}
+
+	for (size_t iByte = iFirst; iByte <= iLast; iByte++)
+	{
+		unsigned char chTame;
+
+		if (!pQuestion[iByte] && !pCare[iByte])
+		{
+			continue;                            // Don't read past the end.
+		}
+
+		char *pAt = pTame + iByte + *pcbShift;
+
+		chTame = (unsigned char) *pAt;
+
+		if (pQuestion[iByte])
+		{
+			if (!chTame)
+			{
+				return WILD_TEMPLATE_NO_MATCH;   // "ab" doesn't match "ab?".
+			}
+			else if (chTame > 0x7F)
+			{
+				size_t cbCodePoint = CodePointBytes(chTame);
+
+				// Malformed UTF-8 is left to FastWildCompareUtf8(), which 
+				// steps over it in its own way.
+				if (chTame <= SINGLETON_LIMIT || chTame > 0xF7)
+				{
+					return WILD_TEMPLATE_UNDECIDED;
+				}
+
+				for (size_t iTrail = 1; iTrail < cbCodePoint; iTrail++)
+				{
+					if ((pAt[iTrail] & 0xC0) != 0x80)
+					{
+						return WILD_TEMPLATE_UNDECIDED;
+					}
+				}
+
+				*pcbShift += cbCodePoint - 1;
+			}
+		}
+		else if (pCare[iByte])
+		{
+			if (chTame != pTemplate[iByte])
+			{
+				return WILD_TEMPLATE_NO_MATCH;   // "abd" doesn't match "abc".
+			}
+			else if (!chTame)
+			{
+				return WILD_TEMPLATE_MATCH;      // The template's end.
+			}
+		}
+	}
+
+	return WILD_TEMPLATE_CONTINUE;
+}
+
+
+// Compares a null-terminated tame string against a star-free template, a 
+// chunk at a time.  Each chunk of the template is compared against the 
+// tame string as far along as the multiple-byte code points in earlier '?' 
+// positions have shifted it, and a chunk where a '?' covers a byte above 
+// 0x7F is finished a byte at a time.  Reads past the tame string's 
+// terminating null only within a chunk that doesn't cross into a further 
+// page.  Sets *pcbShift to the bytes the tame string ended up shifted by. 
+// Returns WILD_TEMPLATE_UNDECIDED only for malformed UTF-8 in a '?' 
+// position.  PERFORMS NO OTHER UTF-8 VALIDATION.
+//
+int WildTemplateCompare(WildPattern *pPattern, char *pTame, size_t *pcbShift)
+{
+	*pcbShift = 0;
+
+#if defined(WILD_TEMPLATE_SSE2)
+	unsigned char *pTemplate = WildPatternTemplate(pPattern);
+	unsigned char *pCare = pTemplate + pPattern->cChunks * WILD_CHUNK;
+	unsigned char *pQuestion = pCare + pPattern->cChunks * WILD_CHUNK;
+	__m128i        vecOne = _mm_set1_epi8(1);
+
+	for (size_t iChunk = 0; iChunk < pPattern->cChunks; iChunk++)
+	{
+		size_t iFirst = iChunk * WILD_CHUNK;
+		char *pChunk = pTame + iFirst + *pcbShift;
+
+		if (((uintptr_t) pChunk & (WILD_PAGE - 1)) > WILD_PAGE - WILD_CHUNK)
+		{
+			// The chunk could cross into a page that isn't mapped.
+			int iResult = WildTemplateCompareBytes(pPattern, pTame, iFirst,
+			                                       iFirst + WILD_CHUNK - 1, 
+			                                       pcbShift);
+
+			if (iResult != WILD_TEMPLATE_CONTINUE)
+			{
+				return iResult;
+			}
+
+			continue;
+		}
+
+		__m128i vecTame = _mm_loadu_si128((const __m128i *) pChunk);
+		__m128i vecCare = _mm_loadu_si128((const __m128i *) (pCare + iFirst));
+		__m128i vecTemplate = _mm_loadu_si128(
+		    (const __m128i *) (pTemplate + iFirst));
+		__m128i vecQuestion = _mm_loadu_si128(
+		    (const __m128i *) (pQuestion + iFirst));
+
+		// Literal mismatches, and '?' positions holding either the 
+		// terminating null or the lead byte of a multiple-byte code point.
+		unsigned int iMismatches = 0xFFFF & ~_mm_movemask_epi8(
+		    _mm_cmpeq_epi8(_mm_and_si128(vecTame, vecCare), vecTemplate));
+		unsigned int iQuestions = _mm_movemask_epi8(_mm_and_si128(
+		    _mm_cmpgt_epi8(vecOne, vecTame), vecQuestion));
+
+		if (!(iMismatches | iQuestions))
+		{
+			continue;
+		}
+
+		// Whatever comes first decides.  Up to there, every '?' has 
+		// covered a single byte, so the template is still in alignment.
+		unsigned int iFirstMismatch = iMismatches & (0u - iMismatches);
+		unsigned int iFirstQuestion = iQuestions & (0u - iQuestions);
+
+		if (!iFirstQuestion ||
+		    (iFirstMismatch && iFirstMismatch < iFirstQuestion))
+		{
+			return WILD_TEMPLATE_NO_MATCH;       // "abd" doesn't match "abc".
+		}
+
+		// From the '?', the rest of the chunk goes a byte at a time, which 
+		// shifts the tame string past any multiple-byte code point there.
+		int iResult = WildTemplateCompareBytes(pPattern, pTame, 
+		    iFirst + WildLowestBit(iQuestions), iFirst + WILD_CHUNK - 1, 
+		    pcbShift);
+
+		if (iResult != WILD_TEMPLATE_CONTINUE)
+		{
+			return iResult;
+		}
+	}
+
+	return WILD_TEMPLATE_MATCH;
+#else
+	int iResult = WildTemplateCompareBytes(pPattern, pTame, 0,
+	                                       pPattern->cbTemplate, pcbShift);
+
+	return iResult == WILD_TEMPLATE_CONTINUE ? WILD_TEMPLATE_MATCH : iResult;
+#endif  // WILD_TEMPLATE_SSE2
+}
+
+
+// Fills in the zeroed template of an exact or prefix shape, from the first 
+// cbTemplate bytes of the pattern.  For an exact shape, the tame string 
+// has to end right after them.
+//
+void WildTemplateBuild(WildPattern *pPattern)
+{
+	char          *pWild = WildPatternText(pPattern);
+	unsigned char *pTemplate = WildPatternTemplate(pPattern);
+	unsigned char *pCare = pTemplate + pPattern->cChunks * WILD_CHUNK;
+	unsigned char *pQuestion = pCare + pPattern->cChunks * WILD_CHUNK;
+
+	for (size_t iByte = 0; iByte < pPattern->cbTemplate; iByte++)
+	{
+		if (pWild[iByte] == '?')
+		{
+			pQuestion[iByte] = 0xFF;
+		}
+		else
+		{
+			pTemplate[iByte] = (unsigned char) pWild[iByte];
+			pCare[iByte] = 0xFF;
+		}
+	}
+
+	if (pPattern->iShape == WILD_SHAPE_EXACT)
+	{
+		pCare[pPattern->cbTemplate] = 0xFF;
+	}
+
+	return;
+}
+
+
+// Finds the first occurrence of a literal in a run of bytes of known
+// length.  Candidates are found 16 positions at a time, by comparing the
+// literal's first and last bytes against the run, and are then confirmed
+// via memcmp().  Returns NULL if there's no occurrence.
+//
+char *WildFindLiteral(char *pContent, size_t cbContent, char *pLiteral,
+                      size_t cbLiteral)
+{
+	size_t iAt = 0;
+
+	if (!cbLiteral)
+	{
+		return pContent;
+	}
+	else if (cbLiteral > cbContent)
+	{
+		return NULL;
+	}
+	else if (cbLiteral == 1)
+	{
+		return (char *) memchr(pContent, *pLiteral, cbContent);
+	}
+
+#if defined(WILD_TEMPLATE_SSE2)
+	__m128i vecFirst = _mm_set1_epi8(pLiteral[0]);
+	__m128i vecLast = _mm_set1_epi8(pLiteral[cbLiteral - 1]);
+
+	for (; iAt + cbLiteral - 1 + WILD_CHUNK <= cbContent; iAt += WILD_CHUNK)
+	{
+		__m128i vecAtFirst = _mm_loadu_si128(
+		    (const __m128i *) (pContent + iAt));
+		__m128i vecAtLast = _mm_loadu_si128(
+		    (const __m128i *) (pContent + iAt + cbLiteral - 1));
+		unsigned int iCandidates = _mm_movemask_epi8(_mm_and_si128(
+		    _mm_cmpeq_epi8(vecAtFirst, vecFirst),
+		    _mm_cmpeq_epi8(vecAtLast, vecLast)));
+
+		while (iCandidates)
+		{
+			char *pCandidate = pContent + iAt + WildLowestBit(iCandidates);
+
+			if (!memcmp(pCandidate + 1, pLiteral + 1, cbLiteral - 2))
+			{
+				return pCandidate;
+			}
+
+			iCandidates &= iCandidates - 1;
+		}
+	}
+#endif  // WILD_TEMPLATE_SSE2
+
+	for (; iAt + cbLiteral <= cbContent; iAt++)
+	{
+		if (pContent[iAt] == *pLiteral &&
+		    !memcmp(pContent + iAt + 1, pLiteral + 1, cbLiteral - 1))
+		{
+			return pContent + iAt;
+		}
+	}
+
+	return NULL;
+}
+
+
+// Given a pointer into a null-terminated UTF-8 string, advances it by
+// cCodePoints code points.  Returns false if the string ends first.
+// PERFORMS NO UTF-8 VALIDATION OTHER THAN NULL CHECKING.
+//
+inline bool WildSkipCodePoints(char **ppContent, size_t cCodePoints)
+{
+	while (cCodePoints--)
+	{
+		if (!**ppContent)
+		{
+			return false;
+		}
+
+		CodePointAdvance(ppContent);
+	}
+
+	return true;
+}
+
+
+// Picks the literal run, among the segments of an anchored shape, whose 
+// rarest byte is least common, preferring longer runs among equals.  
+// There's no need for a separate search when the segments amount to just 
+// one run of literal content.
+//
+void WildRareLiteralPick(WildPattern *pPattern)
+{
+	char        *pWild = WildPatternText(pPattern);
+	char        *pMiddle = pWild + pPattern->cbLead + 1;
+	WildSegment *pSegments = (WildSegment *) 
+	    ((char *) pPattern + pPattern->iSegments);
+	char        *pRare;
+	size_t       cbRare;
+
+	if (pPattern->cSegments == 1 && !pSegments->bQuestion)
+	{
+		return;
+	}
+
+	WildRarestRun(pMiddle, pWild + pPattern->iTrail - 1 - pMiddle, &pRare, 
+	              &cbRare);
+	pPattern->iRare = pRare ? (uint32_t) (pRare - pWild) : 0;
+	pPattern->cbRare = (uint32_t) cbRare;
+	return;
+}
+
+
+// Sets up an anchored shape: finds where a pattern that has at least one 
+// '*' splits into its leading anchor, its trailing anchor, and the 
+// nonempty segments between stars, and counts the segments.
+//
+void WildAnchorsAnalyze(WildPattern *pPattern, char *pWild)
+{
+	size_t iLastStar = pPattern->cbWild;
+
+	pPattern->iShape = WILD_SHAPE_ANCHORED;
+
+	while (pWild[pPattern->cbLead] != '*')
+	{
+		pPattern->cbLead++;
+	}
+
+	while (pWild[--iLastStar] != '*')
+	{
+		continue;
+	}
+
+	pPattern->iTrail = (uint32_t) iLastStar + 1;
+	pPattern->cbTrail = pPattern->cbWild - pPattern->iTrail;
+
+	for (size_t iByte = pPattern->cbLead; iByte < iLastStar; iByte++)
+	{
+		pPattern->cSegments += pWild[iByte] == '*' && pWild[iByte + 1] != '*';
+	}
+
+	return;
+}
+
+
+// Fills in the zeroed segments of an anchored shape, which 
+// WildAnchorsAnalyze() has counted, and picks its rarest literal run.
+//
+void WildSegmentsBuild(WildPattern *pPattern)
+{
+	char        *pWild = WildPatternText(pPattern);
+	WildSegment *pSegment = (WildSegment *) 
+	    ((char *) pPattern + pPattern->iSegments);
+	size_t       iStart = pPattern->cbLead + 1;
+
+	for (size_t iByte = iStart; iByte < pPattern->iTrail; iByte++)
+	{
+		if (pWild[iByte] == '*')
+		{
+			if (iByte > iStart)
+			{
+				pSegment->iContent = (uint32_t) iStart;
+				pSegment->cbContent = (uint32_t) (iByte - iStart);
+				pSegment->bQuestion = 
+				    memchr(pWild + iStart, '?', iByte - iStart) != NULL;
+				pSegment++;
+			}
+
+			iStart = iByte + 1;
+		}
+	}
+
+	WildRareLiteralPick(pPattern);
+	return;
+}
+
+
+// Sets the shape of a compiled pattern, along with whatever the shape's 
+// match routine needs, other than the template or segments, for which it 
+// only sets the sizes.
+//
+void WildShapeAnalyze(WildPattern *pPattern, char *pWild)
+{
+	size_t cbWild = pPattern->cbWild;
+	size_t iLiteral = 0;        // Start of content after leading wildcards
+	size_t iTrailing = cbWild;  // Start of any trailing wildcards
+	size_t cLeadingStars = 0;
+	size_t cLeadingQuestions = 0;
+	size_t cTrailingStars = 0;
+	size_t cTrailingQuestions = 0;
+
+	while (iLiteral < cbWild &&
+	       (pWild[iLiteral] == '*' || pWild[iLiteral] == '?'))
+	{
+		cLeadingStars += pWild[iLiteral] == '*';
+		cLeadingQuestions += pWild[iLiteral++] == '?';
+	}
+
+	if (iLiteral == cbWild)
+	{
+		if (cLeadingStars)
+		{
+			pPattern->iShape = WILD_SHAPE_MINIMUM;
+			pPattern->cBefore = cLeadingQuestions;
+			return;
+		}
+
+		pPattern->iShape = WILD_SHAPE_EXACT;
+		pPattern->cbTemplate = (uint32_t) cbWild;
+		return;
+	}
+
+	while (pWild[iTrailing - 1] == '*' || pWild[iTrailing - 1] == '?')
+	{
+		cTrailingStars += pWild[--iTrailing] == '*';
+		cTrailingQuestions += pWild[iTrailing] == '?';
+	}
+
+	// A '*' in the middle makes for a general shape.  So does a '?' in the
+	// middle, unless the pattern starts with the literal content.
+	for (size_t iByte = iLiteral; iByte < iTrailing; iByte++)
+	{
+		if (pWild[iByte] == '*' || (pWild[iByte] == '?' && cLeadingStars))
+		{
+			WildAnchorsAnalyze(pPattern, pWild);
+			return;
+		}
+	}
+
+	if (!cLeadingStars)
+	{
+		// Leading '?' wildcards, if any, are part of the template.
+		if (!cTrailingStars)
+		{
+			pPattern->iShape = WILD_SHAPE_EXACT;
+			pPattern->cbTemplate = (uint32_t) cbWild;
+			return;
+		}
+
+		pPattern->iShape = WILD_SHAPE_PREFIX;
+		pPattern->cAfter = cTrailingQuestions;
+		pPattern->cbTemplate = (uint32_t) iTrailing;
+		return;
+	}
+
+	pPattern->iShape = cTrailingStars ? WILD_SHAPE_INFIX : WILD_SHAPE_SUFFIX;
+	pPattern->iLiteral = (uint32_t) iLiteral;
+	pPattern->cbLiteral = (uint32_t) (iTrailing - iLiteral);
+	pPattern->cBefore = cLeadingQuestions;
+	pPattern->cAfter = cTrailingQuestions;
+	return;
+}
+
+
+// Matches a suffix shape.  The literal has to end exactly cAfter code
+// points before the end of the tame string, with at least cBefore code
+// points ahead of it.
+//
+bool WildSuffixCompare(WildPattern *pPattern, char *pTame)
+{
+	char  *pEnd = pTame + strlen(pTame);
+	char  *pLiteral;
+	size_t cBefore = 0;
+
+	for (size_t iAfter = 0; iAfter < pPattern->cAfter; iAfter++)
+	{
+		if (pEnd == pTame)
+		{
+			return false;              // "*a?" doesn't match "a".
+		}
+
+		// Step back to the lead byte of the preceding code point.
+		while (--pEnd > pTame && (*(unsigned char *) pEnd & 0xC0) == 0x80)
+		{
+			continue;
+		}
+	}
+
+	if ((size_t) (pEnd - pTame) < pPattern->cbLiteral)
+	{
+		return false;                  // "*abc" doesn't match "bc".
+	}
+
+	pLiteral = pEnd - pPattern->cbLiteral;
+
+	if (memcmp(pLiteral, WildPatternText(pPattern) + pPattern->iLiteral, 
+	           pPattern->cbLiteral))
+	{
+		return false;                  // "*abc" doesn't match "abd".
+	}
+
+	// Count just enough code points ahead of the literal.
+	for (char *pBefore = pTame;
+	     cBefore < pPattern->cBefore && pBefore < pLiteral; pBefore++)
+	{
+		cBefore += (*(unsigned char *) pBefore & 0xC0) != 0x80;
+	}
+
+	return cBefore >= pPattern->cBefore;
+}
+
+
+// Matches an infix shape.  The first occurrence of the literal that has at
+// least cBefore code points ahead of it has the most code points after it,
+// so it's the only one that needs checking for cAfter.
+//
+bool WildInfixCompare(WildPattern *pPattern, char *pTame)
+{
+	char *pSearch = pTame;
+	char *pFound;
+
+	if (!WildSkipCodePoints(&pSearch, pPattern->cBefore))
+	{
+		return false;                  // "*??a*" doesn't match "a".
+	}
+
+	pFound = WildFindLiteral(pSearch, strlen(pSearch), 
+	                         WildPatternText(pPattern) + pPattern->iLiteral,
+	                         pPattern->cbLiteral);
+
+	if (!pFound)
+	{
+		return false;                  // "*abc*" doesn't match "abd".
+	}
+
+	pFound += pPattern->cbLiteral;
+	return WildSkipCodePoints(&pFound, pPattern->cAfter);
+}
+
+
+// Matches content that may include '?' wildcards, but no '*', at the start 
+// of a run of tame code points ending at pEnd, or at the terminating null 
+// if pEnd is NULL.  Returns a pointer past the matched code points, or NULL 
+// if there's no match.
+//
+char *WildContentCompare(char *pContent, size_t cbContent, char *pTame, 
+                         char *pEnd)
+{
+	char *pContentEnd = pContent + cbContent;
+
+	while (pContent < pContentEnd)
+	{
+		if (pEnd ? pTame >= pEnd : !*pTame)
+		{
+			return NULL;
+		}
+		else if (*pContent == '?')
+		{
+			CodePointAdvance(&pTame);
+			pContent++;
+		}
+		else
+		{
+			char *pNext = pContent;
+
+			CodePointAdvance(&pNext);
+
+			// A terminating null mismatches, before any bytes past it.
+			while (pContent < pNext)
+			{
+				if (*pTame++ != *pContent++)
+				{
+					return NULL;
+				}
+			}
+
+			if (pEnd && pTame > pEnd)
+			{
+				return NULL;
+			}
+		}
+	}
+
+	return pTame;
+}
+
+
+// Finds the leftmost match of a segment of the pattern pWild within a run 
+// of tame code points ending at pEnd.  Returns a pointer past the match, 
+// or NULL if there's no match.
+//
+char *WildSegmentFind(WildSegment *pSegment, char *pWild, char *pTame, 
+                      char *pEnd)
+{
+	char *pContent = pWild + pSegment->iContent;
+
+	if (!pSegment->bQuestion)
+	{
+		char *pFound = WildFindLiteral(pTame, pEnd - pTame, pContent, 
+		                               pSegment->cbContent);
+
+		return pFound ? pFound + pSegment->cbContent : NULL;
+	}
+
+	while (pTame < pEnd)
+	{
+		char *pFound;
+
+		if (*pContent != '?')
+		{
+			// Skip ahead to the next candidate for the first byte.
+			pTame = (char *) memchr(pTame, *pContent, pEnd - pTame);
+
+			if (!pTame)
+			{
+				return NULL;
+			}
+		}
+
+		pFound = WildContentCompare(pContent, pSegment->cbContent, pTame, 
+		                            pEnd);
+
+		if (pFound)
+		{
+			return pFound;
+		}
+
+		CodePointAdvance(&pTame);
+	}
+
+	return NULL;
+}
+
+
+// Matches an anchored shape.  The leading anchor is checked first, then 
+// the trailing anchor backward from the end of the tame string, and then 
+// the segments between them.  The tame string's length isn't needed until 
+// the leading anchor has matched.
+//
+bool WildAnchoredCompare(WildPattern *pPattern, char *pTame)
+{
+	char        *pWild = WildPatternText(pPattern);
+	char        *pEnd;
+	char        *pTrailStart = pWild + pPattern->iTrail;
+	char        *pTrail = pTrailStart + pPattern->cbTrail;
+	WildSegment *pSegments = (WildSegment *) 
+	    ((char *) pPattern + pPattern->iSegments);
+
+	pTame = WildContentCompare(pWild, pPattern->cbLead, pTame, NULL);
+
+	if (!pTame)
+	{
+		return false;                  // "ab*c" doesn't match "ac".
+	}
+
+	pEnd = pTame + strlen(pTame);
+
+	while (pTrail > pTrailStart)
+	{
+		// Step back to the lead byte of the preceding pattern code point.
+		while ((*(unsigned char *) --pTrail & 0xC0) == 0x80)
+		{
+			continue;
+		}
+
+		if (pEnd == pTame)
+		{
+			return false;              // "a*bc" doesn't match "ac".
+		}
+		else if (*pTrail == '?')
+		{
+			while (--pEnd > pTame && (*(unsigned char *) pEnd & 0xC0) == 0x80)
+			{
+				continue;
+			}
+		}
+		else
+		{
+			char *pNext = pTrail;
+
+			CodePointAdvance(&pNext);
+
+			if (pEnd - pTame < pNext - pTrail)
+			{
+				return false;
+			}
+
+			pEnd -= pNext - pTrail;
+
+			if (memcmp(pEnd, pTrail, pNext - pTrail))
+			{
+				return false;          // "a*bc" doesn't match "abd".
+			}
+		}
+	}
+
+	if (pPattern->cbRare && 
+	    !WildFindLiteral(pTame, pEnd - pTame, pWild + pPattern->iRare, 
+	                     pPattern->cbRare))
+	{
+		return false;                  // "*a*qz*" doesn't match "abc".
+	}
+
+	for (size_t iSegment = 0; iSegment < pPattern->cSegments; iSegment++)
+	{
+		pTame = WildSegmentFind(&pSegments[iSegment], pWild, pTame, pEnd);
+
+		if (!pTame)
+		{
+			return false;              // "a*b*c" doesn't match "ac".
+		}
+	}
+
+	return true;
+}
+
+
+// Rounds a byte count within a compiled pattern up to whole chunks.
+//
+inline uint64_t WildPatternAlign(uint64_t cbPart)
+{
+	return (cbPart + WILD_CHUNK - 1) & ~(uint64_t) (WILD_CHUNK - 1);
+}
+
+
+// Compiles a null-terminated UTF-8 pattern into an arena, or onto the 
+// heap if pArena is NULL.  The pattern is analyzed before anything is 
+// allocated, so that it and all of its parts fit in one block.  A pattern 
+// in an arena is released along with the arena, and FastWildPatternFree() 
+// leaves it alone.  Returns NULL only if memory for the compiled pattern 
+// can't be allocated, or if it would take 4 GB or more.
+//
+WildPattern *FastWildPatternCompileArena(char *pWild, WildArena *pArena)
+{
+	WildPattern  analyzed;
+	WildPattern *pPattern;
+	size_t       cbWild = strlen(pWild);
+	uint64_t     iSegments = WildPatternAlign(sizeof(WildPattern));
+	uint64_t     iTemplate;
+	uint64_t     iText;
+
+	if (cbWild >= UINT32_MAX)
+	{
+		return NULL;
+	}
+
+	// Zeroed, padding and all, so that the block's bytes depend only on 
+	// the pattern.
+	memset(&analyzed, 0, sizeof(analyzed));
+	analyzed.cbWild = (uint32_t) cbWild;
+	WildShapeAnalyze(&analyzed, pWild);
+
+	if (analyzed.iShape == WILD_SHAPE_EXACT || 
+	    analyzed.iShape == WILD_SHAPE_PREFIX)
+	{
+		analyzed.cChunks = analyzed.cbTemplate / WILD_CHUNK + 1;
+	}
+
+	iTemplate = WildPatternAlign(iSegments + (uint64_t) analyzed.cSegments * 
+	                                         sizeof(WildSegment));
+	iText = iTemplate + 3 * (uint64_t) analyzed.cChunks * WILD_CHUNK;
+
+	if (iText + cbWild + 1 >= UINT32_MAX)
+	{
+		return NULL;
+	}
+
+	pPattern = (WildPattern *) (pArena 
+	    ? FastWildArenaAlloc(pArena, (size_t) iText + cbWild + 1, WILD_CHUNK) 
+	    : calloc(1, (size_t) iText + cbWild + 1));
+
+	if (!pPattern)
+	{
+		return NULL;
+	}
+
+	memcpy(pPattern, &analyzed, sizeof(analyzed));
+	pPattern->bArena = pArena != NULL;
+	pPattern->iSegments = (uint32_t) iSegments;
+	pPattern->iTemplate = (uint32_t) iTemplate;
+	pPattern->iWild = (uint32_t) iText;
+	memcpy(WildPatternText(pPattern), pWild, cbWild + 1);
+
+	if (pPattern->cChunks)
+	{
+		WildTemplateBuild(pPattern);
+	}
+	else if (pPattern->cSegments)
+	{
+		WildSegmentsBuild(pPattern);
+	}
+
+	return pPattern;
+}
+
+
+// Compiles a null-terminated UTF-8 pattern.  Returns NULL only if memory 
+// for the compiled pattern can't be allocated.
+//
+WildPattern *FastWildPatternCompile(char *pWild)
+{
+	return FastWildPatternCompileArena(pWild, NULL);
+}
+
+
+// Matches a null-terminated UTF-8 tame string against a compiled pattern.  
+// PERFORMS NO UTF-8 VALIDATION.
+//
+bool FastWildPatternCompareUtf8(WildPattern *pPattern, char *pTame)
+{
+	size_t cbShift;
+	int    iResult;
+
+	switch (pPattern->iShape)
+	{
+	case WILD_SHAPE_EXACT:
+		iResult = WildTemplateCompare(pPattern, pTame, &cbShift);
+
+		if (iResult != WILD_TEMPLATE_UNDECIDED)
+		{
+			return iResult == WILD_TEMPLATE_MATCH;
+		}
+
+		break;
+
+	case WILD_SHAPE_PREFIX:
+		iResult = WildTemplateCompare(pPattern, pTame, &cbShift);
+
+		if (iResult != WILD_TEMPLATE_UNDECIDED)
+		{
+			pTame += pPattern->cbTemplate + cbShift;
+			return iResult == WILD_TEMPLATE_MATCH && 
+			       WildSkipCodePoints(&pTame, pPattern->cAfter);
+		}
+
+		break;
+
+	case WILD_SHAPE_SUFFIX:
+		return WildSuffixCompare(pPattern, pTame);
+
+	case WILD_SHAPE_INFIX:
+		return WildInfixCompare(pPattern, pTame);
+
+	case WILD_SHAPE_MINIMUM:
+		return WildSkipCodePoints(&pTame, pPattern->cBefore);
+
+	case WILD_SHAPE_ANCHORED:
+		return WildAnchoredCompare(pPattern, pTame);
+	}
+
+	return FastWildCompareUtf8(WildPatternText(pPattern), pTame);
+}
+
+
+// Releases a compiled pattern, unless it's in an arena.
+//
+void FastWildPatternFree(WildPattern *pPattern)
+{
+	if (!pPattern || pPattern->bArena)
+	{
+		return;
+	}
+
+	free(pPattern);
+	return;
+}
@@ -0,0 +1,21 @@
+// Compiled UTF-8-ready wildcard patterns.
+//
+// A pattern is analyzed once, by FastWildPatternCompile(), and can then be 
+// matched any number of times.  Every compiled match returns the same 
+// result as FastWildCompareUtf8() for the original pattern.
+//
+// FastWildPatternCompileArena() compiles a pattern into an arena from 
+// FastWildArenaCreate(), packed together with the other patterns there, 
+// to be released along with the arena rather than on its own.
+//
+// A compiled pattern is one contiguous block that holds no pointers, only 
+// 32-bit offsets within itself, so its bytes can be copied anywhere, as 
+// into a set image, and matched where they land.
+
+struct WildArena;
+struct WildPattern;
+
+WildPattern *FastWildPatternCompile(char *pWild);
+WildPattern *FastWildPatternCompileArena(char *pWild, WildArena *pArena);
+bool FastWildPatternCompareUtf8(WildPattern *pPattern, char *pTame);
+void FastWildPatternFree(WildPattern *pPattern);
@@ -0,0 +1,330 @@
+// Canonical forms, containment, and pruning of UTF-8-ready wildcard patterns.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Containment is checked by matching the inner pattern, as though it were 
+// a tame string whose '?' and '*' wildcards were ordinary symbols, against 
+// the outer pattern.  An outer '*' matches any run of inner symbols, an 
+// outer '?' matches any inner symbol other than '*', and an outer literal 
+// code point matches only the same inner code point.  A successful match 
+// shows that whatever the inner pattern's wildcards match, the outer 
+// pattern's wildcards match too.  The match itself backtracks to the most 
+// recent outer '*' only, as FastWildCompareUtf8() does.
+//
+// Pruning considers the patterns from the most general to the most 
+// specific: by literal content, then by number of '?' wildcards, both 
+// ascending, then by number of '*' wildcards, descending.  A pattern that 
+// contains another has no more literal content, and if it has just as 
+// much, no more '?' wildcards.  So each pattern need only be checked 
+// against the patterns kept before it.  Those are hashed by the kind of 
+// their first and last symbols, since an outer pattern that starts or 
+// ends with a literal code point contains only inner patterns that start 
+// or end with the same byte.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildutf8.h"
+#include "fastwildprune.h"
+
+#define WILD_PRUNE_WILDCARD  256       // First or last symbol kind
+#define WILD_PRUNE_BUCKETS   4096
+
+// A pattern, while pruning.
+//
+struct WildPruneEntry
+{
+	char          *pWild;          // Canonical copy
+	size_t         cbLiteral;
+	size_t         cQuestions;
+	size_t         cStars;
+	uint32_t       iWild;
+	uint32_t       iNext;          // Next kept pattern in its bucket, + 1
+};
+
+
+// Rewrites a null-terminated pattern in place, so that each run of '*' 
+// and '?' wildcards becomes its '?' wildcards followed by at most one '*'.  
+// Returns the new length of the pattern.
+//
+size_t FastWildCanonicalize(char *pWild)
+{
+	char *pStart = pWild;
+	char *pOut = pWild;
+
+	while (*pWild)
+	{
+		if (*pWild == '*' || *pWild == '?')
+		{
+			bool bStar = false;
+
+			while (*pWild == '*' || *pWild == '?')
+			{
+				if (*pWild == '?')
+				{
+					*pOut++ = '?';
+				}
+
+				bStar |= *pWild++ == '*';
+			}
+
+			if (bStar)
+			{
+				*pOut++ = '*';
+			}
+		}
+		else
+		{
+			*pOut++ = *pWild++;
+		}
+	}
+
+	*pOut = '\0';
+	return pOut - pStart;
+}
+
+
+// Returns true if every string matched by the inner pattern is matched by 
+// the outer pattern, as far as can be shown by matching the inner pattern 
+// against the outer one symbol by symbol.  PERFORMS NO UTF-8 VALIDATION.
+//
+bool FastWildContains(char *pOuter, char *pInner)
+{
+	char *pOuterStar = NULL;       // Position after the last outer '*'
+	char *pInnerStar = NULL;       // Inner symbol that '*' matched up to
+
+	while (*pInner)
+	{
+		if (*pOuter == '*')
+		{
+			while (*++pOuter == '*')
+			{
+				continue;
+			}
+
+			if (!*pOuter)
+			{
+				return true;
+			}
+
+			pOuterStar = pOuter;
+			pInnerStar = pInner;
+			continue;
+		}
+		else if (*pOuter && *pInner != '*' && 
+		         (*pOuter == '?' || 
+		          (*pInner != '?' && CodePointCompare(pOuter, pInner))))
+		{
+			CodePointAdvance(&pOuter);
+			CodePointAdvance(&pInner);
+		}
+		else if (pOuterStar)
+		{
+			// Let the last outer '*' match one more inner symbol.
+			CodePointAdvance(&pInnerStar);
+			pInner = pInnerStar;
+			pOuter = pOuterStar;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	while (*pOuter == '*')
+	{
+		pOuter++;
+	}
+
+	return !*pOuter;
+}
+
+
+// Returns true if two patterns match the same strings, as far as can be 
+// shown by checking that each contains the other.
+//
+bool FastWildEquivalent(char *pWildA, char *pWildB)
+{
+	return FastWildContains(pWildA, pWildB) && 
+	       FastWildContains(pWildB, pWildA);
+}
+
+
+// Orders patterns from the most general to the most specific.
+//
+int WildPruneOrder(const void *pLeft, const void *pRight)
+{
+	const WildPruneEntry *pLeftEntry = (const WildPruneEntry *) pLeft;
+	const WildPruneEntry *pRightEntry = (const WildPruneEntry *) pRight;
+
+	if (pLeftEntry->cbLiteral != pRightEntry->cbLiteral)
+	{
+		return pLeftEntry->cbLiteral < pRightEntry->cbLiteral ? -1 : 1;
+	}
+	else if (pLeftEntry->cQuestions != pRightEntry->cQuestions)
+	{
+		return pLeftEntry->cQuestions < pRightEntry->cQuestions ? -1 : 1;
+	}
+	else if (pLeftEntry->cStars != pRightEntry->cStars)
+	{
+		return pLeftEntry->cStars > pRightEntry->cStars ? -1 : 1;
+	}
+
+	return pLeftEntry->iWild < pRightEntry->iWild ? -1 : 1;
+}
+
+
+// Orders kept pattern indexes.
+//
+int WildPruneIndexOrder(const void *pLeft, const void *pRight)
+{
+	size_t iLeft = *(const size_t *) pLeft;
+	size_t iRight = *(const size_t *) pRight;
+
+	return iLeft < iRight ? -1 : iLeft > iRight;
+}
+
+
+// Returns the kind of a canonical pattern's first or last symbol: its 
+// first or last byte if that's literal content, or WILD_PRUNE_WILDCARD.
+//
+inline int WildPruneKind(char *pWild, size_t cbWild, bool bLast)
+{
+	unsigned char chByte;
+
+	if (!cbWild)
+	{
+		return WILD_PRUNE_WILDCARD;
+	}
+
+	chByte = (unsigned char) pWild[bLast ? cbWild - 1 : 0];
+	return chByte == '*' || chByte == '?' ? WILD_PRUNE_WILDCARD : chByte;
+}
+
+
+// Returns the bucket of kept patterns with given first and last kinds.
+//
+inline uint32_t WildPruneBucket(int iFirst, int iLast)
+{
+	return (uint32_t) (iFirst * 257 + iLast) % WILD_PRUNE_BUCKETS;
+}
+
+
+// Drops every pattern that another pattern contains, keeping one of each 
+// set of equivalent patterns, and stores the indexes of the rest in 
+// ascending order.  If memory for the analysis can't be allocated, every 
+// pattern is kept.  Returns the number of patterns kept.
+//
+size_t FastWildPrune(char **ppWild, size_t cWild, size_t *piKept)
+{
+	WildPruneEntry *pEntries = 
+	    (WildPruneEntry *) malloc((cWild + 1) * sizeof(WildPruneEntry));
+	uint32_t       *pHeads = 
+	    (uint32_t *) calloc(WILD_PRUNE_BUCKETS, sizeof(uint32_t));
+	size_t          cbWilds = 0;
+	size_t          cKept = 0;
+	char           *pCopies;
+
+	for (size_t iWild = 0; iWild < cWild; iWild++)
+	{
+		cbWilds += strlen(ppWild[iWild]) + 1;
+	}
+
+	pCopies = (char *) malloc(cbWilds + 1);
+
+	if (!pEntries || !pHeads || !pCopies)
+	{
+		for (size_t iWild = 0; iWild < cWild; iWild++)
+		{
+			piKept[iWild] = iWild;
+		}
+
+		free(pEntries);
+		free(pHeads);
+		free(pCopies);
+		return cWild;
+	}
+
+	for (size_t iWild = 0, cbCopied = 0; iWild < cWild; iWild++)
+	{
+		WildPruneEntry *pEntry = &pEntries[iWild];
+
+		pEntry->pWild = pCopies + cbCopied;
+		strcpy(pEntry->pWild, ppWild[iWild]);
+		cbCopied += FastWildCanonicalize(pEntry->pWild) + 1;
+		pEntry->cbLiteral = pEntry->cQuestions = pEntry->cStars = 0;
+		pEntry->iWild = (uint32_t) iWild;
+		pEntry->iNext = 0;
+
+		for (char *pSymbol = pEntry->pWild; *pSymbol; pSymbol++)
+		{
+			pEntry->cQuestions += *pSymbol == '?';
+			pEntry->cStars += *pSymbol == '*';
+			pEntry->cbLiteral += *pSymbol != '?' && *pSymbol != '*';
+		}
+	}
+
+	qsort(pEntries, cWild, sizeof(WildPruneEntry), WildPruneOrder);
+
+	for (size_t iEntry = 0; iEntry < cWild; iEntry++)
+	{
+		WildPruneEntry *pEntry = &pEntries[iEntry];
+		size_t          cbWild = strlen(pEntry->pWild);
+		int             iFirst = WildPruneKind(pEntry->pWild, cbWild, false);
+		int             iLast = WildPruneKind(pEntry->pWild, cbWild, true);
+		bool            bContained = false;
+
+		// Outer patterns whose first and last kinds are compatible.
+		for (int iProbe = 0; iProbe < 4 && !bContained; iProbe++)
+		{
+			int iOuterFirst = iProbe & 1 ? WILD_PRUNE_WILDCARD : iFirst;
+			int iOuterLast = iProbe & 2 ? WILD_PRUNE_WILDCARD : iLast;
+
+			if ((iProbe & 1 && iFirst == WILD_PRUNE_WILDCARD) || 
+			    (iProbe & 2 && iLast == WILD_PRUNE_WILDCARD))
+			{
+				continue;          // Same bucket as an earlier probe
+			}
+
+			for (uint32_t iKept = 
+			         pHeads[WildPruneBucket(iOuterFirst, iOuterLast)]; 
+			     iKept && !bContained; iKept = pEntries[iKept - 1].iNext)
+			{
+				bContained = FastWildContains(pEntries[iKept - 1].pWild, 
+				                              pEntry->pWild);
+			}
+		}
+
+		if (!bContained)
+		{
+			uint32_t iBucket = WildPruneBucket(iFirst, iLast);
+
+			pEntry->iNext = pHeads[iBucket];
+			pHeads[iBucket] = (uint32_t) iEntry + 1;
+			piKept[cKept++] = pEntry->iWild;
+		}
+	}
+
+	qsort(piKept, cKept, sizeof(size_t), WildPruneIndexOrder);
+	free(pEntries);
+	free(pHeads);
+	free(pCopies);
+	return cKept;
+}
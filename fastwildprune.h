@@ -0,0 +1,27 @@
+// Canonical forms, containment, and pruning of UTF-8-ready wildcard 
+// patterns, for trimming large sets of patterns of which only whether any 
+// matches is of interest.
+//
+// FastWildCanonicalize() rewrites a pattern in place so that every run of 
+// wildcards is its '?' wildcards followed by at most one '*', which 
+// matches the same strings, and returns its new length.
+//
+// FastWildContains() returns true if every string that pInner matches is 
+// also matched by pOuter, and FastWildEquivalent() returns true if both 
+// match the same strings.  They're conservative: given canonical patterns 
+// they catch the containments that arise in practice, but some exotic 
+// ones (such as "?*" containing "*a") go undetected.  A containment that 
+// is reported always holds.
+//
+// FastWildPrune() stores, in ascending order, the indexes of the patterns 
+// that remain once every pattern contained by another is dropped, and 
+// returns their number.  Of equivalent patterns only one is kept.  A 
+// string matches one of the remaining patterns if and only if it matches 
+// one of the original patterns.  The piKept array needs room for one index 
+// per pattern.
+#include <stddef.h>
+
+size_t FastWildCanonicalize(char *pWild);
+bool FastWildContains(char *pOuter, char *pInner);
+bool FastWildEquivalent(char *pWildA, char *pWildB);
+size_t FastWildPrune(char **ppWild, size_t cWild, size_t *piKept);
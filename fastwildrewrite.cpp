@@ -0,0 +1,294 @@
+// Rewriting strings by wildcard pattern, for UTF-8-ready patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// A rule keeps its template as a list of pieces, each being a run of 
+// literal text followed by a reference to one wildcard's span, except that 
+// the last piece has no reference.  Rewriting a string takes one call to 
+// FastWildCaptureUtf8(), storing spans only as far as the highest wildcard 
+// the template refers to, and then one copy per literal run and per span, 
+// so the tame string is matched once and the template is never reparsed.
+//
+// The spans are kept on the stack, which is why a template can refer to no 
+// more than WILD_REWRITE_SPANS wildcards.
+//
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildrewrite.h"
+#include "fastwildcapture.h"
+
+#define WILD_REWRITE_SPANS  64           // Most wildcards a rule refers to
+#define WILD_REWRITE_NONE   ((size_t) -1)
+
+struct WildRewritePiece
+{
+	size_t iLiteral;      // Where the literal run starts in pText
+	size_t cbLiteral;
+	size_t iSpan;         // The wildcard that follows, or WILD_REWRITE_NONE
+};
+
+struct WildRewrite
+{
+	char             *pWild;        // Following the pieces
+	char             *pText;        // The template's literal text
+	size_t            cPieces;
+	size_t            cMaxSpans;    // Spans the template refers to
+	WildRewritePiece  rgPieces[1];
+};
+
+
+// Returns the length of what a rule makes of a tame string whose spans 
+// have been captured.
+//
+inline size_t WildRewriteLength(WildRewrite *pRewrite, WildSpan *pSpans)
+{
+	size_t cbResult = 0;
+
+	for (size_t iPiece = 0; iPiece < pRewrite->cPieces; iPiece++)
+	{
+		WildRewritePiece *pPiece = &pRewrite->rgPieces[iPiece];
+
+		cbResult += pPiece->cbLiteral;
+
+		if (pPiece->iSpan != WILD_REWRITE_NONE)
+		{
+			cbResult += pSpans[pPiece->iSpan].cbSpan;
+		}
+	}
+
+	return cbResult;
+}
+
+
+// Copies as much of cbFrom bytes to pOut, from offset *pcbResult on, as 
+// fits in cbOut bytes, and adds cbFrom to *pcbResult.
+//
+inline void WildRewriteAppend(char *pOut, size_t cbOut, size_t *pcbResult, 
+                              const char *pFrom, size_t cbFrom)
+{
+	if (*pcbResult < cbOut)
+	{
+		size_t cbRoom = cbOut - *pcbResult;
+
+		memcpy(pOut + *pcbResult, pFrom, cbFrom < cbRoom ? cbFrom : cbRoom);
+	}
+
+	*pcbResult += cbFrom;
+	return;
+}
+
+
+// Writes what a rule makes of a tame string whose spans have been 
+// captured, as much of it as fits in cbOut bytes along with a terminating 
+// null.  Returns its full length, not counting the null.
+//
+inline size_t WildRewriteFormat(WildRewrite *pRewrite, char *pTame, 
+                                WildSpan *pSpans, char *pOut, size_t cbOut)
+{
+	size_t cbResult = 0;
+
+	for (size_t iPiece = 0; iPiece < pRewrite->cPieces; iPiece++)
+	{
+		WildRewritePiece *pPiece = &pRewrite->rgPieces[iPiece];
+
+		WildRewriteAppend(pOut, cbOut, &cbResult, 
+		                  pRewrite->pText + pPiece->iLiteral, 
+		                  pPiece->cbLiteral);
+
+		if (pPiece->iSpan != WILD_REWRITE_NONE)
+		{
+			WildRewriteAppend(pOut, cbOut, &cbResult, 
+			                  pTame + pSpans[pPiece->iSpan].iOffset, 
+			                  pSpans[pPiece->iSpan].cbSpan);
+		}
+	}
+
+	if (cbResult < cbOut)
+	{
+		pOut[cbResult] = '\0';
+	}
+	else if (cbOut)
+	{
+		pOut[cbOut - 1] = '\0';        // Truncated
+	}
+
+	return cbResult;
+}
+
+
+// Prepares a rule that rewrites the tame strings a pattern matches by way 
+// of a template, in which "#n" stands for what the pattern's nth wildcard 
+// matched and "##" stands for '#'.  Returns NULL if the template refers to 
+// a wildcard the pattern lacks or past the WILD_REWRITE_SPANS limit, if it 
+// has any other '#' sequence, or if memory for the rule can't be allocated.
+//
+WildRewrite *FastWildRewriteCompile(char *pWild, char *pTemplate)
+{
+	WildRewrite      *pRewrite;
+	WildRewritePiece *pPiece;
+	size_t            cbWild = strlen(pWild) + 1;
+	size_t            cbTemplate = strlen(pTemplate) + 1;
+	size_t            cWildcards = 0;
+	size_t            cMaxPieces = 1;
+	size_t            cbText = 0;
+
+	for (char *pChar = pWild; *pChar; pChar++)
+	{
+		cWildcards += *pChar == '*' || *pChar == '?';
+	}
+
+	for (char *pChar = pTemplate; *pChar; pChar++)
+	{
+		cMaxPieces += *pChar == '#';
+	}
+
+	pRewrite = (WildRewrite *) malloc(sizeof(WildRewrite) + 
+	                                  cMaxPieces * sizeof(WildRewritePiece) + 
+	                                  cbWild + cbTemplate);
+
+	if (!pRewrite)
+	{
+		return NULL;
+	}
+
+	pRewrite->pWild = (char *) (pRewrite->rgPieces + cMaxPieces);
+	pRewrite->pText = pRewrite->pWild + cbWild;
+	pRewrite->cMaxSpans = 0;
+	memcpy(pRewrite->pWild, pWild, cbWild);
+	pPiece = pRewrite->rgPieces;
+	pPiece->iLiteral = 0;
+	pPiece->cbLiteral = 0;
+	pPiece->iSpan = WILD_REWRITE_NONE;
+
+	for (char *pChar = pTemplate; *pChar;)
+	{
+		size_t iWildcard = 0;
+
+		if (*pChar != '#' || pChar[1] == '#')
+		{
+			pRewrite->pText[cbText++] = *pChar;
+			pChar += 1 + (*pChar == '#');
+			pPiece->cbLiteral++;
+			continue;
+		}
+
+		// A number follows the '#', counting wildcards from 1.
+		while (*++pChar >= '0' && *pChar <= '9' && 
+		       iWildcard <= WILD_REWRITE_SPANS)
+		{
+			iWildcard = iWildcard * 10 + (*pChar - '0');
+		}
+
+		if (!iWildcard || iWildcard > cWildcards || 
+		    iWildcard > WILD_REWRITE_SPANS)
+		{
+			free(pRewrite);
+			return NULL;               // "#0", "#x" or "#99" for "*.txt"
+		}
+
+		pPiece->iSpan = iWildcard - 1;
+		pRewrite->cMaxSpans = iWildcard > pRewrite->cMaxSpans ? 
+		                      iWildcard : pRewrite->cMaxSpans;
+		pPiece++;
+		pPiece->iLiteral = cbText;
+		pPiece->cbLiteral = 0;
+		pPiece->iSpan = WILD_REWRITE_NONE;
+	}
+
+	pRewrite->pText[cbText] = '\0';
+	pRewrite->cPieces = pPiece - pRewrite->rgPieces + 1;
+	return pRewrite;
+}
+
+
+// Matches a rule's pattern against a tame string, and on a match writes 
+// the rewritten string to pOut, as much of it as fits in cbOut bytes along 
+// with a terminating null, and sets *pcbOut to its full length, unless 
+// pcbOut is NULL.  Returns whether the pattern matches.
+//
+bool FastWildRewriteUtf8(WildRewrite *pRewrite, char *pTame, char *pOut, 
+                         size_t cbOut, size_t *pcbOut)
+{
+	WildSpan rgSpans[WILD_REWRITE_SPANS];
+	size_t   cbResult;
+
+	if (!FastWildCaptureUtf8(pRewrite->pWild, pTame, rgSpans, 
+	                         pRewrite->cMaxSpans, NULL))
+	{
+		return false;
+	}
+
+	cbResult = WildRewriteFormat(pRewrite, pTame, rgSpans, pOut, cbOut);
+
+	if (pcbOut)
+	{
+		*pcbOut = cbResult;
+	}
+
+	return true;
+}
+
+
+// Rewrites each of cTame tame strings that a rule's pattern matches into 
+// an arena, setting ppOut[i] to the result, or to NULL if the pattern 
+// doesn't match.  Returns false if the arena runs out of room, in which 
+// case ppOut is NULL from the string that didn't fit on.
+//
+bool FastWildRewriteBatchUtf8(WildRewrite *pRewrite, char **ppTame, 
+                              size_t cTame, WildArena *pArena, char **ppOut)
+{
+	WildSpan rgSpans[WILD_REWRITE_SPANS];
+
+	for (size_t iTame = 0; iTame < cTame; iTame++)
+	{
+		size_t cbResult;
+
+		ppOut[iTame] = NULL;
+
+		if (!FastWildCaptureUtf8(pRewrite->pWild, ppTame[iTame], rgSpans, 
+		                         pRewrite->cMaxSpans, NULL))
+		{
+			continue;
+		}
+
+		cbResult = WildRewriteLength(pRewrite, rgSpans);
+		ppOut[iTame] = (char *) FastWildArenaAlloc(pArena, cbResult + 1, 1);
+
+		if (!ppOut[iTame])
+		{
+			memset(ppOut + iTame, 0, (cTame - iTame) * sizeof(char *));
+			return false;
+		}
+
+		WildRewriteFormat(pRewrite, ppTame[iTame], rgSpans, ppOut[iTame], 
+		                  cbResult + 1);
+	}
+
+	return true;
+}
+
+
+// Releases a rule.
+//
+void FastWildRewriteFree(WildRewrite *pRewrite)
+{
+	free(pRewrite);
+	return;
+}
@@ -0,0 +1,39 @@
+// Rewriting strings by wildcard pattern, for UTF-8-ready wildcard patterns.
+//
+// FastWildRewriteCompile() prepares a rule made of a pattern, such as 
+// "logs/*/*.txt", and a template for what the strings it matches become, 
+// such as "archive/#1/#2.txt.gz".  In the template, "#n" stands for what 
+// the pattern's nth wildcard matched, counting each '*' and '?' from 1, 
+// and "##" stands for '#'.  A template that refers to a wildcard the 
+// pattern doesn't have, or to a wildcard past the 64th, or that has a '#' 
+// followed by anything else, makes FastWildRewriteCompile() return NULL, 
+// as running out of memory does.  FastWildRewriteFree() releases a rule.
+//
+// FastWildRewriteUtf8() returns whether a rule's pattern matches a tame 
+// string, as FastWildCompareUtf8() would, and on a match writes the 
+// rewritten string to pOut, as much of it as fits in cbOut bytes along 
+// with a terminating null, and sets *pcbOut to its full length, not 
+// counting the null.  So the result fits whenever *pcbOut < cbOut.  
+// FastWildRewriteBatchUtf8() rewrites cTame strings, placing each result 
+// in an arena and setting ppOut[i] to it, or to NULL for a string the 
+// pattern doesn't match.  It returns false if the arena runs out of room, 
+// leaving ppOut NULL from the string that didn't fit on.
+//
+// Matching and rewriting are done in one pass over each tame string, and 
+// the template is parsed only once, by FastWildRewriteCompile().
+#if !defined(FASTWILDREWRITE_H)
+#define FASTWILDREWRITE_H
+
+#include <stddef.h>
+#include "fastwildarena.h"
+
+struct WildRewrite;
+
+WildRewrite *FastWildRewriteCompile(char *pWild, char *pTemplate);
+bool FastWildRewriteUtf8(WildRewrite *pRewrite, char *pTame, char *pOut, 
+                         size_t cbOut, size_t *pcbOut);
+bool FastWildRewriteBatchUtf8(WildRewrite *pRewrite, char **ppTame, 
+                              size_t cTame, WildArena *pArena, char **ppOut);
+void FastWildRewriteFree(WildRewrite *pRewrite);
+
+#endif  // FASTWILDREWRITE_H
@@ -0,0 +1,305 @@
+// Priority-ordered rule tables of UTF-8-ready wildcard patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// A rule table keeps its patterns in a pattern set, whose literal search 
+// picks out the rules that could match.  Only those are matched, via the 
+// set's own compiled patterns, in the order the table tries them, 
+// until one matches.  That order is by priority and then, among rules of 
+// equal priority, by an estimate of each rule's chance of matching per 
+// byte of pattern, as observed over earlier calls:
+//
+//     (matched + 1) / ((tried + 2) * (pattern length + 1))
+//
+// Until there are observations, shorter patterns are tried first.  Each 
+// reordering halves the counts, so that the order follows changes in the 
+// traffic.
+//
+// The order decides only how soon a match turns up, never which rule is 
+// returned.  Once a rule matches, the only candidates that could take its 
+// place are those of the same priority with lower indexes, so just those 
+// are tried after it, and the lowest-indexed match of the best priority 
+// is returned whatever the traffic has been.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildset.h"
+#include "fastwildrules.h"
+
+#define WILD_RULES_REORDER  4096     // Calls between reorderings
+#define WILD_RULES_INSERT   16       // Most candidates sorted by insertion
+
+struct WildRule
+{
+	int            iPriority;
+	uint32_t       cbCost;         // Pattern length, as a proxy for its cost
+	uint32_t       cTried;
+	uint32_t       cMatched;
+};
+
+struct WildRuleTable
+{
+	size_t          cRules;
+	WildRule       *pRules;
+	uint32_t       *pOrder;        // Rule indexes, in the order tried
+	uint32_t       *pRanks;        // Each rule's place in pOrder
+	WildPatternSet *pSet;
+	size_t         *pCandidates;
+	uint32_t        cCalls;
+};
+
+// A rule's place in the order, while reordering.
+//
+struct WildRuleRank
+{
+	int            iPriority;
+	double         fScore;
+	uint32_t       iRule;
+};
+
+
+// Orders rules by priority, then by descending score, then by index.
+//
+int WildRuleRankOrder(const void *pLeft, const void *pRight)
+{
+	const WildRuleRank *pLeftRank = (const WildRuleRank *) pLeft;
+	const WildRuleRank *pRightRank = (const WildRuleRank *) pRight;
+
+	if (pLeftRank->iPriority != pRightRank->iPriority)
+	{
+		return pLeftRank->iPriority < pRightRank->iPriority ? -1 : 1;
+	}
+	else if (pLeftRank->fScore != pRightRank->fScore)
+	{
+		return pLeftRank->fScore > pRightRank->fScore ? -1 : 1;
+	}
+
+	return pLeftRank->iRule < pRightRank->iRule ? -1 : 
+	       pLeftRank->iRule > pRightRank->iRule;
+}
+
+
+// Orders candidates by their places in the order rules are tried, for 
+// qsort() where there are too many to insert one at a time.
+//
+int WildRuleCandidateOrder(const void *pLeft, const void *pRight)
+{
+	size_t iLeft = *(const size_t *) pLeft;
+	size_t iRight = *(const size_t *) pRight;
+
+	return iLeft < iRight ? -1 : iLeft > iRight;
+}
+
+
+// Reorders the rules in a table according to their counts, and halves 
+// the counts.  Returns false, leaving the order as it was, if memory for 
+// sorting can't be allocated.
+//
+bool WildRulesRank(WildRuleTable *pTable)
+{
+	WildRuleRank *pRanks = 
+	    (WildRuleRank *) malloc((pTable->cRules + 1) * sizeof(WildRuleRank));
+
+	if (!pRanks)
+	{
+		return false;
+	}
+
+	for (size_t iRule = 0; iRule < pTable->cRules; iRule++)
+	{
+		WildRule *pRule = &pTable->pRules[iRule];
+
+		pRanks[iRule].iPriority = pRule->iPriority;
+		pRanks[iRule].fScore = (pRule->cMatched + 1.0) / 
+		    ((pRule->cTried + 2.0) * (pRule->cbCost + 1.0));
+		pRanks[iRule].iRule = (uint32_t) iRule;
+		pRule->cTried /= 2;
+		pRule->cMatched /= 2;
+	}
+
+	qsort(pRanks, pTable->cRules, sizeof(WildRuleRank), WildRuleRankOrder);
+
+	for (size_t iRank = 0; iRank < pTable->cRules; iRank++)
+	{
+		pTable->pOrder[iRank] = pRanks[iRank].iRule;
+		pTable->pRanks[pRanks[iRank].iRule] = (uint32_t) iRank;
+	}
+
+	free(pRanks);
+	return true;
+}
+
+
+// Compiles an array of null-terminated UTF-8 patterns, with an array of 
+// their priorities, into a rule table.  Returns NULL if memory for the 
+// table can't be allocated.
+//
+WildRuleTable *FastWildRulesCompile(char **ppWild, int *piPriorities, 
+                                    size_t cRules)
+{
+	WildRuleTable *pTable = (WildRuleTable *) calloc(1, sizeof(WildRuleTable));
+
+	if (!pTable)
+	{
+		return NULL;
+	}
+
+	pTable->pRules = (WildRule *) calloc(cRules + 1, sizeof(WildRule));
+	pTable->pOrder = (uint32_t *) malloc((cRules + 1) * sizeof(uint32_t));
+	pTable->pRanks = (uint32_t *) malloc((cRules + 1) * sizeof(uint32_t));
+	pTable->pCandidates = (size_t *) malloc((cRules + 1) * sizeof(size_t));
+	pTable->pSet = FastWildSetCompile(ppWild, cRules);
+
+	if (!pTable->pRules || !pTable->pOrder || !pTable->pRanks || 
+	    !pTable->pCandidates || !pTable->pSet)
+	{
+		FastWildRulesFree(pTable);
+		return NULL;
+	}
+
+	pTable->cRules = cRules;
+
+	for (size_t iRule = 0; iRule < cRules; iRule++)
+	{
+		WildRule *pRule = &pTable->pRules[iRule];
+
+		pRule->iPriority = piPriorities[iRule];
+		pRule->cbCost = (uint32_t) strlen(ppWild[iRule]);
+	}
+
+	if (!WildRulesRank(pTable))
+	{
+		FastWildRulesFree(pTable);
+		return NULL;
+	}
+
+	return pTable;
+}
+
+
+// Finds the first rule, in priority order and then in index order, whose 
+// pattern matches a null-terminated UTF-8 tame string.  Only the 
+// candidates that get past the pattern set's prefilter are matched, in the 
+// order the table tries them, and after the first that matches, only the 
+// candidates of its priority with lower indexes.  PERFORMS NO UTF-8 
+// VALIDATION.
+//
+size_t FastWildRulesMatchUtf8(WildRuleTable *pTable, char *pTame)
+{
+	size_t cCandidates = FastWildSetCandidatesUtf8(pTable->pSet, pTame, 
+	                                               pTable->pCandidates);
+	size_t iMatch = WILD_RULE_NONE;
+
+	size_t *pCandidates = pTable->pCandidates;
+
+	// The prefilter usually leaves a few candidates, which are put in rank 
+	// order as they're gathered, without a call per comparison.
+	if (cCandidates <= WILD_RULES_INSERT)
+	{
+		for (size_t iCandidate = 0; iCandidate < cCandidates; iCandidate++)
+		{
+			size_t iRank = pTable->pRanks[pCandidates[iCandidate]];
+			size_t iPlace = iCandidate;
+
+			while (iPlace && pCandidates[iPlace - 1] > iRank)
+			{
+				pCandidates[iPlace] = pCandidates[iPlace - 1];
+				iPlace--;
+			}
+
+			pCandidates[iPlace] = iRank;
+		}
+	}
+	else
+	{
+		for (size_t iCandidate = 0; iCandidate < cCandidates; iCandidate++)
+		{
+			pCandidates[iCandidate] = pTable->pRanks[pCandidates[iCandidate]];
+		}
+
+		qsort(pCandidates, cCandidates, sizeof(size_t), 
+		      WildRuleCandidateOrder);
+	}
+
+	for (size_t iCandidate = 0; iCandidate < cCandidates; iCandidate++)
+	{
+		uint32_t  iRule = pTable->pOrder[pCandidates[iCandidate]];
+		WildRule *pRule = &pTable->pRules[iRule];
+
+		if (iMatch != WILD_RULE_NONE)
+		{
+			if (pRule->iPriority != pTable->pRules[iMatch].iPriority)
+			{
+				break;                 // The rest come later by priority.
+			}
+			else if (iRule > iMatch)
+			{
+				continue;              // The match found comes first.
+			}
+		}
+
+		pRule->cTried++;
+
+		if (FastWildSetVerifyUtf8(pTable->pSet, iRule, pTame))
+		{
+			pRule->cMatched++;
+			iMatch = iRule;
+		}
+	}
+
+	if (++pTable->cCalls == WILD_RULES_REORDER)
+	{
+		FastWildRulesReorder(pTable);
+	}
+
+	return iMatch;
+}
+
+
+// Reorders the rules of equal priority in a table by the counts gathered 
+// so far.  If memory for that can't be allocated, the order stays as it 
+// was until the next try.
+//
+void FastWildRulesReorder(WildRuleTable *pTable)
+{
+	WildRulesRank(pTable);
+	pTable->cCalls = 0;
+	return;
+}
+
+
+// Releases a rule table, along with its pattern set.
+//
+void FastWildRulesFree(WildRuleTable *pTable)
+{
+	if (!pTable)
+	{
+		return;
+	}
+
+	FastWildSetFree(pTable->pSet);
+	free(pTable->pRules);
+	free(pTable->pOrder);
+	free(pTable->pRanks);
+	free(pTable->pCandidates);
+	free(pTable);
+	return;
+}
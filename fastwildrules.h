@@ -0,0 +1,28 @@
+// Priority-ordered rule tables of UTF-8-ready wildcard patterns, for 
+// finding the first rule that matches a string, as firewalls and access 
+// control lists do.
+//
+// A table is compiled once, by FastWildRulesCompile(), from an array of 
+// null-terminated patterns and an array of their priorities, lower values 
+// first.  FastWildRulesMatchUtf8() returns the index of the first 
+// matching rule with the lowest priority value, or WILD_RULE_NONE if no 
+// rule matches, so the same string always gets the same rule.  Among 
+// rules with the same priority, whichever is likeliest to match, for the 
+// least work, is tried first, as observed over previous calls, and once 
+// one matches, only the rules of that priority before it are still tried.  
+// The counts behind that ordering are updated by every call, so a table 
+// shouldn't be shared between threads.
+//
+// FastWildRulesReorder() applies the counts gathered so far, which 
+// otherwise happens every 4,096 calls.
+#include <stddef.h>
+
+#define WILD_RULE_NONE  ((size_t) -1)
+
+struct WildRuleTable;
+
+WildRuleTable *FastWildRulesCompile(char **ppWild, int *piPriorities, 
+                                    size_t cRules);
+size_t FastWildRulesMatchUtf8(WildRuleTable *pTable, char *pTame);
+void FastWildRulesReorder(WildRuleTable *pTable);
+void FastWildRulesFree(WildRuleTable *pTable);
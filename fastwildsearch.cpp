@@ -0,0 +1,240 @@
+// Finding matches of wildcard patterns within UTF-8 text in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Since a search pattern is treated as though it began and ended with 
+// '*', it's a series of parts separated by stars, each part made of 
+// literal content and '?' wildcards.  A match is found by placing the 
+// first part at the first place it matches, and each following part at 
+// the first place it matches after the part before it.  That yields the 
+// match that starts first and, of those, the one that ends first.
+//
+// If some part other than the first can't be placed, then the search is 
+// over, because placing the first part anywhere later could only push the 
+// following parts later still.  So a search never has to go back and try 
+// the first part elsewhere, and each part's scan of the text moves only 
+// forward, from one match to the next.
+//
+// A part is found by scanning for its rarest literal run, as judged by 
+// WildRarestRun(), via WildFindLiteral(), which compares 16 bytes at a 
+// time where SSE2 is available.  Each place the run turns up is backed up 
+// by the number of code points ahead of the run in the part, and the part 
+// is checked there.
+//
+#include <stddef.h>
+#include <string.h>
+#include "fastwildliteral.h"
+#include "fastwildsearch.h"
+#include "fastwildutf8.h"
+
+
+// Checks whether a part of a pattern, made of cbPart bytes of literal 
+// content and '?' wildcards, matches the text at pText, without reading 
+// at or past pEnd.  Returns the text that follows the part, or NULL if 
+// the part doesn't match there.
+//
+inline char *WildSearchCompare(char *pPart, size_t cbPart, char *pText, 
+                               char *pEnd)
+{
+	char *pPartEnd = pPart + cbPart;
+
+	while (pPart < pPartEnd)
+	{
+		if (*pPart == '?')
+		{
+			if (pText >= pEnd)
+			{
+				return NULL;
+			}
+
+			pText += CodePointBytes(*(unsigned char *) pText);
+			pPart++;
+
+			if (pText > pEnd)
+			{
+				return NULL;           // A code point cut off by pEnd
+			}
+		}
+		else
+		{
+			char  *pRun = pPart;
+			size_t cbRun;
+
+			while (pPart < pPartEnd && *pPart != '?')
+			{
+				pPart++;
+			}
+
+			cbRun = pPart - pRun;
+
+			if ((size_t) (pEnd - pText) < cbRun || memcmp(pText, pRun, cbRun))
+			{
+				return NULL;
+			}
+
+			pText += cbRun;
+		}
+	}
+
+	return pText;
+}
+
+
+// Finds the first place, from pText on, where a part of a pattern made of 
+// cbPart bytes of literal content and '?' wildcards matches text that ends 
+// at pEnd.  Returns the start of the match and sets *ppAfter to the text 
+// that follows it, or returns NULL if the part matches nowhere.
+//
+char *WildSearchPart(char *pPart, size_t cbPart, char *pText, char *pEnd, 
+                     char **ppAfter)
+{
+	char  *pRun;
+	size_t cbRun;
+	size_t cAhead = 0;
+
+	WildRarestRun(pPart, cbPart, &pRun, &cbRun);
+
+	if (!cbRun)
+	{
+		// A part with only '?' wildcards matches wherever there are 
+		// enough code points left.
+		*ppAfter = WildSearchCompare(pPart, cbPart, pText, pEnd);
+		return *ppAfter ? pText : NULL;
+	}
+
+	for (char *pChar = pPart; pChar < pRun; pChar++)
+	{
+		cAhead += (*pChar & 0xC0) != 0x80;
+	}
+
+	for (char *pScan = pText;;)
+	{
+		char *pFound = WildFindLiteral(pScan, pEnd - pScan, pRun, cbRun);
+		char *pStart;
+		size_t cBack;
+
+		if (!pFound)
+		{
+			return NULL;
+		}
+
+		// The code points ahead of the run must fit after pText.
+		for (pStart = pFound, cBack = cAhead; cBack && pStart > pText; 
+		     cBack--)
+		{
+			while (--pStart > pText && (*pStart & 0xC0) == 0x80)
+			{
+			}
+		}
+
+		if (!cBack)
+		{
+			*ppAfter = WildSearchCompare(pPart, cbPart, pStart, pEnd);
+
+			if (*ppAfter)
+			{
+				return pStart;
+			}
+		}
+
+		pScan = pFound + 1;
+	}
+}
+
+
+// Finds the matches of a pattern within cbText bytes of text, as though 
+// the pattern began and ended with '*', from offset iStart on, storing 
+// the span of each in pMatches, unless pMatches is NULL, for as many as 
+// cMaxMatches matches.  Returns the number of matches found, and sets 
+// *piNext to the offset to continue from, which is cbText if there are no 
+// more matches.  PERFORMS NO UTF-8 VALIDATION.
+//
+size_t FastWildSearchUtf8(char *pWild, char *pText, size_t cbText, 
+                          size_t iStart, WildSpan *pMatches, 
+                          size_t cMaxMatches, size_t *piNext)
+{
+	char  *pEnd = pText + cbText;
+	char  *pWildEnd;
+	char  *pAt = pText + iStart;
+	size_t cMatches = 0;
+
+	while (*pWild == '*')
+	{
+		pWild++;                       // "*abc" is searched for as "abc".
+	}
+
+	for (pWildEnd = pWild + strlen(pWild); 
+	     pWildEnd > pWild && pWildEnd[-1] == '*'; pWildEnd--)
+	{
+	}
+
+	*piNext = cbText;
+
+	if (pWild == pWildEnd)
+	{
+		return 0;
+	}
+
+	while (cMatches < cMaxMatches)
+	{
+		char *pPartEnd = (char *) memchr(pWild, '*', pWildEnd - pWild);
+		char *pStart;
+		char *pAfter;
+
+		pPartEnd = pPartEnd ? pPartEnd : pWildEnd;
+		pStart = WildSearchPart(pWild, pPartEnd - pWild, pAt, pEnd, &pAfter);
+
+		if (!pStart)
+		{
+			return cMatches;
+		}
+
+		// Each later part goes at the first place it fits.
+		for (char *pPart = pPartEnd; pPart < pWildEnd;)
+		{
+			while (*pPart == '*')
+			{
+				pPart++;
+			}
+
+			pPartEnd = (char *) memchr(pPart, '*', pWildEnd - pPart);
+			pPartEnd = pPartEnd ? pPartEnd : pWildEnd;
+
+			if (!WildSearchPart(pPart, pPartEnd - pPart, pAfter, pEnd, 
+			                    &pAfter))
+			{
+				return cMatches;       // Nothing later can match either.
+			}
+
+			pPart = pPartEnd;
+		}
+
+		if (pMatches)
+		{
+			pMatches[cMatches].iOffset = pStart - pText;
+			pMatches[cMatches].cbSpan = pAfter - pStart;
+		}
+
+		cMatches++;
+		pAt = pAfter;
+	}
+
+	*piNext = pAt - pText;
+	return cMatches;
+}
@@ -0,0 +1,33 @@
+// Finding every match of a wildcard pattern within a run of UTF-8 text.
+//
+// FastWildSearchUtf8() finds where a pattern matches within cbText bytes 
+// of text, as though the pattern began and ended with '*', from offset 
+// iStart on.  Stars at either end of the pattern are ignored.  Each match 
+// starts as early as it can and, of the matches starting there, ends as 
+// early as it can, and the next match is sought from where it ends, so 
+// matches never overlap.  The text needn't be null-terminated, and nulls 
+// within it are matched like any other byte.
+//
+// The start and length of each match are stored in pMatches, as WildSpan 
+// entries, for as many as cMaxMatches matches, and the number stored is 
+// returned.  pMatches may be NULL, to count matches.  *piNext is set to 
+// the offset to continue from, which is cbText once there's nothing more 
+// to find, so that a large buffer can be searched with a small pMatches 
+// array by calling again until *piNext reaches cbText.  A pattern that's 
+// empty, or has nothing but stars, matches nowhere.
+//
+// Text is scanned for the rarest literal run of each part of the pattern 
+// between stars via vector compares, and the scan for each part picks up 
+// after the last match rather than going back over the text, so the time 
+// taken grows linearly with the size of the text.
+#if !defined(FASTWILDSEARCH_H)
+#define FASTWILDSEARCH_H
+
+#include <stddef.h>
+#include "fastwildcapture.h"
+
+size_t FastWildSearchUtf8(char *pWild, char *pText, size_t cbText, 
+                          size_t iStart, WildSpan *pMatches, 
+                          size_t cMaxMatches, size_t *piNext);
+
+#endif  // FASTWILDSEARCH_H
@@ -0,0 +1,2482 @@
+// Sets of UTF-8-ready wildcard patterns in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+//
+// Matching one tame string against each of many patterns in turn costs 
+// time in proportion to the number of patterns, even though most of them 
+// don't match.  A pattern can only match a string that contains each run 
+// of literal content in the pattern, though.  So each pattern in a set 
+// contributes its rarest literal run to an Aho-Corasick automaton, which 
+// finds every one of those literals that's in the tame string in a single 
+// pass.  Only the patterns whose literals were found, plus any patterns 
+// that have no literal content, are then matched as compiled patterns.
+//
+// The automaton's states are numbered in breadth-first order, so that the 
+// transitions out of each state occupy a sorted run of a shared edge array.  
+// The root's transitions are kept in a table indexed by byte instead, since 
+// the root is where most bytes of most strings lead.
+//
+// For a few dozen distinct literals, a Teddy-style SIMD search beats the 
+// automaton's byte-at-a-time walk.  The literals are split among 8 buckets, 
+// and each of the last few bytes of a literal sets its bucket's bit in 
+// two 16-entry tables, indexed by the byte's low and high nibbles.  Via 
+// PSHUFB, 16 tame positions at a time are looked up in those tables, and 
+// the results are ANDed, so that a bit survives only where all of the 
+// trailing bytes of some literal in that bucket could be present.  Those 
+// candidates are confirmed via memcmp().  Sets of fewer than 5 patterns 
+// (13 where Teddy isn't available) are simply matched one pattern at a 
+// time.
+//
+// Large sets in practice are mostly made up of patterns with no wildcards 
+// other than a leading or trailing '*': exact names, "*.ext" suffixes, and 
+// "dir/*" prefixes.  A tame string's matches among those are found by 
+// hashing rather than matching.  Exact patterns, prefixes, and suffixes 
+// each go in a hash table keyed by their literal content, and the tame 
+// string is hashed once forward, with a lookup at each length where there 
+// are prefixes and at its full length, and once backward from its end, 
+// with a lookup at each length where there are suffixes.  The patterns in 
+// the hash tables need no matching at all.  Only the rest of the patterns 
+// go through a literal search.  Sets of 32 or fewer patterns skip the 
+// hashing, since the lookups cost more than Teddy or a few matches save.
+//
+// Every array of a set refers to other arrays by 32-bit index or offset 
+// rather than by pointer, so a set can be written out as an image, with 
+// each array in its own aligned section, and matched later right where 
+// the image is mapped.  Compiled patterns hold no pointers either, only 
+// offsets within themselves, so a mapped set matches them right in the 
+// image too, and worker processes that map the same file share them.
+//
+// Large sets are compiled on several threads.  Each pattern's shape and 
+// literal are found independently of the others, the literals are sorted 
+// in runs that are then merged, the hash indexes and the automaton are 
+// built at the same time from separate literals, and the patterns are 
+// compiled into places in the set's block that are laid out beforehand.  
+// Literals are sorted into a total order, and the layout depends only on 
+// the sizes of the compiled patterns, so the set comes out the same no 
+// matter how many threads compiled it.
+//
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include "fastwildarena.h"
+#include "fastwildcompare.h"
+#include "fastwildliteral.h"
+#include "fastwildpattern.h"
+#include "fastwildset.h"
+
+// Teddy needs SSSE3's PSHUFB.  Builds that don't assume SSSE3 compile it 
+// for SSSE3 anyway, where GCC or Clang can, and check the CPU at run time.
+//
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define WILD_SET_TEDDY  1
+#define WILD_TEDDY_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && \
+      (defined(__x86_64__) || defined(__i386__))
+#include <tmmintrin.h>
+#define WILD_SET_TEDDY  1
+#define WILD_TEDDY_CHECK 1
+#define WILD_TEDDY_TARGET __attribute__((target("ssse3")))
+#endif
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define WILD_SET_HITS    256     // Automaton hits gathered on the stack
+#define WILD_SET_LINEAR  8       // Most edges searched linearly, per state
+#define WILD_SET_EACH    13      // Fewest patterns for the automaton
+#define WILD_TEDDY_EACH  5       // Fewest patterns for Teddy
+#define WILD_SET_HASHED  33      // Fewest patterns for hashing by shape
+#define WILD_TEDDY_MAX   64      // Most distinct literals for Teddy
+#define WILD_TEDDY_AUTO  32      // Most for Teddy, when picked automatically
+#define WILD_TEDDY_BYTES 3       // Most trailing bytes looked up per literal
+#define WILD_CHUNK       16      // Bytes per vector
+#define WILD_SET_ALIGN   16      // Strictest alignment within a packed set
+#define WILD_SET_THREADS 64      // Most threads that compile a set
+#define WILD_SET_SHARE   16384   // Fewest patterns per thread, by default
+#define WILD_SET_RUN     4096    // Fewest literals sorted per thread
+
+// Shapes of patterns that are looked up by hashing in automatic sets.
+//
+#define WILD_SET_RESIDUAL  0     // Anything else
+#define WILD_SET_EXACT     1     // "literal"
+#define WILD_SET_PREFIX    2     // "literal*"
+#define WILD_SET_SUFFIX    3     // "*literal"
+#define WILD_SET_SHAPES    4
+
+// Sections of a set image, each WILD_IMAGE_ALIGN-aligned.  The hash index 
+// sections repeat for each hashed shape.
+//
+#define WILD_IMAGE_STATES           0
+#define WILD_IMAGE_EDGE_BYTES       1
+#define WILD_IMAGE_EDGE_TARGETS     2
+#define WILD_IMAGE_PATTERN_INDEXES  3
+#define WILD_IMAGE_RESIDUAL         4
+#define WILD_IMAGE_TEDDY_LITERALS   5
+#define WILD_IMAGE_TEDDY_BYTES      6
+#define WILD_IMAGE_PATTERN_OFFSETS  7
+#define WILD_IMAGE_PATTERN_BYTES    8
+#define WILD_IMAGE_INDEX_GROUPS     0   // Per shape, from WILD_IMAGE_INDEXES
+#define WILD_IMAGE_INDEX_SLOTS      1
+#define WILD_IMAGE_INDEX_LENGTHS    2
+#define WILD_IMAGE_INDEX_INDEXES    3
+#define WILD_IMAGE_INDEX_BYTES      4
+#define WILD_IMAGE_INDEX_SECTIONS   5
+#define WILD_IMAGE_INDEXES          9
+#define WILD_IMAGE_SECTIONS         (WILD_IMAGE_INDEXES + \
+                                     (WILD_SET_SHAPES - 1) * \
+                                     WILD_IMAGE_INDEX_SECTIONS)
+
+#define WILD_IMAGE_MAGIC    "FWILDSET"
+#define WILD_IMAGE_VERSION  3            // Compiled patterns, in place
+#define WILD_IMAGE_ORDER    0x01020304   // Reads otherwise if byte-swapped
+#define WILD_IMAGE_ALIGN    64
+#define WILD_IMAGE_CHECKED  32           // Header bytes ahead of the checksum
+
+// A pattern's literal run, while the automaton is built.
+//
+struct WildSetLiteral
+{
+	char          *pLiteral;
+	size_t         cbLiteral;
+	uint64_t       iLeading;       // Its first 8 bytes, as WildSetLeading()
+	uint32_t       iPattern;
+};
+
+struct WildSetState
+{
+	uint32_t       iFirstEdge;     // Transitions, in the edge arrays
+	uint32_t       cEdges;
+	uint32_t       iFail;          // Longest proper suffix state
+	uint32_t       iOutput;        // Nearest suffix state with patterns, or 0
+	uint32_t       iFirstPattern;  // Patterns whose literal ends here
+	uint32_t       cPatterns;
+};
+
+// A literal, as searched for by Teddy, and the automaton state where it 
+// ends, which stands for the literal's patterns.
+//
+struct WildTeddyLiteral
+{
+	uint32_t       iLiteral;       // Offset into the set's pTeddyBytes
+	uint32_t       cbLiteral;
+	uint32_t       iState;
+};
+
+// Hits gathered while scanning a tame string, as states with patterns.
+//
+struct WildSetHits
+{
+	uint32_t       rgLocal[WILD_SET_HITS];
+	uint32_t      *pHits;
+	size_t         cHits;
+	size_t         cMaxHits;
+	bool           bEvery;         // Whether to match every pattern instead
+};
+
+// Patterns that share literal content, in a hash table.
+//
+struct WildSetGroup
+{
+	uint64_t       iHash;
+	uint32_t       iLiteral;       // Offset into the index's pBytes
+	uint32_t       cbLiteral;
+	uint32_t       iFirst;         // Pattern indexes, in the index's pIndexes
+	uint32_t       cPatterns;
+};
+
+// A hash table of the patterns of one shape.  Suffixes are hashed from 
+// their last byte back.
+//
+struct WildSetIndex
+{
+	uint32_t       cGroups;
+	WildSetGroup  *pGroups;
+	uint32_t      *pSlots;         // Group number + 1, or 0 for an empty slot
+	uint32_t       iSlotMask;
+	uint32_t       cLengths;
+	uint32_t      *pLengths;       // Distinct literal lengths, ascending
+	uint32_t      *pIndexes;
+	uint32_t       cIndexes;
+	char          *pBytes;
+	size_t         cbBytes;
+};
+
+struct WildPatternSet
+{
+	size_t         cPatterns;
+	int            iStrategy;      // One of the WILD_SET_STRATEGY_* values
+
+	// Hash tables for the exact, prefix, and suffix shapes, and the 
+	// indexes of the patterns left over for the literal search.
+	WildSetIndex   rgIndexes[WILD_SET_SHAPES];
+	uint32_t       cResidual;
+	uint32_t      *pResidual;
+
+	// The automaton.  State 0 is the root, and a transition to state 0 
+	// stands for no transition.
+	uint32_t       cStates;
+	WildSetState  *pStates;
+	unsigned char *pEdgeBytes;
+	uint32_t      *pEdgeTargets;
+	uint32_t       rgRoot[256];
+
+	// Indexes of patterns, grouped by the state where their literal ends.  
+	// Patterns without literal content are grouped at the root.
+	uint32_t      *pPatternIndexes;
+
+	// Teddy nibble tables, one pair per fingerprint byte, the fingerprint 
+	// being each literal's last cbFingerprint bytes, and the literals in 
+	// each bucket, which start at rgBucketFirst[iBucket].
+	size_t         cbFingerprint;
+	unsigned char  rgTeddyLow[WILD_TEDDY_BYTES][WILD_CHUNK];
+	unsigned char  rgTeddyHigh[WILD_TEDDY_BYTES][WILD_CHUNK];
+	uint32_t       rgBucketFirst[9];
+	WildTeddyLiteral *pTeddyLiterals;
+	char          *pTeddyBytes;
+	size_t         cbTeddyBytes;
+
+	// Compiled patterns, at these offsets from pPatternBytes.  A compiled 
+	// set sits at the start of one block of cbBlock bytes, which holds the 
+	// arrays above and the compiled patterns as well, and which is released 
+	// along with the set unless it's in a caller's arena.  The patterns 
+	// take up the last cbPatternBytes of the block.
+	uint32_t      *pPatternOffsets;
+	char          *pPatternBytes;
+	size_t         cbPatternBytes;
+	size_t         cbBlock;
+	bool           bArena;
+
+	// For a set mapped from an image, the arrays above, the compiled 
+	// patterns among them, point into the image, and the block holds just 
+	// the set.
+	void          *pImage;
+	size_t         cbImage;
+	bool           bMapped;        // Whether pImage is a file mapping
+};
+
+
+// Returns the first 8 bytes of a literal as a big-endian number, padded 
+// with zeros.  Literals hold no null bytes, so these numbers order any 
+// two literals whose first 8 bytes differ the same way as their content 
+// does, without reaching into the patterns.
+//
+inline uint64_t WildSetLeading(char *pLiteral, size_t cbLiteral)
+{
+	uint64_t iLeading = 0;
+
+	for (size_t iByte = 0; iByte < sizeof(iLeading); iByte++)
+	{
+		iLeading = iLeading << 8 | 
+		           (iByte < cbLiteral ? (unsigned char) pLiteral[iByte] : 0);
+	}
+
+	return iLeading;
+}
+
+
+// Orders literals by content, with each literal ahead of any longer 
+// literal that it's a prefix of, and then by pattern index.
+//
+int WildSetLiteralOrder(const void *pLeft, const void *pRight)
+{
+	const WildSetLiteral *pL = (const WildSetLiteral *) pLeft;
+	const WildSetLiteral *pR = (const WildSetLiteral *) pRight;
+	size_t cbCommon = pL->cbLiteral < pR->cbLiteral ? pL->cbLiteral 
+	                                                : pR->cbLiteral;
+	int    iOrder;
+
+	if (pL->iLeading != pR->iLeading)
+	{
+		return pL->iLeading < pR->iLeading ? -1 : 1;
+	}
+
+	// The first 8 bytes match, as far as either literal goes.
+	iOrder = cbCommon > sizeof(pL->iLeading) 
+	         ? memcmp(pL->pLiteral + sizeof(pL->iLeading), 
+	                  pR->pLiteral + sizeof(pR->iLeading), 
+	                  cbCommon - sizeof(pL->iLeading)) 
+	         : 0;
+
+	if (iOrder)
+	{
+		return iOrder;
+	}
+	else if (pL->cbLiteral != pR->cbLiteral)
+	{
+		return pL->cbLiteral < pR->cbLiteral ? -1 : 1;
+	}
+
+	return pL->iPattern < pR->iPattern ? -1 : pL->iPattern > pR->iPattern;
+}
+
+
+// Runs fnRange(iFirst, iEnd) over cItems items, split into even ranges 
+// among as many as cThreads threads, including the calling thread, which 
+// takes the last range.  A range whose thread can't be started is run on 
+// the calling thread instead.  Returns once every range is done.
+//
+template <typename WildRange>
+void WildSetParallel(size_t cItems, unsigned cThreads, WildRange fnRange)
+{
+	std::thread rgThreads[WILD_SET_THREADS];
+
+	cThreads = cThreads < cItems ? cThreads : (unsigned) cItems;
+	cThreads = cThreads < WILD_SET_THREADS ? cThreads : WILD_SET_THREADS;
+
+	for (unsigned iThread = 0; iThread + 1 < cThreads; iThread++)
+	{
+		size_t iFirst = iThread * cItems / cThreads;
+		size_t iEnd = (iThread + 1) * cItems / cThreads;
+
+		try
+		{
+			rgThreads[iThread] = std::thread(fnRange, iFirst, iEnd);
+		}
+		catch (...)
+		{
+			fnRange(iFirst, iEnd);
+		}
+	}
+
+	fnRange(cThreads > 1 ? (cThreads - 1) * cItems / cThreads : 0, cItems);
+
+	for (unsigned iThread = 0; iThread + 1 < cThreads; iThread++)
+	{
+		if (rgThreads[iThread].joinable())
+		{
+			rgThreads[iThread].join();
+		}
+	}
+
+	return;
+}
+
+
+// Merges two sorted runs of literals into pMerged.
+//
+void WildSetMerge(WildSetLiteral *pLeft, size_t cLeft, 
+                  WildSetLiteral *pRight, size_t cRight, 
+                  WildSetLiteral *pMerged)
+{
+	while (cLeft && cRight)
+	{
+		if (WildSetLiteralOrder(pRight, pLeft) < 0)
+		{
+			*pMerged++ = *pRight++;
+			cRight--;
+		}
+		else
+		{
+			*pMerged++ = *pLeft++;
+			cLeft--;
+		}
+	}
+
+	memcpy(pMerged, cLeft ? pLeft : pRight, 
+	       (cLeft ? cLeft : cRight) * sizeof(WildSetLiteral));
+	return;
+}
+
+
+// Sorts literals by WildSetLiteralOrder().  On more than one thread, runs 
+// of them are sorted at the same time, and then merged pairwise, with 
+// the pairs also merged at the same time.  No two literals compare equal, 
+// so the result doesn't depend on how they were split into runs.  Falls 
+// back to one thread if memory for merging can't be allocated.
+//
+void WildSetSort(WildSetLiteral *pLiterals, size_t cLiterals, 
+                 unsigned cThreads)
+{
+	size_t          rgRuns[WILD_SET_THREADS + 1];
+	size_t          cRuns = cLiterals / WILD_SET_RUN;
+	WildSetLiteral *pFrom = pLiterals;
+	WildSetLiteral *pTo;
+
+	cRuns = cRuns < cThreads ? cRuns : cThreads;
+	cRuns = cRuns < WILD_SET_THREADS ? cRuns : WILD_SET_THREADS;
+	pTo = cRuns > 1 ? (WildSetLiteral *) malloc(cLiterals * 
+	                                            sizeof(WildSetLiteral)) 
+	                : NULL;
+
+	if (!pTo)
+	{
+		qsort(pLiterals, cLiterals, sizeof(WildSetLiteral), 
+		      WildSetLiteralOrder);
+		return;
+	}
+
+	for (size_t iRun = 0; iRun <= cRuns; iRun++)
+	{
+		rgRuns[iRun] = iRun * cLiterals / cRuns;
+	}
+
+	WildSetParallel(cRuns, (unsigned) cRuns, [&](size_t iFirst, size_t iEnd) {
+		for (size_t iRun = iFirst; iRun < iEnd; iRun++)
+		{
+			qsort(pLiterals + rgRuns[iRun], rgRuns[iRun + 1] - rgRuns[iRun], 
+			      sizeof(WildSetLiteral), WildSetLiteralOrder);
+		}
+	});
+
+	while (cRuns > 1)
+	{
+		size_t          cMerges = (cRuns + 1) / 2;
+		WildSetLiteral *pMerged = pTo;
+
+		WildSetParallel(cMerges, (unsigned) cMerges, 
+		                [&](size_t iFirst, size_t iEnd) {
+			for (size_t iMerge = iFirst; iMerge < iEnd; iMerge++)
+			{
+				size_t iLeft = rgRuns[2 * iMerge];
+				size_t iRight = rgRuns[2 * iMerge + 1];
+				size_t iLast = 2 * iMerge + 2 <= cRuns 
+				               ? rgRuns[2 * iMerge + 2] : iRight;
+
+				WildSetMerge(pFrom + iLeft, iRight - iLeft, pFrom + iRight, 
+				             iLast - iRight, pMerged + iLeft);
+			}
+		});
+
+		for (size_t iRun = 0; iRun <= cMerges; iRun++)
+		{
+			rgRuns[iRun] = rgRuns[2 * iRun < cRuns ? 2 * iRun : cRuns];
+		}
+
+		cRuns = cMerges;
+		pTo = pFrom;
+		pFrom = pMerged;
+	}
+
+	if (pFrom != pLiterals)
+	{
+		memcpy(pLiterals, pFrom, cLiterals * sizeof(WildSetLiteral));
+		pTo = pFrom;
+	}
+
+	free(pTo);
+	return;
+}
+
+
+// Orders 32-bit indexes, for qsort().
+//
+int WildSetIndexOrder(const void *pLeft, const void *pRight)
+{
+	uint32_t iL = *(const uint32_t *) pLeft;
+	uint32_t iR = *(const uint32_t *) pRight;
+
+	return iL < iR ? -1 : iL > iR;
+}
+
+
+// Orders pattern indexes, for qsort().
+//
+int WildSetMatchOrder(const void *pLeft, const void *pRight)
+{
+	size_t iL = *(const size_t *) pLeft;
+	size_t iR = *(const size_t *) pRight;
+
+	return iL < iR ? -1 : iL > iR;
+}
+
+
+// Returns the state reached from a state on a byte, or 0 if there's no 
+// such transition.
+//
+inline uint32_t WildSetEdge(WildPatternSet *pSet, uint32_t iState, 
+                            unsigned char chByte)
+{
+	WildSetState  *pState = &pSet->pStates[iState];
+	unsigned char *pBytes = pSet->pEdgeBytes + pState->iFirstEdge;
+	uint32_t       iLow = 0;
+	uint32_t       iHigh = pState->cEdges;
+
+	if (!iState)
+	{
+		return pSet->rgRoot[chByte];
+	}
+	else if (iHigh <= WILD_SET_LINEAR)
+	{
+		for (; iLow < iHigh; iLow++)
+		{
+			if (pBytes[iLow] == chByte)
+			{
+				return pSet->pEdgeTargets[pState->iFirstEdge + iLow];
+			}
+		}
+
+		return 0;
+	}
+
+	while (iLow < iHigh)
+	{
+		uint32_t iMiddle = (iLow + iHigh) / 2;
+
+		if (pBytes[iMiddle] < chByte)
+		{
+			iLow = iMiddle + 1;
+		}
+		else
+		{
+			iHigh = iMiddle;
+		}
+	}
+
+	return iLow < pState->cEdges && pBytes[iLow] == chByte 
+	       ? pSet->pEdgeTargets[pState->iFirstEdge + iLow] : 0;
+}
+
+
+// Builds the automaton over sorted literals.  Each state is first set up 
+// with the range of literals that pass through it, and the states are 
+// then expanded in breadth-first order.  Empty literals, which sort first, 
+// end at the root.  Returns false if memory can't be 
+// allocated.
+//
+bool WildSetBuild(WildPatternSet *pSet, WildSetLiteral *pLiterals, 
+                  uint32_t cLiterals)
+{
+	size_t    cbLiterals = 0;
+	uint32_t *pLow;
+	uint32_t *pHigh;
+	uint32_t *pDepth;
+	uint32_t  cEdges = 0;
+	uint32_t  cIndexes = 0;
+
+	for (uint32_t iLiteral = 0; iLiteral < cLiterals; iLiteral++)
+	{
+		cbLiterals += pLiterals[iLiteral].cbLiteral;
+	}
+
+	pSet->pStates = (WildSetState *) calloc(cbLiterals + 1, 
+	                                        sizeof(WildSetState));
+	pSet->pEdgeBytes = (unsigned char *) malloc(cbLiterals + 1);
+	pSet->pEdgeTargets = (uint32_t *) malloc((cbLiterals + 1) * 
+	                                         sizeof(uint32_t));
+	pLow = (uint32_t *) malloc(3 * (cbLiterals + 1) * sizeof(uint32_t));
+
+	if (!pSet->pStates || !pSet->pEdgeBytes || !pSet->pEdgeTargets || !pLow)
+	{
+		free(pLow);
+		return false;
+	}
+
+	pHigh = pLow + cbLiterals + 1;
+	pDepth = pHigh + cbLiterals + 1;
+	pLow[0] = 0;
+	pHigh[0] = cLiterals;
+	pDepth[0] = 0;
+	pSet->cStates = 1;
+
+	for (uint32_t iState = 0; iState < pSet->cStates; iState++)
+	{
+		WildSetState *pState = &pSet->pStates[iState];
+		uint32_t      iLiteral = pLow[iState];
+
+		// Literals that end here sort ahead of those that continue.
+		pState->iFirstPattern = cIndexes;
+
+		while (iLiteral < pHigh[iState] && 
+		       pLiterals[iLiteral].cbLiteral == pDepth[iState])
+		{
+			pSet->pPatternIndexes[cIndexes++] = 
+			    pLiterals[iLiteral++].iPattern;
+		}
+
+		pState->cPatterns = cIndexes - pState->iFirstPattern;
+		pState->iFirstEdge = cEdges;
+
+		while (iLiteral < pHigh[iState])
+		{
+			unsigned char chByte = 
+			    pLiterals[iLiteral].pLiteral[pDepth[iState]];
+			uint32_t      iChild = pSet->cStates++;
+
+			pLow[iChild] = iLiteral;
+
+			while (iLiteral < pHigh[iState] && 
+			       (unsigned char) pLiterals[iLiteral].pLiteral[
+			           pDepth[iState]] == chByte)
+			{
+				iLiteral++;
+			}
+
+			pHigh[iChild] = iLiteral;
+			pDepth[iChild] = pDepth[iState] + 1;
+			pSet->pEdgeBytes[cEdges] = chByte;
+			pSet->pEdgeTargets[cEdges++] = iChild;
+
+			if (!iState)
+			{
+				pSet->rgRoot[chByte] = iChild;
+			}
+		}
+
+		pState->cEdges = cEdges - pState->iFirstEdge;
+	}
+
+	free(pLow);
+
+	// Failure and output links, in breadth-first order, so that the links 
+	// of every shallower state are already in place.
+	for (uint32_t iState = 0; iState < pSet->cStates; iState++)
+	{
+		WildSetState *pState = &pSet->pStates[iState];
+
+		for (uint32_t iEdge = pState->iFirstEdge; 
+		     iEdge < pState->iFirstEdge + pState->cEdges; iEdge++)
+		{
+			WildSetState *pChild = &pSet->pStates[pSet->pEdgeTargets[iEdge]];
+			uint32_t      iFail = pState->iFail;
+
+			if (iState)
+			{
+				uint32_t iNext;
+
+				while (!(iNext = WildSetEdge(pSet, iFail, 
+				                             pSet->pEdgeBytes[iEdge])) &&
+				       iFail)
+				{
+					iFail = pSet->pStates[iFail].iFail;
+				}
+
+				pChild->iFail = iNext;
+			}
+
+			pChild->iOutput = pSet->pStates[pChild->iFail].cPatterns 
+			                  ? pChild->iFail 
+			                  : pSet->pStates[pChild->iFail].iOutput;
+		}
+	}
+
+	return true;
+}
+
+
+// Orders literals by their last bytes, from the last byte back, as Teddy 
+// buckets them.
+//
+int WildTeddyOrder(const void *pLeft, const void *pRight)
+{
+	const WildSetLiteral *pL = (const WildSetLiteral *) pLeft;
+	const WildSetLiteral *pR = (const WildSetLiteral *) pRight;
+
+	for (size_t iByte = 1; iByte <= pL->cbLiteral && iByte <= pR->cbLiteral; 
+	     iByte++)
+	{
+		unsigned char chL = pL->pLiteral[pL->cbLiteral - iByte];
+		unsigned char chR = pR->pLiteral[pR->cbLiteral - iByte];
+
+		if (chL != chR)
+		{
+			return chL < chR ? -1 : 1;
+		}
+	}
+
+	return pL->cbLiteral < pR->cbLiteral ? -1 : 
+	       pL->cbLiteral > pR->cbLiteral;
+}
+
+
+// Returns whether a literal, among sorted literals, is nonempty and 
+// differs from the one before it.
+//
+inline bool WildSetLiteralIsNew(WildSetLiteral *pLiterals, uint32_t iLiteral)
+{
+	WildSetLiteral *pLiteral = &pLiterals[iLiteral];
+
+	return pLiteral->cbLiteral && (!iLiteral || 
+	       pLiteral[-1].cbLiteral != pLiteral->cbLiteral || 
+	       memcmp(pLiteral[-1].pLiteral, pLiteral->pLiteral, 
+	              pLiteral->cbLiteral));
+}
+
+
+// Returns whether Teddy can run on this CPU.
+//
+inline bool WildTeddySupported(void)
+{
+#if defined(WILD_TEDDY_CHECK)
+	return __builtin_cpu_supports("ssse3");
+#elif defined(WILD_SET_TEDDY)
+	return true;
+#else
+	return false;
+#endif
+}
+
+
+// Sets up the Teddy tables for the distinct literals of a set, given its 
+// literals in sorted order.  Each literal's fingerprint is its last few 
+// bytes, which tend to vary more than its first few.  Returns false if 
+// there are more than cMaxDistinct distinct literals, or if memory for 
+// them can't be allocated.
+//
+bool WildTeddyBuild(WildPatternSet *pSet, WildSetLiteral *pLiterals, 
+                    uint32_t cLiterals, uint32_t cMaxDistinct)
+{
+	WildSetLiteral *pDistinct;
+	uint32_t        cDistinct = 0;
+	size_t          cbDistinct = 0;
+	uint32_t        iBytes = 0;
+
+	pSet->cbFingerprint = WILD_TEDDY_BYTES;
+
+	for (uint32_t iLiteral = 0; iLiteral < cLiterals; iLiteral++)
+	{
+		WildSetLiteral *pLiteral = &pLiterals[iLiteral];
+
+		if (WildSetLiteralIsNew(pLiterals, iLiteral))
+		{
+			cDistinct++;
+			cbDistinct += pLiteral->cbLiteral;
+
+			if (pLiteral->cbLiteral < pSet->cbFingerprint)
+			{
+				pSet->cbFingerprint = pLiteral->cbLiteral;
+			}
+		}
+	}
+
+	if (!cDistinct || cDistinct > cMaxDistinct || cbDistinct >= UINT32_MAX)
+	{
+		return false;
+	}
+
+	pSet->pTeddyLiterals = (WildTeddyLiteral *) malloc(
+	    cDistinct * sizeof(WildTeddyLiteral));
+	pSet->pTeddyBytes = (char *) malloc(cbDistinct);
+	pSet->cbTeddyBytes = cbDistinct;
+	pDistinct = (WildSetLiteral *) malloc(cDistinct * 
+	                                      sizeof(WildSetLiteral));
+
+	if (!pSet->pTeddyLiterals || !pSet->pTeddyBytes || !pDistinct)
+	{
+		free(pDistinct);
+		return false;
+	}
+
+	cDistinct = 0;
+
+	for (uint32_t iLiteral = 0; iLiteral < cLiterals; iLiteral++)
+	{
+		if (WildSetLiteralIsNew(pLiterals, iLiteral))
+		{
+			pDistinct[cDistinct++] = pLiterals[iLiteral];
+		}
+	}
+
+	// Literals with similar fingerprints share buckets.
+	qsort(pDistinct, cDistinct, sizeof(WildSetLiteral), WildTeddyOrder);
+
+	for (uint32_t iTeddy = 0; iTeddy < cDistinct; iTeddy++)
+	{
+		WildSetLiteral   *pLiteral = &pDistinct[iTeddy];
+		WildTeddyLiteral *pTeddy = &pSet->pTeddyLiterals[iTeddy];
+
+		memcpy(pSet->pTeddyBytes + iBytes, pLiteral->pLiteral, 
+		       pLiteral->cbLiteral);
+		pTeddy->iLiteral = iBytes;
+		pTeddy->cbLiteral = (uint32_t) pLiteral->cbLiteral;
+		pTeddy->iState = 0;
+		iBytes += pTeddy->cbLiteral;
+
+		for (size_t iByte = 0; iByte < pTeddy->cbLiteral; iByte++)
+		{
+			pTeddy->iState = WildSetEdge(pSet, pTeddy->iState, 
+			    (unsigned char) pLiteral->pLiteral[iByte]);
+		}
+	}
+
+	free(pDistinct);
+
+	for (uint32_t iBucket = 0; iBucket <= 8; iBucket++)
+	{
+		pSet->rgBucketFirst[iBucket] = iBucket * cDistinct / 8;
+	}
+
+	for (uint32_t iBucket = 0; iBucket < 8; iBucket++)
+	{
+		for (uint32_t iTeddy = pSet->rgBucketFirst[iBucket]; 
+		     iTeddy < pSet->rgBucketFirst[iBucket + 1]; iTeddy++)
+		{
+			WildTeddyLiteral *pTeddy = &pSet->pTeddyLiterals[iTeddy];
+			unsigned char    *pLiteral = (unsigned char *) 
+			    pSet->pTeddyBytes + pTeddy->iLiteral + pTeddy->cbLiteral - 
+			    pSet->cbFingerprint;
+
+			for (size_t iByte = 0; iByte < pSet->cbFingerprint; iByte++)
+			{
+				pSet->rgTeddyLow[iByte][pLiteral[iByte] & 0x0F] |= 
+				    1 << iBucket;
+				pSet->rgTeddyHigh[iByte][pLiteral[iByte] >> 4] |= 
+				    1 << iBucket;
+			}
+		}
+	}
+
+	return true;
+}
+
+
+// Returns the shape of a null-terminated pattern, as far as hashing goes, 
+// along with its literal content for the exact, prefix, and suffix shapes.
+//
+int WildSetShape(char *pWild, char **ppLiteral, size_t *pcbLiteral)
+{
+	size_t cbWild = strlen(pWild);
+	size_t iStart = 0;
+	size_t iEnd = cbWild;
+
+	if (memchr(pWild, '?', cbWild))
+	{
+		return WILD_SET_RESIDUAL;
+	}
+
+	while (iStart < cbWild && pWild[iStart] == '*')
+	{
+		iStart++;
+	}
+
+	while (iEnd > iStart && pWild[iEnd - 1] == '*')
+	{
+		iEnd--;
+	}
+
+	*ppLiteral = pWild + iStart;
+	*pcbLiteral = iEnd - iStart;
+
+	if (memchr(*ppLiteral, '*', *pcbLiteral) || 
+	    (iStart && iEnd < cbWild) || (*pcbLiteral == 0 && cbWild))
+	{
+		return WILD_SET_RESIDUAL;      // "*lit*", "a*b", or "*"
+	}
+
+	return iStart ? WILD_SET_SUFFIX : 
+	       iEnd < cbWild ? WILD_SET_PREFIX : WILD_SET_EXACT;
+}
+
+
+// Looks up literal content, with its hash, in an index.  Returns the group 
+// of patterns with that content, or NULL if there's none.
+//
+inline WildSetGroup *WildSetIndexFind(WildSetIndex *pIndex, uint64_t iHash, 
+                                      char *pContent, size_t cbContent, 
+                                      bool bBackward)
+{
+	for (uint32_t iSlot = (uint32_t) iHash & pIndex->iSlotMask; 
+	     pIndex->pSlots[iSlot]; iSlot = (iSlot + 1) & pIndex->iSlotMask)
+	{
+		WildSetGroup *pGroup = &pIndex->pGroups[pIndex->pSlots[iSlot] - 1];
+
+		// pBytes is NULL where every literal of the shape is empty.
+		if (pGroup->iHash == iHash && pGroup->cbLiteral == cbContent && 
+		    (!cbContent || 
+		     !memcmp(bBackward ? pContent - cbContent : pContent, 
+		             pIndex->pBytes + pGroup->iLiteral, cbContent)))
+		{
+			return pGroup;
+		}
+	}
+
+	return NULL;
+}
+
+
+// Builds an index over the sorted literals of patterns of one shape, 
+// grouping patterns with the same literal.  Returns false if memory for 
+// the index can't be allocated.
+//
+bool WildSetIndexBuild(WildSetIndex *pIndex, WildSetLiteral *pLiterals, 
+                       uint32_t cLiterals, bool bBackward)
+{
+	size_t   cbLiterals = 0;
+	uint32_t cSlots = 1;
+	uint32_t iBytes = 0;
+
+	if (!cLiterals)
+	{
+		return true;
+	}
+
+	for (uint32_t iLiteral = 0; iLiteral < cLiterals; iLiteral++)
+	{
+		cbLiterals += pLiterals[iLiteral].cbLiteral;
+	}
+
+	if (cbLiterals >= UINT32_MAX)
+	{
+		return false;
+	}
+
+	while (cSlots < 2 * cLiterals)
+	{
+		cSlots *= 2;
+	}
+
+	pIndex->pGroups = (WildSetGroup *) malloc(cLiterals * 
+	                                          sizeof(WildSetGroup));
+	pIndex->pSlots = (uint32_t *) calloc(cSlots, sizeof(uint32_t));
+	pIndex->pLengths = (uint32_t *) malloc(cLiterals * sizeof(uint32_t));
+	pIndex->pIndexes = (uint32_t *) malloc(cLiterals * sizeof(uint32_t));
+	pIndex->pBytes = (char *) malloc(cbLiterals + 1);
+	pIndex->cbBytes = cbLiterals;
+
+	if (!pIndex->pGroups || !pIndex->pSlots || !pIndex->pLengths || 
+	    !pIndex->pIndexes || !pIndex->pBytes)
+	{
+		return false;
+	}
+
+	pIndex->iSlotMask = cSlots - 1;
+	pIndex->cIndexes = cLiterals;
+
+	for (uint32_t iLiteral = 0; iLiteral < cLiterals; iLiteral++)
+	{
+		WildSetLiteral *pLiteral = &pLiterals[iLiteral];
+		WildSetGroup   *pGroup = &pIndex->pGroups[pIndex->cGroups];
+		uint32_t        iSlot;
+
+		pIndex->pIndexes[iLiteral] = pLiteral->iPattern;
+
+		if (iLiteral && pGroup[-1].cbLiteral == pLiteral->cbLiteral && 
+		    !memcmp(pIndex->pBytes + pGroup[-1].iLiteral, pLiteral->pLiteral, 
+		            pLiteral->cbLiteral))
+		{
+			pGroup[-1].cPatterns++;
+			continue;
+		}
+
+		memcpy(pIndex->pBytes + iBytes, pLiteral->pLiteral, 
+		       pLiteral->cbLiteral);
+		pGroup->iLiteral = iBytes;
+		pGroup->cbLiteral = (uint32_t) pLiteral->cbLiteral;
+		pGroup->iHash = WILD_HASH_BASIS;
+		pGroup->iFirst = iLiteral;
+		pGroup->cPatterns = 1;
+		iBytes += pGroup->cbLiteral;
+
+		for (size_t iByte = 0; iByte < pGroup->cbLiteral; iByte++)
+		{
+			pGroup->iHash = WildHashStep(pGroup->iHash, (unsigned char) 
+			    pLiteral->pLiteral[bBackward ? pGroup->cbLiteral - 1 - iByte 
+			                                 : iByte]);
+		}
+
+		for (iSlot = (uint32_t) pGroup->iHash & pIndex->iSlotMask; 
+		     pIndex->pSlots[iSlot]; iSlot = (iSlot + 1) & pIndex->iSlotMask)
+		{
+			continue;
+		}
+
+		pIndex->pSlots[iSlot] = ++pIndex->cGroups;
+	}
+
+	// Literals are sorted by content, so their lengths need sorting too.
+	for (uint32_t iGroup = 0; iGroup < pIndex->cGroups; iGroup++)
+	{
+		uint32_t cbLiteral = pIndex->pGroups[iGroup].cbLiteral;
+		uint32_t iLength = 0;
+
+		while (iLength < pIndex->cLengths && 
+		       pIndex->pLengths[iLength] < cbLiteral)
+		{
+			iLength++;
+		}
+
+		if (iLength == pIndex->cLengths || 
+		    pIndex->pLengths[iLength] != cbLiteral)
+		{
+			memmove(pIndex->pLengths + iLength + 1, 
+			        pIndex->pLengths + iLength, 
+			        (pIndex->cLengths++ - iLength) * sizeof(uint32_t));
+			pIndex->pLengths[iLength] = cbLiteral;
+		}
+	}
+
+	return true;
+}
+
+
+// Stores the indexes of a group's patterns as matches.
+//
+inline void WildSetGroupMatch(WildSetIndex *pIndex, WildSetGroup *pGroup, 
+                              size_t *piMatches, size_t *pcMatches)
+{
+	for (uint32_t iIndex = pGroup->iFirst; 
+	     iIndex < pGroup->iFirst + pGroup->cPatterns; iIndex++)
+	{
+		piMatches[(*pcMatches)++] = pIndex->pIndexes[iIndex];
+	}
+
+	return;
+}
+
+
+// Finds the tame string's matches among the hashed patterns of a set, via 
+// one forward pass for the exact and prefix shapes, and one backward pass 
+// for the suffix shape.
+//
+size_t WildSetIndexMatch(WildPatternSet *pSet, char *pTame, 
+                         size_t *piMatches)
+{
+	WildSetIndex *pExact = &pSet->rgIndexes[WILD_SET_EXACT];
+	WildSetIndex *pPrefix = &pSet->rgIndexes[WILD_SET_PREFIX];
+	WildSetIndex *pSuffix = &pSet->rgIndexes[WILD_SET_SUFFIX];
+	WildSetGroup *pGroup;
+	uint64_t      iHash = WILD_HASH_BASIS;
+	size_t        cbTame = 0;
+	size_t        iLength = 0;
+	size_t        cMatches = 0;
+
+	if (!pExact->cGroups && !pPrefix->cGroups)
+	{
+		cbTame = strlen(pTame);
+	}
+	else
+	{
+		while (pTame[cbTame])
+		{
+			iHash = WildHashStep(iHash, (unsigned char) pTame[cbTame++]);
+
+			if (iLength < pPrefix->cLengths && 
+			    pPrefix->pLengths[iLength] == cbTame)
+			{
+				iLength++;
+
+				if ((pGroup = WildSetIndexFind(pPrefix, iHash, pTame, cbTame, 
+				                               false)))
+				{
+					WildSetGroupMatch(pPrefix, pGroup, piMatches, &cMatches);
+				}
+			}
+		}
+
+		if (pExact->cGroups && 
+		    (pGroup = WildSetIndexFind(pExact, iHash, pTame, cbTame, false)))
+		{
+			WildSetGroupMatch(pExact, pGroup, piMatches, &cMatches);
+		}
+	}
+
+	iHash = WILD_HASH_BASIS;
+	iLength = 0;
+
+	for (size_t cbSuffix = 1; 
+	     cbSuffix <= cbTame && iLength < pSuffix->cLengths; cbSuffix++)
+	{
+		iHash = WildHashStep(iHash, (unsigned char) pTame[cbTame - cbSuffix]);
+
+		if (pSuffix->pLengths[iLength] == cbSuffix)
+		{
+			iLength++;
+
+			if ((pGroup = WildSetIndexFind(pSuffix, iHash, pTame + cbTame, 
+			                               cbSuffix, true)))
+			{
+				WildSetGroupMatch(pSuffix, pGroup, piMatches, &cMatches);
+			}
+		}
+	}
+
+	return cMatches;
+}
+
+
+// Releases a set that's still being assembled, along with its arrays, 
+// which are separately allocated until the set is packed.
+//
+void WildSetRelease(WildPatternSet *pSet)
+{
+	if (!pSet)
+	{
+		return;
+	}
+
+	free(pSet->pPatternIndexes);
+	free(pSet->pStates);
+	free(pSet->pEdgeBytes);
+	free(pSet->pEdgeTargets);
+	free(pSet->pTeddyLiterals);
+	free(pSet->pTeddyBytes);
+	free(pSet->pResidual);
+
+	for (int iShape = 0; iShape < WILD_SET_SHAPES; iShape++)
+	{
+		free(pSet->rgIndexes[iShape].pGroups);
+		free(pSet->rgIndexes[iShape].pSlots);
+		free(pSet->rgIndexes[iShape].pLengths);
+		free(pSet->rgIndexes[iShape].pIndexes);
+		free(pSet->rgIndexes[iShape].pBytes);
+	}
+
+	free(pSet);
+	return;
+}
+
+
+// Assembles the arrays of a set of null-terminated UTF-8 patterns, each in 
+// its own allocation, without compiling the patterns, on as many as 
+// cThreads threads.  For WILD_SET_STRATEGY_AUTO, the patterns left over 
+// from hashing, which sets of 32 or fewer patterns skip, are searched for 
+// their literals via Teddy, where the CPU supports it, when there are at 
+// least 5 of them and at most 32 distinct literals, or else via the 
+// automaton, when there are at least 13 of them.  Fewer are matched one 
+// pattern at a time.  Those are the crossovers that benchset() measures.  
+// Beyond 32 literals, Teddy's buckets fill up with false candidates, so 
+// it's only used for up to 64 if asked for.  Returns NULL if memory for 
+// the set can't be allocated.
+//
+WildPatternSet *WildSetAssemble(char **ppWild, size_t cWild, int iStrategy, 
+                                unsigned cThreads)
+{
+	WildPatternSet *pSet = (WildPatternSet *) calloc(1, sizeof(WildPatternSet));
+	WildSetLiteral *pFound = 
+	    (WildSetLiteral *) malloc((cWild + 1) * sizeof(WildSetLiteral));
+	WildSetLiteral *pLiterals = 
+	    (WildSetLiteral *) malloc((cWild + 1) * sizeof(WildSetLiteral));
+	unsigned char  *pShapes = (unsigned char *) malloc(cWild + 1);
+	uint32_t        rgFirst[WILD_SET_SHAPES + 1] = { 0 };
+	uint32_t        rgParts[WILD_SET_THREADS][WILD_SET_SHAPES];
+	bool            rgBuilt[WILD_SET_SHAPES];
+	bool            bHashed = iStrategy == WILD_SET_STRATEGY_AUTO && 
+	                          cWild >= WILD_SET_HASHED;
+
+	if (!pSet || !pFound || !pLiterals || !pShapes || cWild >= UINT32_MAX)
+	{
+		free(pShapes);
+		free(pLiterals);
+		free(pFound);
+		free(pSet);
+		return NULL;
+	}
+
+	pSet->cPatterns = cWild;
+	pSet->pPatternIndexes = (uint32_t *) malloc((cWild + 1) * 
+	                                            sizeof(uint32_t));
+	pSet->pResidual = (uint32_t *) malloc((cWild + 1) * sizeof(uint32_t));
+
+	if (!pSet->pPatternIndexes || !pSet->pResidual)
+	{
+		free(pShapes);
+		free(pLiterals);
+		free(pFound);
+		WildSetRelease(pSet);
+		return NULL;
+	}
+
+	// Hashed shapes are set aside when the strategy is automatic and the 
+	// set is large enough to pay for the lookups.  The rest of the patterns 
+	// contribute their rarest literal runs.  The patterns are split into 
+	// one part per thread, and each part's patterns of each shape are 
+	// counted.
+	WildSetParallel(cThreads, cThreads, [&](size_t iFirst, size_t iEnd) {
+		for (size_t iPart = iFirst; iPart < iEnd; iPart++)
+		{
+			size_t iLast = (iPart + 1) * cWild / cThreads;
+
+			memset(rgParts[iPart], 0, sizeof(rgParts[iPart]));
+
+			for (size_t iWild = iPart * cWild / cThreads; iWild < iLast; 
+			     iWild++)
+			{
+				WildSetLiteral *pLiteral = &pFound[iWild];
+				int             iShape = WILD_SET_RESIDUAL;
+
+				if (bHashed)
+				{
+					iShape = WildSetShape(ppWild[iWild], &pLiteral->pLiteral, 
+					                      &pLiteral->cbLiteral);
+				}
+
+				if (iShape == WILD_SET_RESIDUAL)
+				{
+					WildRarestRun(ppWild[iWild], strlen(ppWild[iWild]), 
+					              &pLiteral->pLiteral, 
+					              &pLiteral->cbLiteral);
+				}
+
+				pLiteral->iLeading = WildSetLeading(pLiteral->pLiteral, 
+				                                    pLiteral->cbLiteral);
+				pLiteral->iPattern = (uint32_t) iWild;
+				pShapes[iWild] = (unsigned char) iShape;
+				rgParts[iPart][iShape]++;
+			}
+		}
+	});
+
+	// The literals are grouped by shape, in pattern order within each, so 
+	// each part's literals of a shape follow those of the parts before it.
+	for (int iShape = 0; iShape < WILD_SET_SHAPES; iShape++)
+	{
+		rgFirst[iShape + 1] = rgFirst[iShape];
+
+		for (unsigned iPart = 0; iPart < cThreads; iPart++)
+		{
+			uint32_t cPart = rgParts[iPart][iShape];
+
+			rgParts[iPart][iShape] = rgFirst[iShape + 1];
+			rgFirst[iShape + 1] += cPart;
+		}
+	}
+
+	// Residual literals come first, so their places are the places of 
+	// their patterns among the residual patterns too.
+	WildSetParallel(cThreads, cThreads, [&](size_t iFirst, size_t iEnd) {
+		for (size_t iPart = iFirst; iPart < iEnd; iPart++)
+		{
+			size_t iLast = (iPart + 1) * cWild / cThreads;
+
+			for (size_t iWild = iPart * cWild / cThreads; iWild < iLast; 
+			     iWild++)
+			{
+				uint32_t iLiteral = rgParts[iPart][pShapes[iWild]]++;
+
+				pLiterals[iLiteral] = pFound[iWild];
+
+				if (pShapes[iWild] == WILD_SET_RESIDUAL)
+				{
+					pSet->pResidual[iLiteral] = (uint32_t) iWild;
+				}
+			}
+		}
+	});
+
+	pSet->cResidual = rgFirst[WILD_SET_RESIDUAL + 1];
+	free(pShapes);
+	free(pFound);
+
+	for (int iShape = 0; iShape < WILD_SET_SHAPES; iShape++)
+	{
+		WildSetSort(pLiterals + rgFirst[iShape], 
+		            rgFirst[iShape + 1] - rgFirst[iShape], cThreads);
+	}
+
+	// The automaton and each hash index are built from their own literals 
+	// into their own arrays, so they're built at the same time.
+	WildSetParallel(WILD_SET_SHAPES, cThreads, 
+	                [&](size_t iFirst, size_t iEnd) {
+		for (size_t iShape = iFirst; iShape < iEnd; iShape++)
+		{
+			if (iShape == WILD_SET_RESIDUAL)
+			{
+				rgBuilt[iShape] = WildSetBuild(pSet, pLiterals, 
+				                               pSet->cResidual);
+			}
+			else
+			{
+				rgBuilt[iShape] = WildSetIndexBuild(&pSet->rgIndexes[iShape], 
+				    pLiterals + rgFirst[iShape], 
+				    rgFirst[iShape + 1] - rgFirst[iShape], 
+				    iShape == WILD_SET_SUFFIX);
+			}
+		}
+	});
+
+	for (int iShape = 0; iShape < WILD_SET_SHAPES; iShape++)
+	{
+		if (!rgBuilt[iShape])
+		{
+			free(pLiterals);
+			WildSetRelease(pSet);
+			return NULL;
+		}
+	}
+
+	if (iStrategy == WILD_SET_STRATEGY_AUTO)
+	{
+		if (pSet->cResidual < WILD_TEDDY_EACH || 
+		    (pSet->cResidual < WILD_SET_EACH && !WildTeddySupported()))
+		{
+			iStrategy = WILD_SET_STRATEGY_EACH;
+		}
+		else if (WildTeddySupported() && 
+		         WildTeddyBuild(pSet, pLiterals, pSet->cResidual, 
+		                        WILD_TEDDY_AUTO))
+		{
+			iStrategy = WILD_SET_STRATEGY_TEDDY;
+		}
+		else if (pSet->cResidual < WILD_SET_EACH)
+		{
+			iStrategy = WILD_SET_STRATEGY_EACH;
+		}
+	}
+	else if (iStrategy == WILD_SET_STRATEGY_TEDDY && 
+	         (!WildTeddySupported() || 
+	          !WildTeddyBuild(pSet, pLiterals, pSet->cResidual, 
+	                          WILD_TEDDY_MAX)))
+	{
+		iStrategy = WILD_SET_STRATEGY_AHO_CORASICK;
+	}
+
+	if (iStrategy != WILD_SET_STRATEGY_EACH && 
+	    iStrategy != WILD_SET_STRATEGY_TEDDY)
+	{
+		iStrategy = WILD_SET_STRATEGY_AHO_CORASICK;
+	}
+
+	pSet->iStrategy = iStrategy;
+	free(pLiterals);
+	return pSet;
+}
+
+
+// Lists the arrays of a set, in the order of the sections of an image, as 
+// the offsets of the set's pointers to them within the set, along with 
+// their sizes in bytes, which follow from the set's counts.
+//
+void WildSetArrays(WildPatternSet *pSet, 
+                   size_t rgFields[WILD_IMAGE_SECTIONS], 
+                   uint64_t rgSizes[WILD_IMAGE_SECTIONS])
+{
+	uint64_t cEdges = pSet->cStates ? pSet->cStates - 1 : 0;
+	bool     bTeddy = pSet->iStrategy == WILD_SET_STRATEGY_TEDDY;
+
+	rgFields[WILD_IMAGE_STATES] = offsetof(WildPatternSet, pStates);
+	rgSizes[WILD_IMAGE_STATES] = pSet->cStates * sizeof(WildSetState);
+	rgFields[WILD_IMAGE_EDGE_BYTES] = offsetof(WildPatternSet, pEdgeBytes);
+	rgSizes[WILD_IMAGE_EDGE_BYTES] = cEdges;
+	rgFields[WILD_IMAGE_EDGE_TARGETS] = offsetof(WildPatternSet, pEdgeTargets);
+	rgSizes[WILD_IMAGE_EDGE_TARGETS] = cEdges * sizeof(uint32_t);
+	rgFields[WILD_IMAGE_PATTERN_INDEXES] = 
+	    offsetof(WildPatternSet, pPatternIndexes);
+	rgSizes[WILD_IMAGE_PATTERN_INDEXES] = pSet->cResidual * sizeof(uint32_t);
+	rgFields[WILD_IMAGE_RESIDUAL] = offsetof(WildPatternSet, pResidual);
+	rgSizes[WILD_IMAGE_RESIDUAL] = pSet->cResidual * sizeof(uint32_t);
+	rgFields[WILD_IMAGE_TEDDY_LITERALS] = 
+	    offsetof(WildPatternSet, pTeddyLiterals);
+	rgSizes[WILD_IMAGE_TEDDY_LITERALS] = 
+	    bTeddy ? pSet->rgBucketFirst[8] * sizeof(WildTeddyLiteral) : 0;
+	rgFields[WILD_IMAGE_TEDDY_BYTES] = offsetof(WildPatternSet, pTeddyBytes);
+	rgSizes[WILD_IMAGE_TEDDY_BYTES] = bTeddy ? pSet->cbTeddyBytes : 0;
+	rgFields[WILD_IMAGE_PATTERN_OFFSETS] = 
+	    offsetof(WildPatternSet, pPatternOffsets);
+	rgSizes[WILD_IMAGE_PATTERN_OFFSETS] = 
+	    pSet->cbPatternBytes ? pSet->cPatterns * sizeof(uint32_t) : 0;
+	rgFields[WILD_IMAGE_PATTERN_BYTES] = 
+	    offsetof(WildPatternSet, pPatternBytes);
+	rgSizes[WILD_IMAGE_PATTERN_BYTES] = pSet->cbPatternBytes;
+
+	for (int iShape = WILD_SET_EXACT; iShape < WILD_SET_SHAPES; iShape++)
+	{
+		WildSetIndex *pIndex = &pSet->rgIndexes[iShape];
+		int           iFirst = WILD_IMAGE_INDEXES + 
+		                       (iShape - 1) * WILD_IMAGE_INDEX_SECTIONS;
+		size_t        iIndex = offsetof(WildPatternSet, rgIndexes) + 
+		                       iShape * sizeof(WildSetIndex);
+
+		rgFields[iFirst + WILD_IMAGE_INDEX_GROUPS] = 
+		    iIndex + offsetof(WildSetIndex, pGroups);
+		rgSizes[iFirst + WILD_IMAGE_INDEX_GROUPS] = 
+		    pIndex->cGroups * sizeof(WildSetGroup);
+		rgFields[iFirst + WILD_IMAGE_INDEX_SLOTS] = 
+		    iIndex + offsetof(WildSetIndex, pSlots);
+		rgSizes[iFirst + WILD_IMAGE_INDEX_SLOTS] = pIndex->cGroups 
+		    ? ((uint64_t) pIndex->iSlotMask + 1) * sizeof(uint32_t) : 0;
+		rgFields[iFirst + WILD_IMAGE_INDEX_LENGTHS] = 
+		    iIndex + offsetof(WildSetIndex, pLengths);
+		rgSizes[iFirst + WILD_IMAGE_INDEX_LENGTHS] = 
+		    pIndex->cLengths * sizeof(uint32_t);
+		rgFields[iFirst + WILD_IMAGE_INDEX_INDEXES] = 
+		    iIndex + offsetof(WildSetIndex, pIndexes);
+		rgSizes[iFirst + WILD_IMAGE_INDEX_INDEXES] = 
+		    pIndex->cIndexes * sizeof(uint32_t);
+		rgFields[iFirst + WILD_IMAGE_INDEX_BYTES] = 
+		    iIndex + offsetof(WildSetIndex, pBytes);
+		rgSizes[iFirst + WILD_IMAGE_INDEX_BYTES] = pIndex->cbBytes;
+	}
+
+	return;
+}
+
+
+// Returns the array that a set's pointer at the given offset points to.
+//
+inline void *WildSetArrayGet(WildPatternSet *pSet, size_t iField)
+{
+	void *pArray;
+
+	memcpy(&pArray, (char *) pSet + iField, sizeof(pArray));
+	return pArray;
+}
+
+
+// Points a set's pointer, at the given offset, to an array.
+//
+inline void WildSetArrayPut(WildPatternSet *pSet, size_t iField, 
+                            void *pArray)
+{
+	memcpy((char *) pSet + iField, &pArray, sizeof(pArray));
+	return;
+}
+
+
+// Rounds a size up to a whole number of WILD_SET_ALIGN-byte units.  Sizes 
+// rounded that way add up to at least the bytes taken by the parts of a 
+// packed set, none of which is aligned any more strictly.
+//
+inline uint64_t WildSetAlign(uint64_t cbPart)
+{
+	return (cbPart + WILD_SET_ALIGN - 1) & ~(uint64_t) (WILD_SET_ALIGN - 1);
+}
+
+
+// Packs an assembled set into one block: the set itself, followed by its 
+// arrays, followed by its compiled patterns, on as many as cThreads 
+// threads.  Each pattern is compiled once into a scratch arena, to find 
+// how many bytes it takes, and the patterns are laid out in order, each 
+// WILD_SET_ALIGN-aligned, before they're compiled again into their places 
+// in the block.  The block comes from pArena, if it's not NULL, or else 
+// from the heap, zeroed either way, so that the padding between patterns 
+// is the same every time the set is packed.  Releases the assembled set 
+// either way.  Returns NULL if memory for the block can't be allocated, or 
+// if it would be 4 GB or more.
+//
+WildPatternSet *WildSetPack(WildPatternSet *pAssembled, char **ppWild, 
+                            WildArena *pArena, unsigned cThreads)
+{
+	size_t          rgFields[WILD_IMAGE_SECTIONS];
+	uint64_t        rgSizes[WILD_IMAGE_SECTIONS];
+	size_t          cWild = pAssembled->cPatterns;
+	uint64_t        cbBlock = WildSetAlign(sizeof(WildPatternSet)) + 
+	                          WildSetAlign(cWild * sizeof(uint32_t));
+	uint32_t       *pOffsets = (uint32_t *) malloc((cWild + 1) * 
+	                                               sizeof(uint32_t));
+	WildArena      *pBlockArena = NULL;
+	WildPatternSet *pSet = NULL;
+	void           *pBlock = NULL;
+
+	WildSetArrays(pAssembled, rgFields, rgSizes);
+
+	for (int iSection = 0; iSection < WILD_IMAGE_SECTIONS; iSection++)
+	{
+		cbBlock += WildSetAlign(rgSizes[iSection]);
+	}
+
+	// Each pattern's size is found on its own, with UINT32_MAX standing 
+	// for a pattern that couldn't be compiled.
+	WildSetParallel(pOffsets ? cWild : 0, cThreads, 
+	                [&](size_t iFirst, size_t iEnd) {
+		WildArena *pScratch = FastWildArenaCreate(4096);
+
+		for (size_t iWild = iFirst; iWild < iEnd; iWild++)
+		{
+			size_t cbPattern;
+			size_t cbReserved;
+
+			pOffsets[iWild] = UINT32_MAX;
+
+			if (pScratch)
+			{
+				FastWildArenaReset(pScratch);
+
+				if (FastWildPatternCompileArena(ppWild[iWild], pScratch))
+				{
+					FastWildArenaBytes(pScratch, &cbPattern, &cbReserved);
+					pOffsets[iWild] = (uint32_t) 
+					    (cbPattern < UINT32_MAX ? cbPattern : UINT32_MAX);
+				}
+			}
+		}
+
+		FastWildArenaFree(pScratch);
+	});
+
+	for (size_t iWild = 0; pOffsets && iWild < cWild; iWild++)
+	{
+		uint64_t cbPattern = pOffsets[iWild];
+
+		if (cbPattern == UINT32_MAX || cbBlock >= UINT32_MAX)
+		{
+			cbBlock = UINT32_MAX;
+			break;
+		}
+
+		pOffsets[iWild] = (uint32_t) cbBlock;
+		cbBlock += WildSetAlign(cbPattern);
+	}
+
+	if (pOffsets && cbBlock < UINT32_MAX)
+	{
+		pOffsets[cWild] = (uint32_t) cbBlock;
+		pBlock = pArena ? FastWildArenaAlloc(pArena, (size_t) cbBlock, 
+		                                     WILD_SET_ALIGN) 
+		                : calloc(1, (size_t) cbBlock);
+		pBlockArena = pBlock ? FastWildArenaCreateFixed(pBlock, 
+		                                                (size_t) cbBlock) 
+		                     : NULL;
+	}
+
+	if (pBlockArena)
+	{
+		pSet = (WildPatternSet *) FastWildArenaAlloc(pBlockArena, 
+		    sizeof(WildPatternSet), WILD_SET_ALIGN);
+		*pSet = *pAssembled;
+		pSet->cbBlock = (size_t) cbBlock;
+		pSet->bArena = pArena != NULL;
+
+		for (int iSection = 0; iSection < WILD_IMAGE_SECTIONS; iSection++)
+		{
+			void *pArray = rgSizes[iSection] 
+			    ? FastWildArenaAlloc(pBlockArena, (size_t) rgSizes[iSection], 
+			                         sizeof(uint64_t)) 
+			    : NULL;
+
+			if (pArray)
+			{
+				memcpy(pArray, WildSetArrayGet(pAssembled, rgFields[iSection]), 
+				       (size_t) rgSizes[iSection]);
+			}
+
+			WildSetArrayPut(pSet, rgFields[iSection], pArray);
+		}
+
+		// The assembled set has no pattern offsets among its arrays.
+		pSet->pPatternOffsets = (uint32_t *) FastWildArenaAlloc(pBlockArena, 
+		    cWild * sizeof(uint32_t), sizeof(uint64_t));
+
+		// Each thread compiles its patterns into its own part of the block, 
+		// padding up to each pattern's place.  An offset of 0 stands for a 
+		// pattern that couldn't be compiled.
+		WildSetParallel(cWild, cThreads, [&](size_t iFirst, size_t iEnd) {
+			WildArena *pPart = FastWildArenaCreateFixed((char *) pSet + 
+			    pOffsets[iFirst], pOffsets[iEnd] - pOffsets[iFirst]);
+
+			for (size_t iWild = iFirst; iWild < iEnd; iWild++)
+			{
+				WildPattern *pPattern = NULL;
+				size_t       cbUsed;
+				size_t       cbReserved;
+
+				if (pPart)
+				{
+					FastWildArenaBytes(pPart, &cbUsed, &cbReserved);
+				}
+
+				if (pPart && cbUsed <= pOffsets[iWild] - pOffsets[iFirst] && 
+				    (cbUsed == pOffsets[iWild] - pOffsets[iFirst] || 
+				     FastWildArenaAlloc(pPart, pOffsets[iWild] - 
+				                        pOffsets[iFirst] - cbUsed, 1)))
+				{
+					pPattern = FastWildPatternCompileArena(ppWild[iWild], 
+					                                       pPart);
+				}
+
+				pSet->pPatternOffsets[iWild] = pPattern 
+				    ? (uint32_t) ((char *) pPattern - (char *) pSet) : 0;
+			}
+
+			FastWildArenaFree(pPart);
+		});
+
+		for (size_t iWild = 0; iWild < cWild; iWild++)
+		{
+			if (!pSet->pPatternOffsets[iWild])
+			{
+				pSet = NULL;
+				break;
+			}
+		}
+	}
+
+	if (pSet && cWild)
+	{
+		pSet->pPatternBytes = (char *) pSet + pOffsets[0];
+		pSet->cbPatternBytes = pOffsets[cWild] - pOffsets[0];
+
+		for (size_t iWild = 0; iWild < cWild; iWild++)
+		{
+			pSet->pPatternOffsets[iWild] -= pOffsets[0];
+		}
+	}
+
+	if (!pSet && !pArena)
+	{
+		free(pBlock);
+	}
+
+	FastWildArenaFree(pBlockArena);
+	free(pOffsets);
+	WildSetRelease(pAssembled);
+	return pSet;
+}
+
+
+// Returns the number of threads to compile a set of cWild patterns on, 
+// given the number asked for, where 0 asks for one per processor, as long 
+// as each thread has at least WILD_SET_SHARE patterns.
+//
+unsigned WildSetThreads(size_t cWild, unsigned cThreads)
+{
+	if (!cThreads)
+	{
+		size_t cShares = cWild / WILD_SET_SHARE;
+
+		cThreads = std::thread::hardware_concurrency();
+		cThreads = cShares < cThreads ? (unsigned) cShares : cThreads;
+	}
+
+	cThreads = cThreads < WILD_SET_THREADS ? cThreads : WILD_SET_THREADS;
+	return cThreads ? cThreads : 1;
+}
+
+
+// Compiles an array of null-terminated UTF-8 patterns into a set, matched 
+// via the given strategy, on as many as cThreads threads, or on one per 
+// processor if cThreads is 0.  The set is in one block allocated from an 
+// arena, or from the heap if pArena is NULL, and it comes out the same 
+// however many threads compile it.  Returns NULL if memory for the set 
+// can't be allocated.
+//
+WildPatternSet *FastWildSetCompileThreads(char **ppWild, size_t cWild, 
+                                          int iStrategy, WildArena *pArena, 
+                                          unsigned cThreads)
+{
+	WildPatternSet *pAssembled;
+
+	cThreads = WildSetThreads(cWild, cThreads);
+	pAssembled = WildSetAssemble(ppWild, cWild, iStrategy, cThreads);
+	return pAssembled ? WildSetPack(pAssembled, ppWild, pArena, cThreads) 
+	                  : NULL;
+}
+
+
+// Compiles an array of null-terminated UTF-8 patterns into a set, matched 
+// via the given strategy, in one block allocated from an arena, or from 
+// the heap if pArena is NULL.  A set in an arena is released along with 
+// the arena.  Returns NULL if memory for the set can't be allocated.
+//
+WildPatternSet *FastWildSetCompileArena(char **ppWild, size_t cWild, 
+                                        int iStrategy, WildArena *pArena)
+{
+	return FastWildSetCompileThreads(ppWild, cWild, iStrategy, pArena, 0);
+}
+
+
+// Compiles an array of null-terminated UTF-8 patterns into a set, matched 
+// via the given strategy.  Returns NULL if memory for the set can't be 
+// allocated.
+//
+WildPatternSet *FastWildSetCompileStrategy(char **ppWild, size_t cWild, 
+                                           int iStrategy)
+{
+	return FastWildSetCompileArena(ppWild, cWild, iStrategy, NULL);
+}
+
+
+// Compiles an array of null-terminated UTF-8 patterns into a set, with 
+// the strategy for matching it picked automatically.  Returns NULL if 
+// memory for the set can't be allocated.
+//
+WildPatternSet *FastWildSetCompile(char **ppWild, size_t cWild)
+{
+	return FastWildSetCompileStrategy(ppWild, cWild, WILD_SET_STRATEGY_AUTO);
+}
+
+
+// Returns the strategy in effect for a set, which differs from the one 
+// it was compiled with if that one wasn't available.
+//
+int FastWildSetStrategy(WildPatternSet *pSet)
+{
+	return pSet->iStrategy;
+}
+
+
+// Adds a hit, as a state with patterns, to those gathered so far.  The 
+// hits are deduplicated whenever the buffer fills, and the buffer grows 
+// if that doesn't free up half of it.  If a larger buffer can't be 
+// allocated, every pattern will be matched.
+//
+inline void WildSetHitAdd(WildSetHits *pHits, uint32_t iState)
+{
+	if (pHits->cHits && pHits->pHits[pHits->cHits - 1] == iState)
+	{
+		return;
+	}
+	else if (pHits->cHits == pHits->cMaxHits)
+	{
+		size_t cUnique = 0;
+
+		qsort(pHits->pHits, pHits->cHits, sizeof(uint32_t), 
+		      WildSetIndexOrder);
+
+		for (size_t iHit = 0; iHit < pHits->cHits; iHit++)
+		{
+			if (!cUnique || pHits->pHits[cUnique - 1] != pHits->pHits[iHit])
+			{
+				pHits->pHits[cUnique++] = pHits->pHits[iHit];
+			}
+		}
+
+		pHits->cHits = cUnique;
+
+		if (pHits->cHits > pHits->cMaxHits / 2)
+		{
+			uint32_t *pMore = (uint32_t *) malloc(
+			    2 * pHits->cMaxHits * sizeof(uint32_t));
+
+			if (!pMore)
+			{
+				pHits->bEvery = true;
+				return;
+			}
+
+			memcpy(pMore, pHits->pHits, pHits->cHits * sizeof(uint32_t));
+
+			if (pHits->pHits != pHits->rgLocal)
+			{
+				free(pHits->pHits);
+			}
+
+			pHits->pHits = pMore;
+			pHits->cMaxHits *= 2;
+		}
+	}
+
+	pHits->pHits[pHits->cHits++] = iState;
+	return;
+}
+
+
+// Walks the automaton over a tame string, gathering its hits.
+//
+void WildAhoCorasickScan(WildPatternSet *pSet, char *pTame, 
+                         WildSetHits *pHits)
+{
+	uint32_t iState = 0;
+
+	for (unsigned char *pByte = (unsigned char *) pTame; 
+	     *pByte && !pHits->bEvery; pByte++)
+	{
+		uint32_t iNext;
+
+		while (!(iNext = WildSetEdge(pSet, iState, *pByte)) && iState)
+		{
+			iState = pSet->pStates[iState].iFail;
+		}
+
+		iState = iNext;
+
+		for (uint32_t iOutput = pSet->pStates[iState].cPatterns 
+		                        ? iState : pSet->pStates[iState].iOutput;
+		     iOutput; iOutput = pSet->pStates[iOutput].iOutput)
+		{
+			WildSetHitAdd(pHits, iOutput);
+		}
+	}
+
+	return;
+}
+
+
+#if defined(WILD_SET_TEDDY)
+// Confirms the literals, in the buckets whose bits are set, ending at a 
+// tame position where Teddy found candidates.
+//
+inline void WildTeddyConfirm(WildPatternSet *pSet, char *pEnd, size_t cbAhead,
+                             unsigned int iBuckets, WildSetHits *pHits)
+{
+	while (iBuckets)
+	{
+		int iBucket = WildLowestBit(iBuckets);
+
+		for (uint32_t iTeddy = pSet->rgBucketFirst[iBucket]; 
+		     iTeddy < pSet->rgBucketFirst[iBucket + 1]; iTeddy++)
+		{
+			WildTeddyLiteral *pTeddy = &pSet->pTeddyLiterals[iTeddy];
+
+			if (pTeddy->cbLiteral <= cbAhead && 
+			    !memcmp(pEnd - pTeddy->cbLiteral, 
+			            pSet->pTeddyBytes + pTeddy->iLiteral, 
+			            pTeddy->cbLiteral))
+			{
+				WildSetHitAdd(pHits, pTeddy->iState);
+			}
+		}
+
+		iBuckets &= iBuckets - 1;
+	}
+
+	return;
+}
+
+
+// Searches a tame string for the literals of a set via Teddy, gathering 
+// their hits.  Positions too close to the end for a full vector of 
+// lookups are looked up one at a time.
+//
+WILD_TEDDY_TARGET
+void WildTeddyScan(WildPatternSet *pSet, char *pTame, WildSetHits *pHits)
+{
+	size_t  cbTame = strlen(pTame);
+	size_t  cbFingerprint = pSet->cbFingerprint;
+	size_t  iAt = 0;
+	__m128i vecNibble = _mm_set1_epi8(0x0F);
+	__m128i rgLow[WILD_TEDDY_BYTES];
+	__m128i rgHigh[WILD_TEDDY_BYTES];
+
+	for (size_t iByte = 0; iByte < cbFingerprint; iByte++)
+	{
+		rgLow[iByte] = _mm_loadu_si128((const __m128i *) 
+		                               pSet->rgTeddyLow[iByte]);
+		rgHigh[iByte] = _mm_loadu_si128((const __m128i *) 
+		                                pSet->rgTeddyHigh[iByte]);
+	}
+
+	for (; iAt + WILD_CHUNK + cbFingerprint - 1 <= cbTame && !pHits->bEvery;
+	     iAt += WILD_CHUNK)
+	{
+		__m128i vecBuckets = _mm_set1_epi8((char) 0xFF);
+		unsigned char rgBuckets[WILD_CHUNK];
+		unsigned int iCandidates;
+
+		for (size_t iByte = 0; iByte < cbFingerprint; iByte++)
+		{
+			__m128i vecTame = _mm_loadu_si128(
+			    (const __m128i *) (pTame + iAt + iByte));
+
+			vecBuckets = _mm_and_si128(vecBuckets, _mm_and_si128(
+			    _mm_shuffle_epi8(rgLow[iByte], 
+			                     _mm_and_si128(vecTame, vecNibble)),
+			    _mm_shuffle_epi8(rgHigh[iByte], _mm_and_si128(
+			        _mm_srli_epi16(vecTame, 4), vecNibble))));
+		}
+
+		iCandidates = ~_mm_movemask_epi8(_mm_cmpeq_epi8(
+		    vecBuckets, _mm_setzero_si128())) & 0xFFFF;
+
+		if (!iCandidates)
+		{
+			continue;
+		}
+
+		_mm_storeu_si128((__m128i *) rgBuckets, vecBuckets);
+
+		while (iCandidates)
+		{
+			int iCandidate = WildLowestBit(iCandidates);
+
+			WildTeddyConfirm(pSet, pTame + iAt + iCandidate + cbFingerprint, 
+			                 iAt + iCandidate + cbFingerprint, 
+			                 rgBuckets[iCandidate], pHits);
+			iCandidates &= iCandidates - 1;
+		}
+	}
+
+	for (; iAt + cbFingerprint <= cbTame && !pHits->bEvery; iAt++)
+	{
+		unsigned int iBuckets = 0xFF;
+
+		for (size_t iByte = 0; iByte < cbFingerprint; iByte++)
+		{
+			unsigned char chByte = (unsigned char) pTame[iAt + iByte];
+
+			iBuckets &= pSet->rgTeddyLow[iByte][chByte & 0x0F] & 
+			            pSet->rgTeddyHigh[iByte][chByte >> 4];
+		}
+
+		WildTeddyConfirm(pSet, pTame + iAt + cbFingerprint, 
+		                 iAt + cbFingerprint, iBuckets, pHits);
+	}
+
+	return;
+}
+#endif  // WILD_SET_TEDDY
+
+
+// Matches a tame string against one compiled pattern of a set.
+//
+inline bool WildSetVerify(WildPatternSet *pSet, uint32_t iPattern, 
+                          char *pTame)
+{
+	return FastWildPatternCompareUtf8((WildPattern *) (pSet->pPatternBytes + 
+	    pSet->pPatternOffsets[iPattern]), pTame);
+}
+
+
+// Finds the literals of a set's patterns in a tame string, as hits, and 
+// stores the indexes of the patterns for those hits, along with any 
+// patterns that have no literal content and any hashed patterns that 
+// match.  With bVerify, the patterns for the hits are matched and only 
+// those that match are stored, in ascending order.  Otherwise they're 
+// stored unmatched, in no particular order, as candidates.
+//
+size_t WildSetGather(WildPatternSet *pSet, char *pTame, size_t *piMatches, 
+                     bool bVerify)
+{
+	WildSetHits hits;
+	size_t      cMatches = WildSetIndexMatch(pSet, pTame, piMatches);
+
+	hits.pHits = hits.rgLocal;
+	hits.cHits = 0;
+	hits.cMaxHits = WILD_SET_HITS;
+	hits.bEvery = pSet->iStrategy == WILD_SET_STRATEGY_EACH;
+
+#if defined(WILD_SET_TEDDY)
+	if (pSet->iStrategy == WILD_SET_STRATEGY_TEDDY)
+	{
+		WildTeddyScan(pSet, pTame, &hits);
+	}
+	else
+#endif
+	if (pSet->iStrategy == WILD_SET_STRATEGY_AHO_CORASICK)
+	{
+		WildAhoCorasickScan(pSet, pTame, &hits);
+	}
+
+	if (hits.bEvery)
+	{
+		for (uint32_t iResidual = 0; iResidual < pSet->cResidual; iResidual++)
+		{
+			uint32_t iPattern = pSet->pResidual[iResidual];
+
+			if (!bVerify || WildSetVerify(pSet, iPattern, pTame))
+			{
+				piMatches[cMatches++] = iPattern;
+			}
+		}
+	}
+	else
+	{
+		qsort(hits.pHits, hits.cHits, sizeof(uint32_t), WildSetIndexOrder);
+
+		for (size_t iHit = 0; iHit < hits.cHits; iHit++)
+		{
+			WildSetState *pState = &pSet->pStates[hits.pHits[iHit]];
+
+			if (iHit && hits.pHits[iHit - 1] == hits.pHits[iHit])
+			{
+				continue;
+			}
+
+			for (uint32_t iIndex = pState->iFirstPattern; 
+			     iIndex < pState->iFirstPattern + pState->cPatterns; iIndex++)
+			{
+				uint32_t iPattern = pSet->pPatternIndexes[iIndex];
+
+				if (!bVerify || WildSetVerify(pSet, iPattern, pTame))
+				{
+					piMatches[cMatches++] = iPattern;
+				}
+			}
+		}
+
+		// Patterns without literal content, grouped at the root.
+		for (uint32_t iIndex = 0; iIndex < pSet->pStates->cPatterns; iIndex++)
+		{
+			uint32_t iPattern = pSet->pPatternIndexes[iIndex];
+
+			if (!bVerify || WildSetVerify(pSet, iPattern, pTame))
+			{
+				piMatches[cMatches++] = iPattern;
+			}
+		}
+	}
+
+	if (bVerify)
+	{
+		qsort(piMatches, cMatches, sizeof(size_t), WildSetMatchOrder);
+	}
+
+	if (hits.pHits != hits.rgLocal)
+	{
+		free(hits.pHits);
+	}
+
+	return cMatches;
+}
+
+
+// Matches a null-terminated UTF-8 tame string against every pattern in a 
+// set.  The literals in the tame string are found first, as hits, and 
+// then only the patterns for those hits, along with any patterns that 
+// have no literal content, are matched.  PERFORMS NO UTF-8 VALIDATION.
+//
+size_t FastWildSetCompareUtf8(WildPatternSet *pSet, char *pTame, 
+                              size_t *piMatches)
+{
+	return WildSetGather(pSet, pTame, piMatches, true);
+}
+
+
+// Stores the indexes of the patterns in a set that might match a 
+// null-terminated UTF-8 tame string, without matching them, for callers 
+// that only need some of the matches.  Returns the number of indexes 
+// stored.  PERFORMS NO UTF-8 VALIDATION.
+//
+size_t FastWildSetCandidatesUtf8(WildPatternSet *pSet, char *pTame, 
+                                 size_t *piCandidates)
+{
+	return WildSetGather(pSet, pTame, piCandidates, false);
+}
+
+
+// Matches a null-terminated UTF-8 tame string against the pattern at a 
+// given index in a set, as a candidate from FastWildSetCandidatesUtf8() 
+// is matched.  PERFORMS NO UTF-8 VALIDATION.
+//
+bool FastWildSetVerifyUtf8(WildPatternSet *pSet, size_t iPattern, 
+                           char *pTame)
+{
+	return WildSetVerify(pSet, (uint32_t) iPattern, pTame);
+}
+
+
+struct WildImageSection
+{
+	uint64_t       iOffset;        // From the start of the image
+	uint64_t       cbSection;
+};
+
+// The start of a set image.  The checksum covers every byte of the image 
+// past the first WILD_IMAGE_CHECKED, which end with the checksum itself.
+//
+struct WildImageHeader
+{
+	char           rgMagic[8];
+	uint32_t       iVersion;
+	uint32_t       iByteOrder;
+	uint64_t       cbImage;
+	uint64_t       iChecksum;
+	uint64_t       cPatterns;
+	uint32_t       iStrategy;
+	uint32_t       cStates;
+	uint32_t       cResidual;
+	uint32_t       cbFingerprint;
+	uint32_t       rgRoot[256];
+	uint32_t       rgBucketFirst[9];
+	uint32_t       rgGroups[WILD_SET_SHAPES];
+	uint32_t       rgSlotMasks[WILD_SET_SHAPES];
+	uint32_t       rgLengths[WILD_SET_SHAPES];
+	unsigned char  rgTeddyLow[WILD_TEDDY_BYTES][WILD_CHUNK];
+	unsigned char  rgTeddyHigh[WILD_TEDDY_BYTES][WILD_CHUNK];
+	WildImageSection rgSections[WILD_IMAGE_SECTIONS];
+};
+
+
+// Checksums a run of bytes, 8 bytes at a time in four independent lanes, 
+// so that checking an image takes about as long as reading it.
+//
+uint64_t WildImageChecksum(const unsigned char *pBytes, size_t cbBytes)
+{
+	uint64_t rgLanes[4] = { WILD_HASH_BASIS, WILD_HASH_BASIS + 1, 
+	                        WILD_HASH_BASIS + 2, WILD_HASH_BASIS + 3 };
+	uint64_t iSum = cbBytes;
+	size_t   iByte = 0;
+
+	for (; iByte + 32 <= cbBytes; iByte += 32)
+	{
+		for (int iLane = 0; iLane < 4; iLane++)
+		{
+			uint64_t iWord;
+
+			memcpy(&iWord, pBytes + iByte + 8 * iLane, 8);
+			rgLanes[iLane] = (rgLanes[iLane] ^ iWord) * WILD_HASH_PRIME;
+			rgLanes[iLane] ^= rgLanes[iLane] >> 29;
+		}
+	}
+
+	for (; iByte < cbBytes; iByte++)
+	{
+		rgLanes[0] = WildHashStep(rgLanes[0], pBytes[iByte]);
+	}
+
+	for (int iLane = 0; iLane < 4; iLane++)
+	{
+		iSum = (iSum ^ rgLanes[iLane]) * WILD_HASH_PRIME;
+		iSum ^= iSum >> 32;
+	}
+
+	return iSum;
+}
+
+
+// Rounds an image offset up to the next section boundary.
+//
+inline uint64_t WildImageAlign(uint64_t iOffset)
+{
+	return (iOffset + WILD_IMAGE_ALIGN - 1) & ~(uint64_t) (WILD_IMAGE_ALIGN - 1);
+}
+
+
+// Compiles a set of null-terminated UTF-8 patterns, as with 
+// FastWildSetCompileStrategy(), and lays the set out as an image in one 
+// allocation, which the caller frees via free().  The image holds the 
+// set's compiled patterns along with its tables, none of which hold 
+// addresses, so the image comes out the same every time.  The image can be 
+// written to a file and mapped, or passed straight to FastWildSetMap(). 
+// Returns NULL if memory for the set or image can't be allocated, or if 
+// the set would take 4 GB or more.
+//
+void *FastWildSetImage(char **ppWild, size_t cWild, int iStrategy, 
+                       size_t *pcbImage)
+{
+	WildPatternSet  *pSet = FastWildSetCompileThreads(ppWild, cWild, 
+	                                                  iStrategy, NULL, 0);
+	WildImageHeader *pHeader;
+	size_t           rgFields[WILD_IMAGE_SECTIONS];
+	uint64_t         rgSizes[WILD_IMAGE_SECTIONS];
+	uint64_t         cbImage = sizeof(WildImageHeader);
+	unsigned char   *pImage = NULL;
+
+	if (!pSet)
+	{
+		return NULL;
+	}
+
+	WildSetArrays(pSet, rgFields, rgSizes);
+
+	for (int iSection = 0; iSection < WILD_IMAGE_SECTIONS; iSection++)
+	{
+		cbImage = WildImageAlign(cbImage) + rgSizes[iSection];
+	}
+
+	// Zeroed, so that the padding between sections is the same every time.
+	if (cbImage == (size_t) cbImage)
+	{
+		pImage = (unsigned char *) calloc(1, (size_t) cbImage);
+	}
+
+	if (!pImage)
+	{
+		FastWildSetFree(pSet);
+		return NULL;
+	}
+
+	pHeader = (WildImageHeader *) pImage;
+	memcpy(pHeader->rgMagic, WILD_IMAGE_MAGIC, sizeof(pHeader->rgMagic));
+	pHeader->iVersion = WILD_IMAGE_VERSION;
+	pHeader->iByteOrder = WILD_IMAGE_ORDER;
+	pHeader->cbImage = cbImage;
+	pHeader->cPatterns = cWild;
+	pHeader->iStrategy = (uint32_t) pSet->iStrategy;
+	pHeader->cStates = pSet->cStates;
+	pHeader->cResidual = pSet->cResidual;
+	pHeader->cbFingerprint = (uint32_t) pSet->cbFingerprint;
+	memcpy(pHeader->rgRoot, pSet->rgRoot, sizeof(pHeader->rgRoot));
+	memcpy(pHeader->rgBucketFirst, pSet->rgBucketFirst, 
+	       sizeof(pHeader->rgBucketFirst));
+	memcpy(pHeader->rgTeddyLow, pSet->rgTeddyLow, 
+	       sizeof(pHeader->rgTeddyLow));
+	memcpy(pHeader->rgTeddyHigh, pSet->rgTeddyHigh, 
+	       sizeof(pHeader->rgTeddyHigh));
+
+	for (int iShape = 0; iShape < WILD_SET_SHAPES; iShape++)
+	{
+		pHeader->rgGroups[iShape] = pSet->rgIndexes[iShape].cGroups;
+		pHeader->rgSlotMasks[iShape] = pSet->rgIndexes[iShape].iSlotMask;
+		pHeader->rgLengths[iShape] = pSet->rgIndexes[iShape].cLengths;
+	}
+
+	cbImage = sizeof(WildImageHeader);
+
+	for (int iSection = 0; iSection < WILD_IMAGE_SECTIONS; iSection++)
+	{
+		void *pArray = WildSetArrayGet(pSet, rgFields[iSection]);
+
+		pHeader->rgSections[iSection].iOffset = WildImageAlign(cbImage);
+		pHeader->rgSections[iSection].cbSection = rgSizes[iSection];
+		cbImage = pHeader->rgSections[iSection].iOffset + rgSizes[iSection];
+
+		if (pArray)
+		{
+			memcpy(pImage + pHeader->rgSections[iSection].iOffset, pArray, 
+			       (size_t) rgSizes[iSection]);
+		}
+	}
+
+	pHeader->iChecksum = WildImageChecksum(pImage + WILD_IMAGE_CHECKED, 
+	                                       (size_t) cbImage - 
+	                                       WILD_IMAGE_CHECKED);
+	FastWildSetFree(pSet);
+	*pcbImage = (size_t) cbImage;
+	return pImage;
+}
+
+
+// Compiles an array of null-terminated UTF-8 patterns into a set image, as 
+// with FastWildSetImage(), and writes it to a file.  Returns false if the 
+// image can't be built or the file can't be written.
+//
+bool FastWildSetSave(char **ppWild, size_t cWild, int iStrategy, 
+                     const char *pPath)
+{
+	size_t cbImage;
+	void  *pImage = FastWildSetImage(ppWild, cWild, iStrategy, &cbImage);
+	FILE  *pFile = pImage ? fopen(pPath, "wb") : NULL;
+	bool   bWritten = false;
+
+	if (pFile)
+	{
+		bWritten = fwrite(pImage, 1, cbImage, pFile) == cbImage;
+		bWritten &= fclose(pFile) == 0;
+	}
+
+	free(pImage);
+	return bWritten;
+}
+
+
+// Sets up a set over an image from FastWildSetImage(), in place.  The set's 
+// arrays and compiled patterns are all matched right in the image, which 
+// is only read, so one image can be shared by any number of threads and 
+// processes, and it must outlive the set.  Only the header and section 
+// table are parsed, and the checksum is checked, but the contents are 
+// otherwise trusted.  The image has to be 8-byte aligned, as from malloc() 
+// or a file mapping.  Returns NULL if the image isn't a valid set image 
+// for this version, or for a build with a differently sized set, or if 
+// memory for the set can't be allocated.
+//
+WildPatternSet *FastWildSetMap(void *pImage, size_t cbImage)
+{
+	WildImageHeader  *pHeader = (WildImageHeader *) pImage;
+	WildImageSection *pSections = pHeader->rgSections;
+	unsigned char    *pBytes = (unsigned char *) pImage;
+	WildPatternSet   *pSet;
+	size_t            rgFields[WILD_IMAGE_SECTIONS];
+	uint64_t          rgSizes[WILD_IMAGE_SECTIONS];
+	uint64_t          cbPatterns;
+	bool              bValid;
+
+	if (((uintptr_t) pImage & 7) || cbImage < sizeof(WildImageHeader) || 
+	    memcmp(pHeader->rgMagic, WILD_IMAGE_MAGIC, sizeof(pHeader->rgMagic)) || 
+	    pHeader->iVersion != WILD_IMAGE_VERSION || 
+	    pHeader->iByteOrder != WILD_IMAGE_ORDER || 
+	    pHeader->cbImage != cbImage || !pHeader->cStates || 
+	    pHeader->cPatterns >= UINT32_MAX || 
+	    pHeader->iStrategy > WILD_SET_STRATEGY_TEDDY || 
+	    pHeader->cbFingerprint > WILD_TEDDY_BYTES || 
+	    pSections[WILD_IMAGE_PATTERN_BYTES].cbSection > cbImage || 
+	    pHeader->iChecksum != WildImageChecksum(pBytes + WILD_IMAGE_CHECKED, 
+	                                            cbImage - WILD_IMAGE_CHECKED))
+	{
+		return NULL;
+	}
+
+	cbPatterns = pSections[WILD_IMAGE_PATTERN_BYTES].cbSection;
+	pSet = (WildPatternSet *) calloc(1, sizeof(WildPatternSet));
+
+	if (!pSet)
+	{
+		return NULL;
+	}
+
+	// The counts come from the header, except for the sizes of the 
+	// sections that vary freely, which come from the section table.
+	pSet->cPatterns = (size_t) pHeader->cPatterns;
+	pSet->iStrategy = (int) pHeader->iStrategy;
+	pSet->cStates = pHeader->cStates;
+	pSet->cResidual = pHeader->cResidual;
+	pSet->cbFingerprint = pHeader->cbFingerprint;
+	pSet->cbTeddyBytes = (size_t) pSections[WILD_IMAGE_TEDDY_BYTES].cbSection;
+	pSet->cbPatternBytes = (size_t) cbPatterns;
+	memcpy(pSet->rgRoot, pHeader->rgRoot, sizeof(pSet->rgRoot));
+	memcpy(pSet->rgBucketFirst, pHeader->rgBucketFirst, 
+	       sizeof(pSet->rgBucketFirst));
+	memcpy(pSet->rgTeddyLow, pHeader->rgTeddyLow, sizeof(pSet->rgTeddyLow));
+	memcpy(pSet->rgTeddyHigh, pHeader->rgTeddyHigh, 
+	       sizeof(pSet->rgTeddyHigh));
+	bValid = (cbPatterns != 0) == (pSet->cPatterns != 0);
+
+	for (int iShape = WILD_SET_EXACT; iShape < WILD_SET_SHAPES; iShape++)
+	{
+		WildSetIndex *pIndex = &pSet->rgIndexes[iShape];
+		int           iFirst = WILD_IMAGE_INDEXES + 
+		                       (iShape - 1) * WILD_IMAGE_INDEX_SECTIONS;
+		uint64_t      cSlots = (uint64_t) pHeader->rgSlotMasks[iShape] + 1;
+
+		pIndex->cGroups = pHeader->rgGroups[iShape];
+		pIndex->iSlotMask = pHeader->rgSlotMasks[iShape];
+		pIndex->cLengths = pHeader->rgLengths[iShape];
+		pIndex->cIndexes = (uint32_t) (pSections[iFirst + 
+		    WILD_IMAGE_INDEX_INDEXES].cbSection / sizeof(uint32_t));
+		pIndex->cbBytes = (size_t) pSections[iFirst + 
+		    WILD_IMAGE_INDEX_BYTES].cbSection;
+		bValid &= !(cSlots & (cSlots - 1)) && cSlots > pIndex->cGroups;
+	}
+
+	WildSetArrays(pSet, rgFields, rgSizes);
+
+	for (int iSection = 0; iSection < WILD_IMAGE_SECTIONS; iSection++)
+	{
+		WildImageSection *pSection = &pSections[iSection];
+
+		bValid &= !(pSection->iOffset % WILD_IMAGE_ALIGN) && 
+		          pSection->iOffset <= cbImage && 
+		          pSection->cbSection <= cbImage - pSection->iOffset && 
+		          pSection->cbSection == rgSizes[iSection];
+		WildSetArrayPut(pSet, rgFields[iSection], 
+		                bValid && pSection->cbSection 
+		                ? pBytes + pSection->iOffset : NULL);
+	}
+
+	// Every pattern has to start, aligned, within the patterns' section.
+	for (size_t iWild = 0; bValid && iWild < pSet->cPatterns; iWild++)
+	{
+		uint32_t iOffset = pSet->pPatternOffsets[iWild];
+
+		bValid = iOffset < cbPatterns && !(iOffset % WILD_SET_ALIGN);
+	}
+
+	if (!bValid)
+	{
+		free(pSet);
+		return NULL;
+	}
+
+	pSet->cbBlock = sizeof(WildPatternSet);
+
+	// The automaton is always built, so it can stand in for Teddy.
+	if (pSet->iStrategy == WILD_SET_STRATEGY_TEDDY && !WildTeddySupported())
+	{
+		pSet->iStrategy = WILD_SET_STRATEGY_AHO_CORASICK;
+	}
+
+	pSet->pImage = pImage;
+	pSet->cbImage = cbImage;
+	return pSet;
+}
+
+
+// Maps a file written by FastWildSetSave(), read-only, and sets up a set 
+// over it via FastWildSetMap().  The mapping is released along with the 
+// set.  Processes that load the same file share its pages.  Returns NULL 
+// if the file can't be mapped or isn't a valid set image.
+//
+WildPatternSet *FastWildSetLoad(const char *pPath)
+{
+	WildPatternSet *pSet = NULL;
+	void           *pImage = NULL;
+	size_t          cbImage = 0;
+
+#if defined(_WIN32)
+	HANDLE          hFile = CreateFileA(pPath, GENERIC_READ, FILE_SHARE_READ, 
+	                                    NULL, OPEN_EXISTING, 
+	                                    FILE_ATTRIBUTE_NORMAL, NULL);
+	HANDLE          hMapping = NULL;
+	LARGE_INTEGER   cbFile;
+
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return NULL;
+	}
+
+	if (GetFileSizeEx(hFile, &cbFile) && cbFile.QuadPart && 
+	    (uint64_t) cbFile.QuadPart == (size_t) cbFile.QuadPart)
+	{
+		cbImage = (size_t) cbFile.QuadPart;
+		hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	}
+
+	if (hMapping)
+	{
+		pImage = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(hMapping);
+	}
+
+	CloseHandle(hFile);
+
+	if (pImage && !(pSet = FastWildSetMap(pImage, cbImage)))
+	{
+		UnmapViewOfFile(pImage);
+	}
+#else
+	int             iFile = open(pPath, O_RDONLY);
+	struct stat     fileStat;
+
+	if (iFile < 0)
+	{
+		return NULL;
+	}
+
+	if (!fstat(iFile, &fileStat) && fileStat.st_size > 0 && 
+	    (uint64_t) fileStat.st_size == (size_t) fileStat.st_size)
+	{
+		cbImage = (size_t) fileStat.st_size;
+		pImage = mmap(NULL, cbImage, PROT_READ, MAP_SHARED, iFile, 0);
+		pImage = pImage == MAP_FAILED ? NULL : pImage;
+	}
+
+	close(iFile);
+
+	if (pImage && !(pSet = FastWildSetMap(pImage, cbImage)))
+	{
+		munmap(pImage, cbImage);
+	}
+#endif
+
+	if (pSet)
+	{
+		pSet->bMapped = true;
+	}
+
+	return pSet;
+}
+
+
+// Returns the bytes that a set occupies, including its compiled patterns, 
+// and its image, for a set mapped from one.
+//
+size_t FastWildSetBytes(WildPatternSet *pSet)
+{
+	return pSet->pImage ? pSet->cbBlock + pSet->cbImage : pSet->cbBlock;
+}
+
+
+// Releases a set, along with its compiled patterns, unless it's in an 
+// arena, or, for a set mapped from an image, along with the file mapping 
+// it was loaded from, if any.
+//
+void FastWildSetFree(WildPatternSet *pSet)
+{
+	if (!pSet)
+	{
+		return;
+	}
+	else if (pSet->pImage)
+	{
+		if (pSet->bMapped)
+		{
+#if defined(_WIN32)
+			UnmapViewOfFile(pSet->pImage);
+#else
+			munmap(pSet->pImage, pSet->cbImage);
+#endif
+		}
+
+		free(pSet);                  // Just the set
+	}
+	else if (!pSet->bArena)
+	{
+		free(pSet);                  // The set's whole block
+	}
+
+	return;
+}
@@ -0,0 +1,79 @@
+// Sets of UTF-8-ready wildcard patterns, for matching one string against 
+// many patterns at once.
+//
+// A set is compiled once, by FastWildSetCompile(), from an array of 
+// null-terminated patterns.  FastWildSetCompareUtf8() stores, in ascending 
+// order, the index of every pattern that FastWildCompareUtf8() would match 
+// against the tame string, and returns the number of indexes stored.  The 
+// piMatches array needs room for one index per pattern in the set.
+//
+// FastWildSetCandidatesUtf8() stores, in no particular order, the indexes 
+// of the patterns that survive the set's prefiltering, without matching 
+// them.  Every pattern that matches is among them.  It's for callers that 
+// need only some of the matches, such as the first by priority, and that 
+// match candidates one at a time via FastWildSetVerifyUtf8(), which uses 
+// the set's own copy of the pattern.
+//
+// A compiled set occupies one block of memory, which holds its compiled 
+// patterns along with its tables, all linked by 32-bit offsets, so that 
+// releasing it takes one free().  FastWildSetCompileArena() puts that 
+// block in an arena from FastWildArenaCreate(), to be released along with 
+// the arena.  FastWildSetBytes() reports the bytes a set occupies.
+//
+// Sets of many thousands of patterns are compiled on one thread per 
+// processor, and FastWildSetCompileThreads() sets the number of threads, 
+// where 0 picks it automatically and 1 compiles on the calling thread.  
+// A set comes out the same however many threads compile it.
+//
+// A compiled set can be saved as an image, by FastWildSetSave(), and 
+// loaded back by FastWildSetLoad(), which maps the file read-only and 
+// matches against its tables in place, with no parsing beyond its header.  
+// Worker processes that load the same file share its pages.  
+// FastWildSetImage() and FastWildSetMap() do the same for images in 
+// memory.  The image holds the set's compiled patterns as well, which a 
+// loaded set matches in place too, without copying or compiling them 
+// again, so that it matches just as the compiled set does.  Images are 
+// checksummed, but are otherwise trusted, and they're only portable among 
+// builds with the same byte order and pointer size.
+//
+// A set is matched via one of the following strategies, which can be 
+// picked for it at compile time.  FastWildSetStrategy() returns the one in 
+// effect, since Teddy needs an x86 CPU with SSSE3, which is checked at run 
+// time, and is limited to 64 distinct literals (32 when picked 
+// automatically).  The automaton is used in its place.
+//
+// When the strategy is picked automatically for a set of more than 32 
+// patterns, patterns whose only wildcards are leading or trailing stars 
+// ("name", "dir/*", "*.ext") are looked up by hashing instead, and the 
+// strategy is picked for the rest of the patterns.
+#define WILD_SET_STRATEGY_AUTO          0
+#define WILD_SET_STRATEGY_EACH          1   // Match each pattern in turn
+#define WILD_SET_STRATEGY_AHO_CORASICK  2   // Aho-Corasick literal search
+#define WILD_SET_STRATEGY_TEDDY         3   // SIMD literal search
+
+struct WildArena;
+struct WildPatternSet;
+
+WildPatternSet *FastWildSetCompile(char **ppWild, size_t cWild);
+WildPatternSet *FastWildSetCompileStrategy(char **ppWild, size_t cWild, 
+                                           int iStrategy);
+WildPatternSet *FastWildSetCompileArena(char **ppWild, size_t cWild, 
+                                        int iStrategy, WildArena *pArena);
+WildPatternSet *FastWildSetCompileThreads(char **ppWild, size_t cWild, 
+                                          int iStrategy, WildArena *pArena, 
+                                          unsigned cThreads);
+int FastWildSetStrategy(WildPatternSet *pSet);
+size_t FastWildSetCompareUtf8(WildPatternSet *pSet, char *pTame, 
+                              size_t *piMatches);
+size_t FastWildSetCandidatesUtf8(WildPatternSet *pSet, char *pTame, 
+                                 size_t *piCandidates);
+bool FastWildSetVerifyUtf8(WildPatternSet *pSet, size_t iPattern, 
+                          char *pTame);
+void *FastWildSetImage(char **ppWild, size_t cWild, int iStrategy, 
+                       size_t *pcbImage);
+bool FastWildSetSave(char **ppWild, size_t cWild, int iStrategy, 
+                     const char *pPath);
+WildPatternSet *FastWildSetMap(void *pImage, size_t cbImage);
+WildPatternSet *FastWildSetLoad(const char *pPath);
+size_t FastWildSetBytes(WildPatternSet *pSet);
+void FastWildSetFree(WildPatternSet *pSet);
@@ -0,0 +1,118 @@
+// Inline UTF-8 code point helpers shared by the routines for matching 
+// wildcards.
+//
+#if !defined(FASTWILDUTF8_H)
+#define FASTWILDUTF8_H
+
+#include <stddef.h>
+
+// The following values are set according to the UTF-8 encoding standard 
+// described at
+//
+//     https://en.wikipedia.org/wiki/UTF-8#Description
+//
+// Effectively, the number of bytes after a sequence of leading 1's, at  
+// the start of a code point, is limited to the maximum value of that 
+// first byte, given that the leading 1's are followed by a 0, followed 
+// by further 1's to complete the byte.
+//
+/* NOT VALIDATED HERE    0x7F */ // 0nnnnnnn  (an entire 1-byte code point)
+#define SINGLETON_LIMIT  0xBF    // 10nnnnnn  (an intra-code-point byte)
+#define TWOFER_LIMIT     0xDF    // 110nnnnn  (first of a 2-byte code point)
+#define THREESOME_LIMIT  0xEF    // 1110nnnn  (first of a 3-byte code point)
+
+// Returns the number of bytes in the UTF-8 code point that starts with a 
+// given byte.  PERFORMS NO UTF-8 VALIDATION.
+//
+inline size_t CodePointBytes(unsigned char chLead)
+{
+	return 1 + (chLead > SINGLETON_LIMIT) + (chLead > TWOFER_LIMIT) + 
+	       (chLead > THREESOME_LIMIT);
+}
+
+
+// Given a pointer to a UTF-8 code point, advances it to any next UTF-8 code 
+// point.  Returns true if there is a further code point, or false if the 
+// next content is a terminating null.  PERFORMS NO UTF-8 VALIDATION OTHER
+// THAN NULL CHECKING.
+//
+inline bool CodePointAdvance(char **ppContent)
+{
+	*ppContent += (*(unsigned char *) *ppContent > 0) +
+	    ((*(unsigned char *) *ppContent > SINGLETON_LIMIT) && 
+	        *(1 + *ppContent)) +
+	    ((*(unsigned char *) *ppContent > TWOFER_LIMIT) && 
+	        *(2 + *ppContent)) +
+		((*(unsigned char *) *ppContent > THREESOME_LIMIT) && 
+	        *(3 + *ppContent));
+	return (bool) **ppContent;
+}
+
+
+// Compares two UTF-8 code points.  Returns true if the code points are 
+// identical.  Returns false otherwise.  PERFORMS NO UTF-8 VALIDATION.
+//
+inline bool CodePointCompare(char *pContentA, char *pContentB)
+{
+	if (*pContentA != *pContentB)
+	{
+		return false;
+	}
+	else if (*(unsigned char *) pContentA > SINGLETON_LIMIT &&
+	         *(1 + pContentA) != *(1 + pContentB))
+	{
+		return false;
+	}
+	else if (*(unsigned char *) pContentA > TWOFER_LIMIT &&
+	         *(2 + pContentA) != *(2 + pContentB))
+	{
+		return false;
+	}
+	else if (*(unsigned char *) pContentA > THREESOME_LIMIT &&
+	         *(3 + pContentA) != *(3 + pContentB))
+	{
+		return false;
+	}
+	
+	return true;
+}
+
+
+// Compares two UTF-8 code points.  Advances the second pointer to any next 
+// UTF-8 code point.  Returns true if the code points are identical.  Returns 
+// false otherwise.  PERFORMS NO UTF-8 VALIDATION.
+//
+inline bool CodePointAdvanceAndCompare(char *pContentA, char **ppContentB)
+{
+	*ppContentB += (*(unsigned char *) *ppContentB > 0) +
+		((*(unsigned char *) *ppContentB > SINGLETON_LIMIT) && 
+		    *(1 + *ppContentB)) +
+		((*(unsigned char *) *ppContentB > TWOFER_LIMIT) && 
+		    *(2 + *ppContentB)) +
+		((*(unsigned char *) *ppContentB > THREESOME_LIMIT) && 
+		    *(3 + *ppContentB));
+
+	if (*pContentA != **ppContentB)
+	{
+		return false;
+	}
+	else if (*(unsigned char *) pContentA > SINGLETON_LIMIT &&
+		*(1 + pContentA) != *(1 + *ppContentB))
+	{
+		return false;
+	}
+	else if (*(unsigned char *) pContentA > TWOFER_LIMIT &&
+		*(2 + pContentA) != *(2 + *ppContentB))
+	{
+		return false;
+	}
+	else if (*(unsigned char *) pContentA > THREESOME_LIMIT &&
+		*(3 + pContentA) != *(3 + *ppContentB))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+#endif  // FASTWILDUTF8_H
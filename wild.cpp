@@ -20,7 +20,10 @@
 //
 // This file provides sets of correctness and performance tests, for 
 // matching wildcards in C/C++, along with a main() routine that invokes 
-// the testcases and outputs the results.
+// the testcases and outputs the results.  wildsetbuild.cpp has a main() 
+// of its own, so build the tests without it:
+//
+//     g++ -O2 -o wild wild.cpp fastwild*.cpp -lpthread
 //
 // File-scope testcase selection flags.
 //
@@ -33,15 +36,124 @@
 #define COMPARE_TAME                1
 #define COMPARE_EMPTY               1
 #define COMPARE_UTF8                1
+#define COMPARE_JIT                 1
+#define COMPARE_BATCH               1
+#define COMPARE_PATTERN             1
+#define COMPARE_SET                 1
+#define COMPARE_NFA                 1
+#define COMPARE_RULES               1
+#define COMPARE_PRUNE               1
+#define COMPARE_CACHE               1
+#define COMPARE_MEMO                1
+#define COMPARE_LIVE                1
+#define COMPARE_IMAGE               1
+#define COMPARE_ARENA               1
+#define COMPARE_PARALLEL            1
+#define COMPARE_CAPTURE             1
+#define COMPARE_REWRITE             1
+#define COMPARE_SEARCH              1
+#define COMPARE_PARTIAL             1
+#define COMPARE_FILTER              1
+#define COMPARE_PATH                1
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include "fastwildcompare.h"
 
+#if defined(COMPARE_JIT)
+#include "fastwildjit.h"
+#endif
+
+#if defined(COMPARE_BATCH)
+#include "fastwildbatch.h"
+#endif
+
+#if defined(COMPARE_PATTERN)
+#include "fastwildpattern.h"
+#endif
+
+#if defined(COMPARE_SET)
+#include "fastwildset.h"
+#endif
+
+#if defined(COMPARE_NFA)
+#include "fastwildnfa.h"
+#endif
+
+#if defined(COMPARE_RULES)
+#include "fastwildrules.h"
+#endif
+
+#if defined(COMPARE_PRUNE)
+#include "fastwildprune.h"
+#endif
+
+#if defined(COMPARE_CACHE)
+#include "fastwildcache.h"
+#endif
+
+#if defined(COMPARE_MEMO)
+#include "fastwildmemo.h"
+#endif
+
+#if defined(COMPARE_LIVE)
+#include "fastwildset.h"
+#include "fastwildlive.h"
+#endif
+
+#if defined(COMPARE_IMAGE)
+#include "fastwildset.h"
+#endif
+
+#if defined(COMPARE_ARENA)
+#include "fastwildarena.h"
+#include "fastwildpattern.h"
+#include "fastwildset.h"
+#endif
+
+#if defined(COMPARE_PARALLEL)
+#include "fastwildset.h"
+#endif
+
+#if defined(COMPARE_CAPTURE)
+#include "fastwildcapture.h"
+#endif
+
+#if defined(COMPARE_REWRITE)
+#include "fastwildarena.h"
+#include "fastwildcapture.h"
+#include "fastwildrewrite.h"
+#endif
+
+#if defined(COMPARE_SEARCH)
+#include "fastwildcapture.h"
+#include "fastwildsearch.h"
+#endif
+
+#if defined(COMPARE_PARTIAL)
+#include "fastwildpartial.h"
+#endif
+
+#if defined(COMPARE_FILTER)
+#include "fastwildfilter.h"
+#endif
+
+#if defined(COMPARE_PATH)
+#include "fastwildpath.h"
+#endif
+
 #if defined(COMPARE_PERFORMANCE)
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
 #include <stdint.h>
+#include <atomic>
 #include <chrono>
 #include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 // File-scope variables for low-latency accumulation of performance data.
 //
@@ -122,10 +234,64 @@ bool test(char *pTame, char *pWild, bool bExpectedResult)
             timeFinish - timeStart)).count();
 #endif  // COMPARE_PERFORMANCE
 
+#if defined(COMPARE_JIT) && !defined(COMPARE_PERFORMANCE)
+    // Compiling per call is only for correctness; see benchjit() for timing.
+    WildJitPattern *pJitPattern = FastWildJitCompile(pWild);
+
+    if (bExpectedResult != FastWildJitCompareUtf8(pJitPattern, pTame))
+    {
+        bPassed = false;
+    }
+
+    FastWildJitFree(pJitPattern);
+#endif  // COMPARE_JIT
+
+#if defined(COMPARE_PATTERN) && !defined(COMPARE_PERFORMANCE)
+    // Likewise, see benchpattern() for timing of compiled patterns.
+    WildPattern *pPattern = FastWildPatternCompile(pWild);
+
+    if (bExpectedResult != FastWildPatternCompareUtf8(pPattern, pTame))
+    {
+        bPassed = false;
+    }
+
+    FastWildPatternFree(pPattern);
+#endif  // COMPARE_PATTERN
+
 	return bPassed;
 }
 
 
+// Tame and wild strings for cross-checking routines that match many 
+// strings, or many patterns, at once against FastWildCompareUtf8().
+//
+static char *rgCorpusTame[] =
+{
+    "", "a", "ab", "abc", "abcd", "abcde", "abcccd", "caaab", "aaaaa", 
+    "mississippi", "mississipissippi", "miSsissippi", "mississipPI", 
+    "xyxyxyzyxyz", "xxxxzzzzzzzzyf", "a*abab", "a*r", "*abc*", "bLah", 
+    "abcabcdabcdabcabcdabcdabcabcdabcabcabcd", 
+    "abababababababababababababababababababaacacacacaca\
+cacadaeafagahaiajakalaaaaaaaaaaaaaaaaaffafagaagggagaaaaaaaab", 
+    "src/lib/fastwildcompare.cpp", "docs/readme.md", "logs/2025/app.txt", 
+    "🐂🚀♥🍀貔貅🦁★□√🚦€¥☯🐴😊🍓🐕🎺🧊☀☂🐉", "𓋍𓋔𓎍", "ḪؿꜪἪꜿ", 
+    "Мне нужно выучить русский язык, чтобы лучше оценить Пушкина.", 
+};
+
+static char *rgCorpusWild[] =
+{
+    "", "*", "?", "a", "*?", "??", "abc", "ab*d", "*ccd", "*a?b", "*aa?", 
+    "mi*sip*", "*issip*PI", "*issip*ss*", "*sip*", "xy*z*xyz", 
+    "a*a*a*a*b", "*a*b*ba*ca*a*aa*aaa*fa*ga*b*", "?b*??", "?**?c?", 
+    "abcabc?abc?abcabc?abc?abc?bc?abc?bc?bcd", "a*", "*c", "*b*", 
+    "a*b", "a*r", "***a*b*c***", "bL?h", "*.cpp", "src/*", "*/*.txt", 
+    "logs/*/*.txt", "*☂🐉", "𓋍𓋔?", "?ؿꜪ*ꜿ", "Мне нужно выучить * язык*", 
+};
+
+#define CORPUS_TAMES  (sizeof(rgCorpusTame) / sizeof(rgCorpusTame[0]))
+#define CORPUS_WILDS  (sizeof(rgCorpusWild) / sizeof(rgCorpusWild[0]))
+
+
 // A set of wildcard comparison tests.
 //
 void testwild(void)
@@ -572,6 +738,19 @@ void testutf8(void)
 	bAllPassed &= test("⚛⚖☁O", "⚛⚖☁0", false);
 	bAllPassed &= test("गते गते पारगते पारसंगते बोधि स्वाहा", 
 	                     "गते गते पारगते प????गते बोधि स्वाहा", true);
+
+	// Multiple-byte code points under '?' shift the rest of a compiled 
+	// template, even across its 16-byte chunks.
+	bAllPassed &= test("é€😊abcdefghijklmnopqrstuvwxyz", 
+	                     "???abcdefghijklmnopqrstuvwxyz", true);
+	bAllPassed &= test("é€😊abcdefghijklmnopqrstuvwxyz", 
+	                     "???abcdefghijklmnopqrstuvwxy", false);
+	bAllPassed &= test("aé€😊bcdefghijklmnopqrstuvwxyz", "a???bcdefghijkl*", 
+	                     true);
+	bAllPassed &= test("aé€bcdefghijklmnopqrstuvwxyz", "a???bcdefghijkl*", 
+	                     false);
+	bAllPassed &= test("abcdefghijklmnop€qrstuvwxyz", "abcdefghijklmnop?q*??", 
+	                     true);
 	bAllPassed &= test(
 	    "Мне нужно выучить русский язык, чтобы лучше оценить Пушкина.", 
 	    "Мне нужно выучить * язык, чтобы лучше оценить *.", true);
@@ -596,6 +775,12 @@ void testutf8(void)
 	bAllPassed &= test("ḪؿꜪἪꜿ", "ЬḪؿꜪἪꜿ", false);
 	bAllPassed &= test("ḪؿꜪἪꜿ", "?ؿꜪ*ꜿ", true);
 
+	// These tests involve '?' wildcards, after a '*', that each have to 
+	// cover a whole multiple-byte code point on fallback.
+	bAllPassed &= test("€aé€", "*??a*", false);
+	bAllPassed &= test("€€😊ba", "*??b*", true);
+	bAllPassed &= test("😊€b€", "*???b?", false);
+
     if (bAllPassed)
     {
         printf("Passed UTF-8 tests\n");
@@ -609,61 +794,4405 @@ void testutf8(void)
 }
 
 
-int main(void)
-{
 #if defined(COMPARE_PERFORMANCE)
-	// Clear accumulated times and the UTF-8 test status flag.
-	iAccumulatedTimeUtf8 = iAccumulatedTimeLenUtf8 = iAccumulatedTimeAscii = 0;
-#endif
+// Returns the average time, in nanoseconds, of one call to a routine that's 
+// run over the same inputs nReps times.
+//
+template <typename Routine>
+double averagenanoseconds(int nReps, Routine routine)
+{
+    std::chrono::time_point<std::chrono::high_resolution_clock> timeStart =
+        std::chrono::high_resolution_clock::now();
 
-#if defined(COMPARE_TAME)
-	testtame();
-#endif
+    for (int iRep = 0; iRep < nReps; iRep++)
+    {
+        routine();
+    }
 
-#if defined(COMPARE_EMPTY)
-	testempty();
-#endif
+    std::chrono::time_point<std::chrono::high_resolution_clock> timeFinish =
+        std::chrono::high_resolution_clock::now();
+    return (double) (std::chrono::duration_cast<std::chrono::nanoseconds>(
+        timeFinish - timeStart)).count() / nReps;
+}
+#endif  // COMPARE_PERFORMANCE
 
-#if defined(COMPARE_WILD)
-	testwild();
-#endif
 
-#if defined(COMPARE_UTF8)
-	testutf8();
+#if defined(COMPARE_BATCH)
+// Checks interleaved and lane-parallel batch matching against 
+// one-at-a-time matching.
+//
+void testbatch(void)
+{
+    bool bAllPassed = true;
+    bool rgResults[CORPUS_TAMES];
+
+    for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+    {
+        FastWildCompareUtf8Batch(rgCorpusWild[iWild], rgCorpusTame, 
+                                 rgResults, CORPUS_TAMES);
+
+        for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+        {
+            bAllPassed &= rgResults[iTame] == 
+                FastWildCompareUtf8(rgCorpusWild[iWild], rgCorpusTame[iTame]);
+        }
+
+        FastWildCompareUtf8Lanes(rgCorpusWild[iWild], rgCorpusTame, 
+                                 rgResults, CORPUS_TAMES);
+
+        for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+        {
+            bAllPassed &= rgResults[iTame] == 
+                FastWildCompareUtf8(rgCorpusWild[iWild], rgCorpusTame[iTame]);
+        }
+    }
+
+    // The state machine steps each '?' after a '*' over a whole code 
+    // point on fallback, as FastWildCompareUtf8() does.
+    static char *rgFallback[] = { "€aé€", "€€😊ba", "😊€b€" };
+    static char *rgFallbackWild[] = { "*??a*", "*??b*", "*???b?" };
+
+    for (size_t iCase = 0; iCase < 3; iCase++)
+    {
+        FastWildCompareUtf8Batch(rgFallbackWild[iCase], rgFallback, 
+                                 rgResults, 3);
+        bAllPassed &= rgResults[iCase] == (iCase == 1);
+    }
+
+    // Lanes drop out on reaching a tail of '*', and strings still 
+    // undecided after 64 bytes are matched one at a time.
+    static char rgLong[20][101];
+    char *rgLongTame[20];
+    static char *rgLongWild[] = { "a*", "a*b", "*a?", "a?*" };
+
+    for (size_t iTame = 0; iTame < 20; iTame++)
+    {
+        size_t cbTame = iTame * 5;
+
+        memset(rgLong[iTame], 'a', cbTame);
+        rgLong[iTame][cbTame] = '\0';
+
+        if (iTame & 1)
+        {
+            rgLong[iTame][cbTame - 1] = 'b';
+        }
+
+        rgLongTame[iTame] = rgLong[iTame];
+    }
+
+    for (size_t iWild = 0; iWild < 4; iWild++)
+    {
+        FastWildCompareUtf8Lanes(rgLongWild[iWild], rgLongTame, rgResults, 
+                                 20);
+
+        for (size_t iTame = 0; iTame < 20; iTame++)
+        {
+            bAllPassed &= rgResults[iTame] == 
+                FastWildCompareUtf8(rgLongWild[iWild], rgLongTame[iTame]);
+        }
+    }
+
+    if (bAllPassed)
+    {
+        printf("Passed batch tests\n");
+    }
+    else
+    {
+        printf("Failed batch tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_BATCH
+
+
+#if defined(COMPARE_SET)
+// Cross-checks a set of all the corpus patterns against 
+// FastWildCompareUtf8(), for every corpus tame string.
+//
+void testset(void)
+{
+    bool bAllPassed = true;
+    size_t rgMatches[CORPUS_WILDS];
+    WildPatternSet *pSet = NULL;
+
+    // Each strategy is forced in turn.  Teddy falls back to the automaton 
+    // only on CPUs without SSSE3.
+    for (int iStrategy = WILD_SET_STRATEGY_AUTO; 
+         iStrategy <= WILD_SET_STRATEGY_TEDDY; iStrategy++)
+    {
+        int iExpected = iStrategy;
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+        if (iStrategy == WILD_SET_STRATEGY_TEDDY && 
+            !__builtin_cpu_supports("ssse3"))
+        {
+            iExpected = WILD_SET_STRATEGY_AHO_CORASICK;
+        }
+#else
+        if (iStrategy == WILD_SET_STRATEGY_TEDDY)
+        {
+            iExpected = WILD_SET_STRATEGY_AHO_CORASICK;
+        }
 #endif
 
-#if defined(COMPARE_PERFORMANCE)
-    // Timings have been accumulated via file-scope data.
-    double fBase = 10.0;
-    double fExpNanoseconds = 9.0;
-    double fExpMilliseconds = 3.0;
+        FastWildSetFree(pSet);
+        pSet = FastWildSetCompileStrategy(rgCorpusWild, CORPUS_WILDS, 
+                                          iStrategy);
+        bAllPassed &= pSet && (iStrategy == WILD_SET_STRATEGY_AUTO || 
+                               FastWildSetStrategy(pSet) == iExpected);
 
-    // Represent the timings in seconds, to millisecond precision.
-    double fTimeCumulativeAsciiVersion = 
-            ((double) (iAccumulatedTimeAscii) /
-                pow(fBase, fExpNanoseconds)) * pow(fBase, fExpMilliseconds);
-    double fTimeCumulativeUtf8Version = 
-            ((double) (iAccumulatedTimeUtf8) /
-                pow(fBase, fExpNanoseconds)) * pow(fBase, fExpMilliseconds);
-    double fTimeCumulativeLenUtf8Version = 
-            ((double) (iAccumulatedTimeLenUtf8) /
-                pow(fBase, fExpNanoseconds)) * pow(fBase, fExpMilliseconds);
-    // Can set up similar calculations for more performance comparisons.
+        for (size_t iTame = 0; pSet && iTame < CORPUS_TAMES; iTame++)
+        {
+            size_t cMatches = FastWildSetCompareUtf8(pSet, 
+                                                     rgCorpusTame[iTame], 
+                                                     rgMatches);
+            size_t iMatch = 0;
 
-    float fAsciiVersionTimeInSeconds = fTimeCumulativeAsciiVersion / 1000;
-    float fUtf8VersionTimeInSeconds = fTimeCumulativeUtf8Version / 1000;
-    float fUtf8LenVersionTimeInSeconds = fTimeCumulativeLenUtf8Version / 1000;
+            for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+            {
+                bool bMatched = iMatch < cMatches && 
+                                rgMatches[iMatch] == iWild;
 
-    // Show the timing results.
-    printf(
-       "FastWildCompare() - for ASCII strings: %.3f seconds\n",
-           fAsciiVersionTimeInSeconds);
-    printf(
-       "FastWildCompareUtf8() - for UTF-8-encoded strings: %.3f seconds\n",
-           fUtf8VersionTimeInSeconds);
-    printf(
-       "FastWildLenCompareUtf8() - for UTF-8-encoded strings: %.3f seconds\n",
-           fUtf8LenVersionTimeInSeconds);
+                bAllPassed &= bMatched == FastWildCompareUtf8(
+                    rgCorpusWild[iWild], rgCorpusTame[iTame]);
+                iMatch += bMatched;
+            }
+
+            bAllPassed &= iMatch == cMatches;
+        }
+    }
+
+    // A set whose only exact pattern is empty has no literal bytes at all.
+    static char *rgEmpty[] = { "", "*x", "a*" };
+    WildPatternSet *pEmpty = FastWildSetCompile(rgEmpty, 3);
+
+    bAllPassed &= pEmpty && 
+                  FastWildSetCompareUtf8(pEmpty, "", rgMatches) == 1 && 
+                  rgMatches[0] == 0 && 
+                  FastWildSetCompareUtf8(pEmpty, "ax", rgMatches) == 2;
+    FastWildSetFree(pEmpty);
+
+    if (pSet && bAllPassed)
+    {
+        printf("Passed set tests\n");
+    }
+    else
+    {
+        printf("Failed set tests\n");
+    }
+
+    FastWildSetFree(pSet);
+    return;
+}
+#endif  // COMPARE_SET
+
+
+#if defined(COMPARE_NFA)
+// Cross-checks an automaton of all the corpus patterns against 
+// FastWildCompareUtf8(), for every corpus tame string.
+//
+void testnfa(void)
+{
+    bool bAllPassed = true;
+    uint64_t rgMatches[(CORPUS_WILDS + 63) / 64];
+    uint64_t rgReused[(CORPUS_WILDS + 63) / 64];
+    WildNfaSet *pNfa = FastWildNfaCompile(rgCorpusWild, CORPUS_WILDS);
+    uint64_t *pState = pNfa ? 
+        (uint64_t *) malloc(FastWildNfaStateWords(pNfa) * sizeof(uint64_t)) : 
+        NULL;
+
+    for (size_t iTame = 0; pState && iTame < CORPUS_TAMES; iTame++)
+    {
+        FastWildNfaCompareUtf8(pNfa, rgCorpusTame[iTame], rgMatches);
+
+        for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+        {
+            bAllPassed &= (bool) ((rgMatches[iWild / 64] >> (iWild % 64)) & 1)
+                == FastWildCompareUtf8(rgCorpusWild[iWild], rgCorpusTame[iTame]);
+        }
+
+        // State passed in, and reused, matches the same way.
+        FastWildNfaCompareUtf8State(pNfa, rgCorpusTame[iTame], rgReused, 
+                                    pState);
+        bAllPassed &= !memcmp(rgMatches, rgReused, sizeof(rgMatches));
+    }
+
+    if (pState && bAllPassed)
+    {
+        printf("Passed NFA tests\n");
+    }
+    else
+    {
+        printf("Failed NFA tests\n");
+    }
+
+    free(pState);
+    FastWildNfaFree(pNfa);
+    return;
+}
+#endif  // COMPARE_NFA
+
+
+#if defined(COMPARE_RULES)
+// Checks that a rule table of the corpus patterns, in three priorities, 
+// finds the lowest-indexed of the rules of the best priority that 
+// FastWildCompareUtf8() finds to match, for every corpus tame string, 
+// before and after reordering.  Then checks that two rules of the same 
+// priority that both match give the same result however the traffic in 
+// between has reordered them.
+//
+void testrules(void)
+{
+    bool bAllPassed = true;
+    int rgPriorities[CORPUS_WILDS];
+
+    for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+    {
+        rgPriorities[iWild] = (int) (iWild % 3);
+    }
+
+    WildRuleTable *pTable = 
+        FastWildRulesCompile(rgCorpusWild, rgPriorities, CORPUS_WILDS);
+
+    for (size_t iPass = 0; pTable && iPass < 2; iPass++)
+    {
+        for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+        {
+            size_t iRule = FastWildRulesMatchUtf8(pTable, rgCorpusTame[iTame]);
+            size_t iExpected = WILD_RULE_NONE;
+            int iBest = 3;
+
+            for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+            {
+                if (rgPriorities[iWild] < iBest && 
+                    FastWildCompareUtf8(rgCorpusWild[iWild], 
+                                        rgCorpusTame[iTame]))
+                {
+                    iBest = rgPriorities[iWild];
+                    iExpected = iWild;
+                }
+            }
+
+            bAllPassed &= iRule == iExpected;
+        }
+
+        FastWildRulesReorder(pTable);
+    }
+
+    FastWildRulesFree(pTable);
+
+    // Both rules match "ab", and the traffic in between matches only the 
+    // second, so that after reordering, the second is tried first.
+    char *rgWild[] = {"a*", "*b", "x*"};
+    int rgSame[] = {1, 1, 2};
+
+    pTable = FastWildRulesCompile(rgWild, rgSame, 3);
+
+    if (pTable)
+    {
+        bAllPassed &= FastWildRulesMatchUtf8(pTable, "ab") == 0;
+
+        for (size_t iCall = 0; iCall < 10000; iCall++)
+        {
+            bAllPassed &= FastWildRulesMatchUtf8(pTable, "xb") == 1;
+        }
+
+        FastWildRulesReorder(pTable);
+        bAllPassed &= FastWildRulesMatchUtf8(pTable, "ab") == 0;
+        bAllPassed &= FastWildRulesMatchUtf8(pTable, "xa") == 2;
+    }
+
+    if (pTable && bAllPassed)
+    {
+        printf("Passed rule table tests\n");
+    }
+    else
+    {
+        printf("Failed rule table tests\n");
+    }
+
+    FastWildRulesFree(pTable);
+    return;
+}
+#endif  // COMPARE_RULES
+
+
+#if defined(COMPARE_PRUNE)
+// Checks canonical forms and containment for a few known cases, and that 
+// pruning the corpus patterns leaves every corpus tame string matching 
+// some pattern if and only if it did before.
+//
+void testprune(void)
+{
+    bool bAllPassed = true;
+    char szCanonical[] = "a**?*?b*";
+    size_t rgKept[CORPUS_WILDS];
+    size_t cKept = FastWildPrune(rgCorpusWild, CORPUS_WILDS, rgKept);
+
+    bAllPassed &= FastWildCanonicalize(szCanonical) == 6 && 
+                  !strcmp(szCanonical, "a??*b*");
+    bAllPassed &= FastWildContains("a*", "ab*c");
+    bAllPassed &= !FastWildContains("ab*c", "a*");
+    bAllPassed &= FastWildEquivalent("**x", "*x");
+    bAllPassed &= FastWildEquivalent("?*", "?*");
+    bAllPassed &= FastWildContains("?*?", "€*😊");
+    bAllPassed &= FastWildContains("𓋍?*", "𓋍𓋔*");
+    bAllPassed &= !FastWildContains("𓋍*", "𓋔*");
+    bAllPassed &= !FastWildContains("a?c", "a*c");
+    bAllPassed &= cKept <= CORPUS_WILDS;
+
+    for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+    {
+        bool bAny = false;
+        bool bAnyKept = false;
+
+        for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+        {
+            bAny |= FastWildCompareUtf8(rgCorpusWild[iWild], 
+                                        rgCorpusTame[iTame]);
+        }
+
+        for (size_t iKept = 0; iKept < cKept; iKept++)
+        {
+            bAnyKept |= FastWildCompareUtf8(rgCorpusWild[rgKept[iKept]], 
+                                            rgCorpusTame[iTame]);
+        }
+
+        bAllPassed &= bAny == bAnyKept;
+    }
+
+    if (bAllPassed)
+    {
+        printf("Passed pruning tests\n");
+    }
+    else
+    {
+        printf("Failed pruning tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_PRUNE
+
+
+#if defined(COMPARE_CACHE)
+// Checks matching via a cache too small for the corpus patterns, so that 
+// patterns are evicted and compiled again, against FastWildCompareUtf8(), 
+// and checks that every call is counted as a hit or a miss.
+//
+void testcache(void)
+{
+    bool bAllPassed = true;
+    WildPatternCache *pCache = FastWildCacheCreate(8);
+    WildCacheReader *pReader = pCache ? FastWildCacheReaderOpen(pCache) : NULL;
+    uint64_t cHits = 0;
+    uint64_t cMisses = 0;
+    uint64_t cEvictions = 0;
+
+    for (size_t iPass = 0; pReader && iPass < 2; iPass++)
+    {
+        for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+        {
+            for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+            {
+                bAllPassed &= FastWildCacheCompareUtf8(pReader, 
+                    rgCorpusWild[iWild], rgCorpusTame[iTame]) == 
+                    FastWildCompareUtf8(rgCorpusWild[iWild], 
+                                        rgCorpusTame[iTame]);
+            }
+        }
+    }
+
+    if (pReader)
+    {
+        FastWildCacheCounts(pCache, &cHits, &cMisses, &cEvictions);
+        bAllPassed &= cHits + cMisses == 2 * CORPUS_TAMES * CORPUS_WILDS && 
+                      cMisses > 0 && cEvictions > 0;
+        FastWildCacheReaderClose(pReader);
+    }
+
+    if (pReader && bAllPassed)
+    {
+        printf("Passed cache tests\n");
+    }
+    else
+    {
+        printf("Failed cache tests\n");
+    }
+
+    FastWildCacheFree(pCache);
+    return;
+}
+#endif  // COMPARE_CACHE
+
+
+#if defined(COMPARE_MEMO)
+// Checks memoized results against FastWildCompareUtf8(), for every corpus 
+// pair, once to fill the memo and once to read it back, and in batches 
+// made of each corpus tame string twice.
+//
+void testmemo(void)
+{
+    bool bAllPassed = true;
+    WildMemo *pMemo = FastWildMemoCreate(64 * 1024);
+    char *rgBatch[2 * CORPUS_TAMES];
+    bool rgResults[2 * CORPUS_TAMES];
+    uint64_t cHits = 0;
+    uint64_t cMisses = 0;
+    size_t cbMemo = 0;
+
+    for (size_t iPass = 0; pMemo && iPass < 2; iPass++)
+    {
+        for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+        {
+            for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+            {
+                bAllPassed &= FastWildMemoCompareUtf8(pMemo, 
+                    rgCorpusWild[iWild], rgCorpusTame[iTame]) == 
+                    FastWildCompareUtf8(rgCorpusWild[iWild], 
+                                        rgCorpusTame[iTame]);
+            }
+        }
+    }
+
+    for (size_t iWild = 0; pMemo && iWild < CORPUS_WILDS; iWild++)
+    {
+        for (size_t iTame = 0; iTame < 2 * CORPUS_TAMES; iTame++)
+        {
+            rgBatch[iTame] = rgCorpusTame[iTame % CORPUS_TAMES];
+        }
+
+        FastWildMemoCompareUtf8Batch(pMemo, rgCorpusWild[iWild], rgBatch, 
+                                     rgResults, 2 * CORPUS_TAMES);
+
+        for (size_t iTame = 0; iTame < 2 * CORPUS_TAMES; iTame++)
+        {
+            bAllPassed &= rgResults[iTame] == 
+                FastWildCompareUtf8(rgCorpusWild[iWild], rgBatch[iTame]);
+        }
+    }
+
+    if (pMemo)
+    {
+        FastWildMemoCounts(pMemo, &cHits, &cMisses, &cbMemo);
+        bAllPassed &= cHits > 0 && cMisses > 0 && cbMemo >= 32 * 1024;
+    }
+
+    if (pMemo && bAllPassed)
+    {
+        printf("Passed memo tests\n");
+    }
+    else
+    {
+        printf("Failed memo tests\n");
+    }
+
+    FastWildMemoFree(pMemo);
+    return;
+}
+#endif  // COMPARE_MEMO
+
+
+#if defined(COMPARE_LIVE)
+// Checks a live set of the corpus patterns against FastWildCompareUtf8(), 
+// and then again after publishing the first half of the corpus patterns 
+// in its place.
+//
+void testlive(void)
+{
+    bool bAllPassed = true;
+    size_t rgMatches[CORPUS_WILDS];
+    WildLiveSet *pLive = FastWildLiveCreate(rgCorpusWild, CORPUS_WILDS);
+    WildLiveReader *pReader = pLive ? FastWildLiveReaderOpen(pLive) : NULL;
+
+    for (size_t iPass = 0; pReader && iPass < 2; iPass++)
+    {
+        size_t cWild = iPass ? CORPUS_WILDS / 2 : CORPUS_WILDS;
+        size_t cPatterns;
+        WildPatternSet *pSet = FastWildLiveEnter(pReader, &cPatterns);
+
+        bAllPassed &= cPatterns == cWild;
+
+        for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+        {
+            size_t cMatches = FastWildSetCompareUtf8(pSet, rgCorpusTame[iTame], 
+                                                     rgMatches);
+            size_t iMatch = 0;
+
+            for (size_t iWild = 0; iWild < cWild; iWild++)
+            {
+                bool bMatched = iMatch < cMatches && rgMatches[iMatch] == iWild;
+
+                bAllPassed &= bMatched == FastWildCompareUtf8(
+                    rgCorpusWild[iWild], rgCorpusTame[iTame]);
+                iMatch += bMatched;
+            }
+
+            bAllPassed &= iMatch == cMatches;
+        }
+
+        FastWildLiveExit(pReader);
+        bAllPassed &= iPass || 
+            FastWildLivePublish(pLive, rgCorpusWild, CORPUS_WILDS / 2);
+    }
+
+    if (pReader && bAllPassed)
+    {
+        printf("Passed live set tests\n");
+    }
+    else
+    {
+        printf("Failed live set tests\n");
+    }
+
+    if (pReader)
+    {
+        FastWildLiveReaderClose(pReader);
+    }
+
+    FastWildLiveFree(pLive);
+    return;
+}
+#endif  // COMPARE_LIVE
+
+
+#if defined(COMPARE_IMAGE) || defined(COMPARE_ARENA)
+// Returns whether a set's matches for every corpus tame string are those 
+// of FastWildCompareUtf8(), for the corpus patterns.
+//
+bool corpusmatches(WildPatternSet *pSet)
+{
+    bool bAllPassed = pSet != NULL;
+    size_t rgMatches[CORPUS_WILDS];
+
+    for (size_t iTame = 0; pSet && iTame < CORPUS_TAMES; iTame++)
+    {
+        size_t cMatches = FastWildSetCompareUtf8(pSet, rgCorpusTame[iTame], 
+                                                 rgMatches);
+        size_t iMatch = 0;
+
+        for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+        {
+            bool bMatched = iMatch < cMatches && rgMatches[iMatch] == iWild;
+
+            bAllPassed &= bMatched == 
+                FastWildCompareUtf8(rgCorpusWild[iWild], rgCorpusTame[iTame]);
+            iMatch += bMatched;
+        }
+
+        bAllPassed &= iMatch == cMatches;
+    }
+
+    return bAllPassed;
+}
+#endif  // COMPARE_IMAGE || COMPARE_ARENA
+
+
+#if defined(COMPARE_IMAGE)
+// Checks sets of the corpus patterns mapped from images, both in memory 
+// and via a file, for each strategy, and checks that images of the same 
+// patterns come out byte for byte the same, and that a damaged image is 
+// turned away.
+//
+void testimage(void)
+{
+    bool bAllPassed = true;
+    const char *pPath = "wildtestimage.bin";
+
+    for (int iStrategy = WILD_SET_STRATEGY_AUTO; 
+         iStrategy <= WILD_SET_STRATEGY_TEDDY; iStrategy++)
+    {
+        size_t cbImage = 0;
+        unsigned char *pImage = (unsigned char *) FastWildSetImage(
+            rgCorpusWild, CORPUS_WILDS, iStrategy, &cbImage);
+        WildPatternSet *pSet = pImage ? FastWildSetMap(pImage, cbImage) : NULL;
+        size_t cbAgain = 0;
+        void *pAgain = FastWildSetImage(rgCorpusWild, CORPUS_WILDS, iStrategy, 
+                                        &cbAgain);
+
+        bAllPassed &= corpusmatches(pSet);
+        bAllPassed &= pAgain && cbAgain == cbImage && 
+                      !memcmp(pAgain, pImage, cbImage);
+        FastWildSetFree(pSet);
+        free(pAgain);
+
+        bAllPassed &= FastWildSetSave(rgCorpusWild, CORPUS_WILDS, iStrategy, 
+                                      pPath);
+        pSet = FastWildSetLoad(pPath);
+        bAllPassed &= corpusmatches(pSet);
+        FastWildSetFree(pSet);
+        remove(pPath);
+
+        for (size_t iByte = 0; pImage && iByte < cbImage; iByte += 97)
+        {
+            pImage[iByte] ^= 0x20;
+            pSet = FastWildSetMap(pImage, cbImage);
+            bAllPassed &= pSet == NULL;
+            FastWildSetFree(pSet);
+            pImage[iByte] ^= 0x20;
+        }
+
+        bAllPassed &= pImage && !FastWildSetMap(pImage, cbImage - 1);
+        free(pImage);
+    }
+
+    bAllPassed &= FastWildSetLoad(pPath) == NULL;
+
+    if (bAllPassed)
+    {
+        printf("Passed set image tests\n");
+    }
+    else
+    {
+        printf("Failed set image tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_IMAGE
+
+
+#if defined(COMPARE_ARENA)
+// Checks corpus patterns compiled into an arena, and a set of them 
+// compiled into the same arena, against FastWildCompareUtf8(), before and 
+// after resetting the arena, and checks that a fixed arena turns away an 
+// allocation that doesn't fit.
+//
+void testarena(void)
+{
+    bool bAllPassed = true;
+    WildArena *pArena = FastWildArenaCreate(4096);
+    WildPattern *rgPatterns[CORPUS_WILDS];
+    char rgBuffer[256];
+    WildArena *pFixed = FastWildArenaCreateFixed(rgBuffer, sizeof(rgBuffer));
+    size_t cbAllocated = 0;
+    size_t cbReserved = 0;
+
+    for (size_t iPass = 0; pArena && iPass < 2; iPass++)
+    {
+        WildPatternSet *pSet;
+
+        for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+        {
+            rgPatterns[iWild] = 
+                FastWildPatternCompileArena(rgCorpusWild[iWild], pArena);
+            bAllPassed &= rgPatterns[iWild] != NULL;
+        }
+
+        for (size_t iWild = 0; bAllPassed && iWild < CORPUS_WILDS; iWild++)
+        {
+            for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+            {
+                bAllPassed &= FastWildPatternCompareUtf8(rgPatterns[iWild], 
+                    rgCorpusTame[iTame]) == FastWildCompareUtf8(
+                    rgCorpusWild[iWild], rgCorpusTame[iTame]);
+            }
+
+            // Patterns in an arena are released only along with it.
+            FastWildPatternFree(rgPatterns[iWild]);
+        }
+
+        pSet = FastWildSetCompileArena(rgCorpusWild, CORPUS_WILDS, 
+                                       WILD_SET_STRATEGY_AUTO, pArena);
+        bAllPassed &= corpusmatches(pSet) && 
+                      FastWildSetBytes(pSet) > CORPUS_WILDS;
+        FastWildSetFree(pSet);
+        FastWildArenaBytes(pArena, &cbAllocated, &cbReserved);
+        bAllPassed &= cbAllocated > 0 && cbAllocated <= cbReserved;
+        FastWildArenaReset(pArena);
+    }
+
+    bAllPassed &= pFixed && FastWildArenaAlloc(pFixed, 200, 1) && 
+                  !FastWildArenaAlloc(pFixed, 100, 1);
+
+    if (pArena && bAllPassed)
+    {
+        printf("Passed arena tests\n");
+    }
+    else
+    {
+        printf("Failed arena tests\n");
+    }
+
+    FastWildArenaFree(pFixed);
+    FastWildArenaFree(pArena);
+    return;
+}
+#endif  // COMPARE_ARENA
+
+
+#if defined(COMPARE_PARALLEL)
+// Compiles a set of 60,000 patterns of every shape on 1, 2, 3 and 8 
+// threads, and checks that each set is the same size, picks out the same 
+// candidates in the same order, and matches as FastWildCompareUtf8() does.
+//
+void testparallel(void)
+{
+    size_t cWild = 60000;
+    size_t cTame = 50;
+    char (*rgWild)[32] = (char (*)[32]) malloc(cWild * 32);
+    char **ppWild = (char **) malloc(cWild * sizeof(char *));
+    size_t *piFirst = (size_t *) malloc(cWild * sizeof(size_t));
+    size_t *piOther = (size_t *) malloc(cWild * sizeof(size_t));
+    char rgTame[48];
+    unsigned rgThreads[] = { 1, 2, 3, 8 };
+    WildPatternSet *rgSets[4] = { NULL, NULL, NULL, NULL };
+    bool bAllPassed = rgWild && ppWild && piFirst && piOther;
+
+    srand(4242);
+
+    for (size_t iWild = 0; bAllPassed && iWild < cWild; iWild++)
+    {
+        int iForm = rand() % 4;
+
+        if (iForm == 0)
+        {
+            sprintf(rgWild[iWild], "d%02d/f%03d.e%d", rand() % 50, 
+                    rand() % 500, rand() % 10);
+        }
+        else if (iForm == 1)
+        {
+            sprintf(rgWild[iWild], "*.e%d", rand() % 10);
+        }
+        else if (iForm == 2)
+        {
+            sprintf(rgWild[iWild], "d%02d/*", rand() % 50);
+        }
+        else
+        {
+            sprintf(rgWild[iWild], "*/f%02d?.*", rand() % 100);
+        }
+
+        ppWild[iWild] = rgWild[iWild];
+    }
+
+    for (size_t iSet = 0; bAllPassed && iSet < 4; iSet++)
+    {
+        rgSets[iSet] = FastWildSetCompileThreads(ppWild, cWild, 
+            WILD_SET_STRATEGY_AUTO, NULL, rgThreads[iSet]);
+        bAllPassed &= rgSets[iSet] && 
+                      FastWildSetBytes(rgSets[iSet]) == 
+                      FastWildSetBytes(rgSets[0]);
+    }
+
+    for (size_t iTame = 0; bAllPassed && iTame < cTame; iTame++)
+    {
+        size_t cFirst;
+        size_t iMatch = 0;
+
+        sprintf(rgTame, "d%02d/f%03d.e%d", rand() % 50, rand() % 500, 
+                rand() % 10);
+        cFirst = FastWildSetCandidatesUtf8(rgSets[0], rgTame, piFirst);
+
+        for (size_t iSet = 1; iSet < 4; iSet++)
+        {
+            bAllPassed &= FastWildSetCandidatesUtf8(rgSets[iSet], rgTame, 
+                                                    piOther) == cFirst && 
+                          !memcmp(piFirst, piOther, cFirst * sizeof(size_t));
+        }
+
+        cFirst = FastWildSetCompareUtf8(rgSets[3], rgTame, piFirst);
+
+        for (size_t iWild = 0; iWild < cWild; iWild++)
+        {
+            bool bMatched = iMatch < cFirst && piFirst[iMatch] == iWild;
+
+            bAllPassed &= bMatched == FastWildCompareUtf8(ppWild[iWild], 
+                                                          rgTame);
+            iMatch += bMatched;
+        }
+
+        bAllPassed &= iMatch == cFirst;
+    }
+
+    if (bAllPassed)
+    {
+        printf("Passed parallel set tests\n");
+    }
+    else
+    {
+        printf("Failed parallel set tests\n");
+    }
+
+    for (size_t iSet = 0; iSet < 4; iSet++)
+    {
+        FastWildSetFree(rgSets[iSet]);
+    }
+
+    free(rgWild);
+    free(ppWild);
+    free(piFirst);
+    free(piOther);
+    return;
+}
+#endif  // COMPARE_PARALLEL
+
+
+#if defined(COMPARE_CAPTURE)
+// Checks that the spans captured for a matching pair account for every 
+// byte of the tame string: each wildcard's span starts where the 
+// preceding literal text or span ends, each '?' covers one code point, and 
+// the last span or literal ends where the tame string does.
+//
+bool checkspans(char *pWild, char *pTame, WildSpan *pSpans, size_t cSpans)
+{
+    size_t iTame = 0;
+    size_t iSpan = 0;
+
+    for (char *pChar = pWild; *pChar; pChar++)
+    {
+        if (*pChar == '*' || *pChar == '?')
+        {
+            if (iSpan == cSpans || pSpans[iSpan].iOffset != iTame)
+            {
+                return false;
+            }
+
+            iTame += pSpans[iSpan++].cbSpan;
+        }
+        else
+        {
+            iTame++;
+        }
+    }
+
+    return iSpan == cSpans && iTame == strlen(pTame);
+}
+
+
+// Tests of the spans captured for each wildcard, checked against known 
+// spans and against FastWildCompareUtf8() over the corpus.
+//
+void testcapture(void)
+{
+    static const struct
+    {
+        const char *pWild;
+        const char *pTame;
+        size_t cSpans;
+        WildSpan rgSpans[4];
+    } rgCases[] =
+    {
+        { "src/*/*.txt", "src/a/b/c.txt", 2, { { 4, 1 }, { 6, 3 } } },
+        { "?b*??", "abcde", 4, { { 0, 1 }, { 2, 1 }, { 3, 1 }, { 4, 1 } } },
+        { "a**b", "axxb", 2, { { 1, 0 }, { 1, 2 } } },
+        { "*", "", 1, { { 0, 0 } } },
+        { "𓋍𓋔?", "𓋍𓋔𓎍", 1, { { 8, 4 } } },
+        { "?ؿꜪ*ꜿ", "ḪؿꜪἪꜿ", 2, { { 0, 3 }, { 8, 3 } } },
+        { "x*y*z", "xyyzzyz", 2, { { 1, 0 }, { 2, 4 } } },
+    };
+    bool bAllPassed = true;
+    WildSpan rgSpans[8];
+    size_t cSpans;
+
+    for (size_t iCase = 0; iCase < sizeof(rgCases) / sizeof(rgCases[0]); 
+         iCase++)
+    {
+        bool bMatch = FastWildCaptureUtf8((char *) rgCases[iCase].pWild, 
+                                          (char *) rgCases[iCase].pTame, 
+                                          rgSpans, 8, &cSpans);
+
+        bAllPassed &= bMatch && cSpans == rgCases[iCase].cSpans;
+
+        for (size_t iSpan = 0; bMatch && iSpan < cSpans && iSpan < 4; 
+             iSpan++)
+        {
+            bAllPassed &= rgSpans[iSpan].iOffset == 
+                          rgCases[iCase].rgSpans[iSpan].iOffset && 
+                          rgSpans[iSpan].cbSpan == 
+                          rgCases[iCase].rgSpans[iSpan].cbSpan;
+        }
+    }
+
+    // Only as many spans as there's room for are stored, but all of the 
+    // wildcards are counted, and a mismatch stores nothing.
+    rgSpans[1].iOffset = 99;
+    bAllPassed &= FastWildCaptureUtf8((char *) "?b*??", (char *) "abcde", 
+                                      rgSpans, 1, &cSpans);
+    bAllPassed &= cSpans == 4 && rgSpans[0].cbSpan == 1 && 
+                  rgSpans[1].iOffset == 99;
+    bAllPassed &= FastWildCaptureUtf8((char *) "a*b", (char *) "axxb", 
+                                      NULL, 0, NULL);
+    bAllPassed &= !FastWildCaptureUtf8((char *) "a*c", (char *) "axxb", 
+                                       rgSpans, 8, &cSpans);
+    bAllPassed &= rgSpans[1].iOffset == 99;
+
+    for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+    {
+        for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+        {
+            bool bMatch = FastWildCaptureUtf8(rgCorpusWild[iWild], 
+                                              rgCorpusTame[iTame], 
+                                              rgSpans, 8, &cSpans);
+
+            bAllPassed &= bMatch == FastWildCompareUtf8(rgCorpusWild[iWild], 
+                                                        rgCorpusTame[iTame]);
+
+            if (bMatch && cSpans <= 8)
+            {
+                bAllPassed &= checkspans(rgCorpusWild[iWild], 
+                                         rgCorpusTame[iTame], 
+                                         rgSpans, cSpans);
+            }
+        }
+    }
+
+    if (bAllPassed)
+    {
+        printf("Passed capture tests\n");
+    }
+    else
+    {
+        printf("Failed capture tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_CAPTURE
+
+
+#if defined(COMPARE_REWRITE)
+// Tests of rewriting by wildcard pattern and template, including a batch 
+// cross-checked against one-at-a-time rewriting over the corpus.
+//
+void testrewrite(void)
+{
+    static const struct
+    {
+        const char *pWild;
+        const char *pTemplate;
+        const char *pTame;
+        const char *pExpected;         // NULL for a mismatch
+    } rgCases[] =
+    {
+        { "logs/*/*.txt", "archive/#1/#2.txt.gz", "logs/2025/app.txt", 
+          "archive/2025/app.txt.gz" },
+        { "logs/*/*.txt", "archive/#1/#2.txt.gz", "logs/2025/app.log", 
+          NULL },
+        { "*-*", "#2-#1", "left-right-most", "right-most-left" },
+        { "a?c*", "###1#1 #2", "abcde", "#bb de" },
+        { "*", "[#1]", "", "[]" },
+        { "𓋍?*", "#2#1", "𓋍𓋔𓎍", "𓎍𓋔" },
+        { "src/*", "dst/", "src/lib/x.cpp", "dst/" },
+    };
+    static const char *rgBadTemplates[] = { "#0", "#3", "#x", "a#", "#65" };
+    bool bAllPassed = true;
+    WildRewrite *pRewrite;
+    char *rgOut[CORPUS_TAMES];
+    char szOut[256];
+    size_t cbOut;
+
+    for (size_t iCase = 0; iCase < sizeof(rgCases) / sizeof(rgCases[0]); 
+         iCase++)
+    {
+        pRewrite = FastWildRewriteCompile((char *) rgCases[iCase].pWild, 
+                                          (char *) rgCases[iCase].pTemplate);
+
+        if (!pRewrite)
+        {
+            bAllPassed = false;
+            continue;
+        }
+
+        if (FastWildRewriteUtf8(pRewrite, (char *) rgCases[iCase].pTame, 
+                                szOut, sizeof(szOut), &cbOut))
+        {
+            bAllPassed &= rgCases[iCase].pExpected && 
+                          !strcmp(szOut, rgCases[iCase].pExpected) && 
+                          cbOut == strlen(szOut);
+        }
+        else
+        {
+            bAllPassed &= !rgCases[iCase].pExpected;
+        }
+
+        FastWildRewriteFree(pRewrite);
+    }
+
+    // Templates that refer to missing wildcards aren't accepted.
+    for (size_t iBad = 0; iBad < sizeof(rgBadTemplates) / sizeof(char *); 
+         iBad++)
+    {
+        pRewrite = FastWildRewriteCompile((char *) "*.?", 
+                                          (char *) rgBadTemplates[iBad]);
+        bAllPassed &= !pRewrite;
+        FastWildRewriteFree(pRewrite);
+    }
+
+    // A result too long for its buffer is cut short, but its full length 
+    // is reported.
+    pRewrite = FastWildRewriteCompile((char *) "*", (char *) "#1#1");
+    bAllPassed &= pRewrite && 
+                  FastWildRewriteUtf8(pRewrite, (char *) "abc", szOut, 4, 
+                                      &cbOut) && 
+                  cbOut == 6 && !strcmp(szOut, "abc");
+    FastWildRewriteFree(pRewrite);
+
+    // A batch agrees with one-at-a-time rewriting, and when the arena 
+    // runs out of room, the strings from the one that didn't fit on get 
+    // no result.
+    pRewrite = FastWildRewriteCompile((char *) "*a*", (char *) "<#2|#1>");
+
+    for (size_t cbArena = 64; pRewrite && cbArena <= 4096; cbArena *= 64)
+    {
+        static char rgBuffer[4096];
+        WildArena *pArena = FastWildArenaCreateFixed(rgBuffer, cbArena);
+        bool bMissing = false;
+        bool bFit;
+
+        if (!pArena)
+        {
+            bAllPassed = false;
+            break;
+        }
+
+        bFit = FastWildRewriteBatchUtf8(pRewrite, rgCorpusTame, 
+                                        CORPUS_TAMES, pArena, rgOut);
+        bAllPassed &= bFit == (cbArena == 4096);
+
+        for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+        {
+            bool bMatch = FastWildRewriteUtf8(pRewrite, rgCorpusTame[iTame], 
+                                              szOut, sizeof(szOut), &cbOut);
+
+            if (rgOut[iTame])
+            {
+                bAllPassed &= bMatch && !bMissing && 
+                              !strcmp(rgOut[iTame], szOut);
+            }
+            else
+            {
+                bMissing |= bMatch;
+                bAllPassed &= !bMatch || !bFit;
+            }
+        }
+
+        FastWildArenaFree(pArena);
+    }
+
+    bAllPassed &= pRewrite != NULL;
+    FastWildRewriteFree(pRewrite);
+
+    if (bAllPassed)
+    {
+        printf("Passed rewrite tests\n");
+    }
+    else
+    {
+        printf("Failed rewrite tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_REWRITE
+
+
+#if defined(COMPARE_SEARCH)
+// Finds the matches of a pattern within a string the slow way, by trying 
+// FastWildCompareUtf8() on each run of code points, for cross-checking 
+// FastWildSearchUtf8().  Returns the number of matches, storing as many 
+// as cMaxMatches.
+//
+size_t searchslowly(char *pWild, char *pText, WildSpan *pMatches, 
+                    size_t cMaxMatches)
+{
+    char szWild[64];
+    char szRun[256];
+    size_t cbText = strlen(pText);
+    size_t cbWild;
+    size_t cMatches = 0;
+
+    while (*pWild == '*')
+    {
+        pWild++;
+    }
+
+    cbWild = strlen(pWild);
+
+    while (cbWild && pWild[cbWild - 1] == '*')
+    {
+        cbWild--;
+    }
+
+    if (!cbWild || cbWild >= sizeof(szWild) || cbText >= sizeof(szRun))
+    {
+        return 0;
+    }
+
+    memcpy(szWild, pWild, cbWild);
+    szWild[cbWild] = '\0';
+
+    for (size_t iStart = 0; iStart < cbText;)
+    {
+        size_t iEnd = iStart;
+
+        do
+        {
+            memcpy(szRun, pText + iStart, iEnd - iStart);
+            szRun[iEnd - iStart] = '\0';
+
+            if (FastWildCompareUtf8(szWild, szRun))
+            {
+                break;
+            }
+
+            iEnd++;
+
+            while (iEnd < cbText && (pText[iEnd] & 0xC0) == 0x80)
+            {
+                iEnd++;
+            }
+        } while (iEnd <= cbText);
+
+        if (iEnd <= cbText)
+        {
+            if (cMatches < cMaxMatches)
+            {
+                pMatches[cMatches].iOffset = iStart;
+                pMatches[cMatches].cbSpan = iEnd - iStart;
+            }
+
+            cMatches++;
+            iStart = iEnd;
+        }
+        else
+        {
+            iStart++;
+
+            while (iStart < cbText && (pText[iStart] & 0xC0) == 0x80)
+            {
+                iStart++;
+            }
+        }
+    }
+
+    return cMatches;
+}
+
+
+// Tests of finding every match of a pattern within text, checked against 
+// known matches and against searchslowly() over the corpus, with the 
+// matches gathered a few at a time.
+//
+void testsearch(void)
+{
+    static const struct
+    {
+        const char *pWild;
+        const char *pText;
+        size_t cMatches;
+        WildSpan rgMatches[3];
+    } rgCases[] =
+    {
+        { "ab", "xabyabab", 3, { { 1, 2 }, { 4, 2 }, { 6, 2 } } },
+        { "a*c", "abcabcac", 3, { { 0, 3 }, { 3, 3 }, { 6, 2 } } },
+        { "**b?d*", "abcdbxd", 2, { { 1, 3 }, { 4, 3 } } },
+        { "?b", "bbb", 1, { { 0, 2 } } },
+        { "a*x", "abcabc", 0, { } },
+        { "***", "abc", 0, { } },
+        { "?☂", "☀☂🐉☂", 2, { { 0, 6 }, { 6, 7 } } },
+    };
+    static char szNulls[] = "a\0b\0a\0b";
+    bool bAllPassed = true;
+    WildSpan rgMatches[16];
+    WildSpan rgExpected[16];
+    size_t iNext;
+
+    for (size_t iCase = 0; iCase < sizeof(rgCases) / sizeof(rgCases[0]); 
+         iCase++)
+    {
+        size_t cMatches = FastWildSearchUtf8((char *) rgCases[iCase].pWild, 
+            (char *) rgCases[iCase].pText, strlen(rgCases[iCase].pText), 0, 
+            rgMatches, 16, &iNext);
+
+        bAllPassed &= cMatches == rgCases[iCase].cMatches && 
+                      iNext == strlen(rgCases[iCase].pText);
+
+        for (size_t iMatch = 0; iMatch < cMatches && iMatch < 3; iMatch++)
+        {
+            bAllPassed &= rgMatches[iMatch].iOffset == 
+                          rgCases[iCase].rgMatches[iMatch].iOffset && 
+                          rgMatches[iMatch].cbSpan == 
+                          rgCases[iCase].rgMatches[iMatch].cbSpan;
+        }
+    }
+
+    // Nulls within the text are matched like other bytes.
+    bAllPassed &= FastWildSearchUtf8((char *) "b?a", szNulls, 
+                                     sizeof(szNulls) - 1, 0, rgMatches, 16, 
+                                     &iNext) == 1 && 
+                  rgMatches[0].iOffset == 2 && rgMatches[0].cbSpan == 3;
+
+    for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+    {
+        for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+        {
+            size_t cbText = strlen(rgCorpusTame[iTame]);
+            size_t cExpected = searchslowly(rgCorpusWild[iWild], 
+                                            rgCorpusTame[iTame], 
+                                            rgExpected, 16);
+            size_t cMatches = 0;
+
+            iNext = 0;
+
+            do
+            {
+                size_t cFound = FastWildSearchUtf8(rgCorpusWild[iWild], 
+                                                   rgCorpusTame[iTame], 
+                                                   cbText, iNext, rgMatches, 
+                                                   3, &iNext);
+
+                for (size_t iFound = 0; iFound < cFound; iFound++)
+                {
+                    bAllPassed &= cMatches >= 16 || 
+                        (rgMatches[iFound].iOffset == 
+                         rgExpected[cMatches].iOffset && 
+                         rgMatches[iFound].cbSpan == 
+                         rgExpected[cMatches].cbSpan);
+                    cMatches++;
+                }
+            } while (iNext < cbText);
+
+            bAllPassed &= cMatches == cExpected;
+        }
+    }
+
+    if (bAllPassed)
+    {
+        printf("Passed search tests\n");
+    }
+    else
+    {
+        printf("Failed search tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_SEARCH
+
+
+#if defined(COMPARE_PARTIAL)
+// Tests of partial matching, checked against known results, against 
+// FastWildCompareUtf8() over the corpus, and for agreement between the 
+// incremental form and the whole-string form over every prefix of each 
+// corpus string.
+//
+void testpartial(void)
+{
+    static const struct
+    {
+        const char *pWild;
+        const char *pTame;
+        int iExpected;
+    } rgCases[] =
+    {
+        { "src/*/*.txt", "src", WILD_PARTIAL_POSSIBLE },
+        { "src/*/*.txt", "docs", WILD_PARTIAL_NO },
+        { "src/*/*.txt", "src/a/b.txt", WILD_PARTIAL_FULL_MATCH },
+        { "src/*/*.txt", "src/a/b.txt/c", WILD_PARTIAL_POSSIBLE },
+        { "abc", "abcd", WILD_PARTIAL_NO },
+        { "a?c", "a", WILD_PARTIAL_POSSIBLE },
+        { "", "", WILD_PARTIAL_FULL_MATCH },
+        { "", "a", WILD_PARTIAL_NO },
+        { "*", "", WILD_PARTIAL_FULL_MATCH },
+        { "*x*y", "yx", WILD_PARTIAL_POSSIBLE },
+        { "𓋍?", "𓋍𓋔", WILD_PARTIAL_FULL_MATCH },
+        { "𓋍?", "𓋔", WILD_PARTIAL_NO },
+    };
+    bool bAllPassed = true;
+
+    for (size_t iCase = 0; iCase < sizeof(rgCases) / sizeof(rgCases[0]); 
+         iCase++)
+    {
+        bAllPassed &= FastWildPartialUtf8((char *) rgCases[iCase].pWild, 
+                                          (char *) rgCases[iCase].pTame) == 
+                      rgCases[iCase].iExpected;
+    }
+
+    for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+    {
+        for (size_t iWild = 0; iWild < CORPUS_WILDS; iWild++)
+        {
+            char *pTame = rgCorpusTame[iTame];
+            char *pWild = rgCorpusWild[iWild];
+            char szPrefix[256];
+            bool bMatch = FastWildCompareUtf8(pWild, pTame);
+            int iPrevious = WILD_PARTIAL_POSSIBLE;
+            WildPartial state;
+
+            FastWildPartialStart(&state);
+
+            // Each prefix, a code point longer than the last, gets the same 
+            // result either way, and no prefix of a match gets 
+            // WILD_PARTIAL_NO.
+            for (size_t cbPrefix = 0;;)
+            {
+                int iWhole;
+                int iExtended = FastWildPartialExtendUtf8(pWild, &state, 
+                                                          pTame, cbPrefix);
+
+                memcpy(szPrefix, pTame, cbPrefix);
+                szPrefix[cbPrefix] = '\0';
+                iWhole = FastWildPartialUtf8(pWild, szPrefix);
+                bAllPassed &= iWhole == iExtended && 
+                              (iWhole != WILD_PARTIAL_NO || !bMatch) && 
+                              (iPrevious != WILD_PARTIAL_NO || 
+                               iWhole == WILD_PARTIAL_NO);
+                iPrevious = iWhole;
+
+                if (!pTame[cbPrefix])
+                {
+                    bAllPassed &= (iWhole == WILD_PARTIAL_FULL_MATCH) == 
+                                  bMatch;
+                    break;
+                }
+
+                do
+                {
+                    cbPrefix++;
+                } while ((pTame[cbPrefix] & 0xC0) == 0x80);
+            }
+        }
+    }
+
+    if (bAllPassed)
+    {
+        printf("Passed partial match tests\n");
+    }
+    else
+    {
+        printf("Failed partial match tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_PARTIAL
+
+
+#if defined(COMPARE_FILTER)
+// Tests of filtering as a pattern is typed, edited, and deleted, checked 
+// against FastWildCompareUtf8() with '*' appended to each pattern, over 
+// the corpus.
+//
+void testfilter(void)
+{
+    static const char *rgTyped[] =
+    {
+        "", "m", "mi", "mis", "mis*", "mis*i", "mis*ip", "mis*i", "mis*", 
+        "*", "*s", "*ss", "*ss?", "*ss?p", "*ss?pi", "a", "a*", "a*?", 
+        "a*?c", "?", "??", "??*", "??*a", "s", "sr", "src", "src/", 
+        "src/*", "src/*.", "src/*.c", "docs", "🐂", "🐂🚀", "🐂*", "🐂*☂", 
+        "𓋍𓋔?", "Мне", "Мне*язык", "", "*", "**", "***a", 
+    };
+    WildFilter *pFilter = FastWildFilterCreate(rgCorpusTame, CORPUS_TAMES);
+    bool bAllPassed = pFilter != NULL;
+
+    for (size_t iTyped = 0; 
+         pFilter && iTyped < sizeof(rgTyped) / sizeof(rgTyped[0]); iTyped++)
+    {
+        char szWild[64];
+        size_t *piSelected;
+        size_t cSelected;
+        size_t iSelected = 0;
+
+        sprintf(szWild, "%s*", rgTyped[iTyped]);
+
+        if (!FastWildFilterUtf8(pFilter, (char *) rgTyped[iTyped], 
+                                &piSelected, &cSelected))
+        {
+            bAllPassed = false;
+            break;
+        }
+
+        for (size_t iTame = 0; iTame < CORPUS_TAMES; iTame++)
+        {
+            if (FastWildCompareUtf8(szWild, rgCorpusTame[iTame]))
+            {
+                bAllPassed &= iSelected < cSelected && 
+                              piSelected[iSelected++] == iTame;
+            }
+        }
+
+        bAllPassed &= iSelected == cSelected;
+    }
+
+    FastWildFilterFree(pFilter);
+
+    if (bAllPassed)
+    {
+        printf("Passed filter tests\n");
+    }
+    else
+    {
+        printf("Failed filter tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_FILTER
+
+
+#if defined(COMPARE_PATH)
+// Splits a path or a pattern, in place, at each '/'.  Returns the number of 
+// components, storing as many as cMaxComponents.
+//
+size_t pathsplit(char *pPath, char **ppComponents, size_t cMaxComponents)
+{
+    size_t cComponents = 0;
+
+    for (;;)
+    {
+        char *pSeparator = strchr(pPath, '/');
+
+        if (cComponents < cMaxComponents)
+        {
+            ppComponents[cComponents] = pPath;
+        }
+
+        cComponents++;
+
+        if (!pSeparator)
+        {
+            return cComponents;
+        }
+
+        *pSeparator = '\0';
+        pPath = pSeparator + 1;
+    }
+}
+
+
+// Matches split path components against split pattern components, with 
+// FastWildCompareUtf8() for each component and by trying every number of 
+// components for each "**".
+//
+bool pathcomponents(char **ppWild, size_t cWild, char **ppTame, size_t cTame)
+{
+    if (!cWild)
+    {
+        return !cTame;
+    }
+    else if (strspn(ppWild[0], "*") < 2 || ppWild[0][strspn(ppWild[0], "*")])
+    {
+        return cTame && FastWildCompareUtf8(ppWild[0], ppTame[0]) && 
+               pathcomponents(ppWild + 1, cWild - 1, ppTame + 1, cTame - 1);
+    }
+    else if (cWild == 1)
+    {
+        return cTame > 0;              // A trailing "**" needs something.
+    }
+
+    for (size_t iSkip = 0; iSkip <= cTame; iSkip++)
+    {
+        if (pathcomponents(ppWild + 1, cWild - 1, ppTame + iSkip, 
+                           cTame - iSkip))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+// Matches a path against a pattern the way it's done without path-aware 
+// matching, by splitting both into components first, for cross-checking 
+// FastWildPathCompareUtf8().
+//
+bool pathslowly(char *pWild, char *pTame)
+{
+    char szWild[256];
+    char szTame[256];
+    char *rgWild[64];
+    char *rgTame[64];
+    size_t cWild;
+    size_t cTame;
+
+    strcpy(szWild, pWild);
+    strcpy(szTame, pTame);
+    cWild = pathsplit(szWild, rgWild, 64);
+    cTame = pathsplit(szTame, rgTame, 64);
+    return cWild <= 64 && cTame <= 64 && 
+           pathcomponents(rgWild, cWild, rgTame, cTame);
+}
+
+
+// Joins the parts picked by the base-(cParts + 1) digits of iPick, where 
+// a 0 digit picks no part, with '/' between them.
+//
+void pathpick(char *pOut, const char **ppParts, size_t cParts, size_t iPick)
+{
+    bool bFirst = true;
+
+    *pOut = '\0';
+
+    for (; iPick; iPick /= cParts + 1)
+    {
+        if (iPick % (cParts + 1))
+        {
+            strcat(pOut, bFirst ? "" : "/");
+            strcat(pOut, ppParts[iPick % (cParts + 1) - 1]);
+            bFirst = false;
+        }
+    }
+
+    return;
+}
+
+
+// Tests of path-aware matching against known results, checked against git 
+// for the "**" cases, and against pathslowly() for every pattern and path 
+// made of up to three parts from short lists.
+//
+void testpath(void)
+{
+    static const struct
+    {
+        const char *pWild;
+        const char *pTame;
+        bool bExpected;
+    } rgCases[] =
+    {
+        { "src/*.c", "src/a.c", true },
+        { "src/*.c", "src/net/b.c", false },
+        { "src/?", "src//", false },
+        { "src/**/*.c", "src/a.c", true },
+        { "src/**/*.c", "src/net/x/c.c", true },
+        { "src/**/*.c", "srcx/d.c", false },
+        { "**/*.c", "a.c", true },
+        { "**/src/*.c", "x/src/e.c", true },
+        { "**/src/*.c", "x/src/net/e.c", false },
+        { "src/**", "src/a.c", true },
+        { "src/**", "src/", true },
+        { "src/**", "src", false },
+        { "a**c", "a.c", true },
+        { "a**c", "a/c", false },
+        { "**/net/**", "src/net/x/c.c", true },
+        { "**/net/**", "src/net", false },
+        { "**", "", true },
+        { "**", "a/b/c", true },
+        { "a/**/**/b", "a/b", true },
+        { "a/**/b/**/c", "a/b/b/x/c", true },
+        { "/**/a", "/a", true },
+        { "/**/a", "a", false },
+        { "Мне/**/язык", "Мне/𓋍/язык", true },
+        { "Мне/?/язык", "Мне/𓋍/язык", true }, 
+    };
+    static const char *rgWildParts[] =
+    {
+        "a", "*", "**", "?", "a*", "*b", "", "🐂", "a**", 
+    };
+    static const char *rgTameParts[] = { "a", "b", "ab", "", "🐂", "ba" };
+    bool bAllPassed = true;
+
+    for (size_t iCase = 0; iCase < sizeof(rgCases) / sizeof(rgCases[0]); 
+         iCase++)
+    {
+        bAllPassed &= FastWildPathCompareUtf8((char *) rgCases[iCase].pWild, 
+                                              (char *) rgCases[iCase].pTame) 
+                      == rgCases[iCase].bExpected;
+    }
+
+    for (size_t iWild = 0; iWild < 10 * 10 * 10; iWild++)
+    {
+        for (size_t iTame = 0; iTame < 7 * 7 * 7; iTame++)
+        {
+            char szWild[64];
+            char szTame[64];
+
+            pathpick(szWild, rgWildParts, 9, iWild);
+            pathpick(szTame, rgTameParts, 6, iTame);
+            bAllPassed &= FastWildPathCompareUtf8(szWild, szTame) == 
+                          pathslowly(szWild, szTame);
+        }
+    }
+
+    if (bAllPassed)
+    {
+        printf("Passed path tests\n");
+    }
+    else
+    {
+        printf("Failed path tests\n");
+    }
+
+    return;
+}
+#endif  // COMPARE_PATH
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_BATCH)
+// Compares interleaved batch matching against a loop of one-at-a-time 
+// matches, for tame strings scattered at random across a region of memory 
+// much larger than the last-level cache.
+//
+void benchbatch(void)
+{
+    size_t cTame = 2000000;
+    size_t cbSlot = 256;
+    char  *pRegion = (char *) malloc(cTame * cbSlot);
+    char **ppTame = (char **) malloc(cTame * sizeof(char *));
+    bool  *pResults = (bool *) malloc(cTame * sizeof(bool));
+    size_t *pSlots = (size_t *) malloc(cTame * sizeof(size_t));
+    static char *rgWild[] = { "*abc*cab", "b*a?c*", "cab*" };
+    volatile bool bSink;
+
+    if (!pRegion || !ppTame || !pResults || !pSlots)
+    {
+        printf("Batch benchmark skipped: out of memory\n");
+        free(pRegion);
+        free(ppTame);
+        free(pResults);
+        free(pSlots);
+        return;
+    }
+
+    // Shuffle the slots, so that consecutive strings are far apart.
+    srand(12345);
+
+    for (size_t iSlot = 0; iSlot < cTame; iSlot++)
+    {
+        pSlots[iSlot] = iSlot;
+    }
+
+    for (size_t iSlot = cTame - 1; iSlot > 0; iSlot--)
+    {
+        size_t iOther = (((size_t) rand() << 16) ^ rand()) % (iSlot + 1);
+        size_t iSwap = pSlots[iSlot];
+        pSlots[iSlot] = pSlots[iOther];
+        pSlots[iOther] = iSwap;
+    }
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        char *pTame = pRegion + pSlots[iTame] * cbSlot;
+        size_t cbTame = 16 + rand() % (cbSlot - 17);
+
+        for (size_t iChar = 0; iChar < cbTame; iChar++)
+        {
+            pTame[iChar] = "abc"[rand() % 3];
+        }
+
+        pTame[cbTame] = '\0';
+        ppTame[iTame] = pTame;
+    }
+
+    printf("Batch matching of %u scattered strings (ns per string):\n",
+           (unsigned) cTame);
+
+    for (size_t iWild = 0; iWild < sizeof(rgWild) / sizeof(rgWild[0]); 
+         iWild++)
+    {
+        char *pWild = rgWild[iWild];
+        double fSequential = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                bSink = FastWildCompareUtf8(pWild, ppTame[iTame]);
+            }
+        }) / cTame;
+        double fBatch = averagenanoseconds(1, [&]() {
+            FastWildCompareUtf8Batch(pWild, ppTame, pResults, cTame);
+        }) / cTame;
+
+        printf("  %-12s sequential %6.1f  interleaved %6.1f\n", 
+               pWild, fSequential, fBatch);
+    }
+
+    free(pRegion);
+    free(ppTame);
+    free(pResults);
+    free(pSlots);
+    return;
+}
+
+
+// Compares lane-parallel matching of short identifiers against a loop of 
+// one-at-a-time matches.
+//
+void benchlanes(void)
+{
+    size_t cTame = 1000000;
+    size_t cbSlot = 40;
+    char  *pRegion = (char *) malloc(cTame * cbSlot);
+    char **ppTame = (char **) malloc(cTame * sizeof(char *));
+    bool  *pResults = (bool *) malloc(cTame * sizeof(bool));
+    static char *rgWild[] = { "user_*", "*_id", "?????_*_??", "*ab*ba*" };
+    volatile bool bSink;
+
+    if (!pRegion || !ppTame || !pResults)
+    {
+        printf("Lane benchmark skipped: out of memory\n");
+        free(pRegion);
+        free(ppTame);
+        free(pResults);
+        return;
+    }
+
+    srand(54321);
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        char *pTame = pRegion + iTame * cbSlot;
+        size_t cbTame = 8 + rand() % 25;
+
+        for (size_t iChar = 0; iChar < cbTame; iChar++)
+        {
+            pTame[iChar] = "abuser_id"[rand() % 9];
+        }
+
+        pTame[cbTame] = '\0';
+        ppTame[iTame] = pTame;
+    }
+
+    printf("Lane-parallel matching of %u short strings (ns per string):\n",
+           (unsigned) cTame);
+
+    for (size_t iWild = 0; iWild < sizeof(rgWild) / sizeof(rgWild[0]); 
+         iWild++)
+    {
+        char *pWild = rgWild[iWild];
+        double fSequential = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                bSink = FastWildCompareUtf8(pWild, ppTame[iTame]);
+            }
+        }) / cTame;
+        double fLanes = averagenanoseconds(1, [&]() {
+            FastWildCompareUtf8Lanes(pWild, ppTame, pResults, cTame);
+        }) / cTame;
+
+        printf("  %-12s sequential %6.1f  lanes %6.1f\n", 
+               pWild, fSequential, fLanes);
+    }
+
+    free(pRegion);
+    free(ppTame);
+    free(pResults);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_BATCH
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_JIT)
+// Compares the cost of JIT-compiling a pattern against the time it saves 
+// per match, and reports how many matches it takes to break even.
+//
+void benchjit(void)
+{
+    static char *rgPairs[][2] =
+    {
+        { "mississipPI", "mississipPI" },
+        { "abcabcdabcdabcabcdabcdabcabcdabcabcabcd", 
+          "abcabc?abc?abcabc?abc?abc?bc?abc?bc?bcd" },
+        { "gate gate paragate parasamgate bodhi svaha", 
+          "gate gate paragate para????gate bodhi *" },
+        { "abababababababababababababababababababaacacacacaca\
+cacadaeafagahaiajakalaaaaaaaaaaaaaaaaaffafagaagggagaaaaaaaab", 
+          "abababababababababababababababababababaacacacacaca\
+cacadaeafagahaiajakalaaaaaaaaaaaaaaaaaffafagaagggagaaaaaaaab" },
+        { "mississippi", "mi*sip*" },
+        { "/usr/local/share/doc/fastwild/README.md", "*.md" },
+        { "/usr/local/share/doc/fastwild/README.md", "*/doc/*/READ??.md" },
+        { "the quick brown fox jumps over the lazy dog", "*fox*lazy*" },
+        { "a na\xC3\xAFve r\xC3\xA9sum\xC3\xA9 from the caf\xC3\xA9", 
+          "*na\xC3\xAFve*caf?" },
+    };
+    int nReps = 1000000;
+    int nCompiles = 10000;
+    volatile bool bSink;
+
+    printf("JIT break-even (compile ns / interpreted ns - JIT ns per match):\n");
+
+    for (size_t iPair = 0; iPair < sizeof(rgPairs) / sizeof(rgPairs[0]); 
+         iPair++)
+    {
+        char *pTame = rgPairs[iPair][0];
+        char *pWild = rgPairs[iPair][1];
+        double fCompile = averagenanoseconds(nCompiles, [&]() {
+            FastWildJitFree(FastWildJitCompile(pWild));
+        });
+        WildJitPattern *pJitPattern = FastWildJitCompile(pWild);
+        double fInterpreted = averagenanoseconds(nReps, [&]() {
+            bSink = FastWildCompareUtf8(pWild, pTame);
+        });
+        double fJit = averagenanoseconds(nReps, [&]() {
+            bSink = FastWildJitCompareUtf8(pJitPattern, pTame);
+        });
+
+        printf("  %-24.24s compile %8.1f  interpreted %6.1f  JIT %6.1f  ",
+               pWild, fCompile, fInterpreted, fJit);
+
+        if (!FastWildJitIsNative(pJitPattern))
+        {
+            printf("(interpreted)\n");
+        }
+        else if (fInterpreted > fJit)
+        {
+            printf("break-even %.0f matches\n", 
+                   fCompile / (fInterpreted - fJit));
+        }
+        else
+        {
+            printf("no break-even\n");
+        }
+
+        FastWildJitFree(pJitPattern);
+    }
+
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_JIT
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_PATTERN)
+// Compares compiled patterns against FastWildCompareUtf8(), per match.
+//
+void benchpattern(void)
+{
+    static char *rgPairs[][2] =
+    {
+        { "abc", "abd" },
+        { "mississippi", "mississippi" },
+        { "abcabcdabcdabcabcdabcdabcabcdabcabcabcd", 
+          "abcabc?abc?abcabc?abc?abc?bc?abc?bc?bcd" },
+        { "abcabcdabcdabcabcd", "abcabc?abcabcabc" },
+        { "abababababababababababababababababababaacacacacaca\
+cacadaeafagahaiajakalaaaaaaaaaaaaaaaaaffafagaagggagaaaaaaaab", 
+          "abababababababababababababababababababaacacacacaca\
+cacadaeafagahaiajaxalaaaaaaaaaaaaaaaaaffafagaagggagaaaaaaaab" },
+        { "गते गते पारगते पारसंगते बोधि स्वाहा", 
+          "गते गते पारगते प????गते बोधि स्वाहा" },
+    };
+    int nReps = 1000000;
+    volatile bool bSink;
+
+    printf("Compiled patterns (ns per match):\n");
+
+    for (size_t iPair = 0; iPair < sizeof(rgPairs) / sizeof(rgPairs[0]); 
+         iPair++)
+    {
+        char *pTame = rgPairs[iPair][0];
+        char *pWild = rgPairs[iPair][1];
+        WildPattern *pPattern = FastWildPatternCompile(pWild);
+        double fInterpreted = averagenanoseconds(nReps, [&]() {
+            bSink = FastWildCompareUtf8(pWild, pTame);
+        });
+        double fCompiled = averagenanoseconds(nReps, [&]() {
+            bSink = FastWildPatternCompareUtf8(pPattern, pTame);
+        });
+
+        printf("  %-24.24s FastWildCompareUtf8() %6.1f  compiled %6.1f\n",
+               pWild, fInterpreted, fCompiled);
+        FastWildPatternFree(pPattern);
+    }
+
+    return;
+}
+
+
+// Breaks down the speedup of compiled patterns by pattern shape, over a 
+// set of generated file paths.
+//
+void benchshapes(void)
+{
+    static char *rgShapes[][2] =
+    {
+        { "exact",          "src/lib/wild0042.cpp" },
+        { "prefix",         "src/lib/*" },
+        { "padded prefix",  "src/??\?/*" },
+        { "suffix",         "*.cpp" },
+        { "padded suffix",  "*?.cpp" },
+        { "infix",          "*wild00*" },
+        { "anchored",       "src/*/*.cpp" },
+    };
+    static char *rgDirectories[] = { "src/lib/", "src/app/", "docs/", "" };
+    static char *rgExtensions[] = { ".cpp", ".h", ".md", ".txt" };
+    size_t cTame = 100000;
+    int nPasses = 20;
+    char (*rgTame)[48] = (char (*)[48]) malloc(cTame * 48);
+    volatile bool bSink;
+
+    if (!rgTame)
+    {
+        printf("Shape benchmark skipped: out of memory\n");
+        return;
+    }
+
+    srand(2468);
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        sprintf(rgTame[iTame], "%swild%04d%s", rgDirectories[rand() % 4], 
+                rand() % 10000, rgExtensions[rand() % 4]);
+    }
+
+    printf("Compiled patterns by shape (ns per match):\n");
+
+    for (size_t iShape = 0; iShape < sizeof(rgShapes) / sizeof(rgShapes[0]);
+         iShape++)
+    {
+        char *pWild = rgShapes[iShape][1];
+        WildPattern *pPattern = FastWildPatternCompile(pWild);
+        auto interpret = [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                bSink = FastWildCompareUtf8(pWild, rgTame[iTame]);
+            }
+        };
+        auto compiled = [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                bSink = FastWildPatternCompareUtf8(pPattern, rgTame[iTame]);
+            }
+        };
+
+        // An untimed pass of each warms the caches and branch predictors 
+        // before several passes are timed.
+        interpret();
+        compiled();
+
+        double fInterpreted = averagenanoseconds(nPasses, interpret) / cTame;
+        double fCompiled = averagenanoseconds(nPasses, compiled) / cTame;
+
+        printf("  %-14s %-22s FastWildCompareUtf8() %6.1f  compiled %6.1f"
+               "\n", rgShapes[iShape][0], pWild, fInterpreted, fCompiled);
+        FastWildPatternFree(pPattern);
+    }
+
+    free(rgTame);
+    return;
+}
+
+// Compares compiled patterns with both anchors against 
+// FastWildCompareUtf8(), over generated log lines that mostly don't match.  
+// The anchors reject most lines without a scan of the middle.
+//
+void benchanchors(void)
+{
+    static char *rgWilds[] =
+    {
+        "GET /*.png 404",
+        "GET /static/*?.png 200",
+        "*/img/*.png 200",
+        "GET /*img*200",
+        "GET *static*img*",
+    };
+    static char *rgMethods[] = { "GET", "POST", "PUT", "HEAD" };
+    static char *rgDirectories[] = { "static/img", "api/v1/users", "static" };
+    static char *rgExtensions[] = { ".png", ".json", ".html", ".css" };
+    size_t cTame = 100000;
+    char (*rgTame)[96] = (char (*)[96]) malloc(cTame * 96);
+    volatile bool bSink;
+
+    if (!rgTame)
+    {
+        printf("Anchor benchmark skipped: out of memory\n");
+        return;
+    }
+
+    srand(1357);
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        sprintf(rgTame[iTame], "%s /%s/item%06d%s %d", 
+                rgMethods[rand() % 4], rgDirectories[rand() % 3], 
+                rand() % 1000000, rgExtensions[rand() % 4], 
+                rand() % 8 ? 200 : 404);
+    }
+
+    printf("Compiled patterns with anchors (ns per match):\n");
+
+    for (size_t iWild = 0; iWild < sizeof(rgWilds) / sizeof(rgWilds[0]);
+         iWild++)
+    {
+        char *pWild = rgWilds[iWild];
+        WildPattern *pPattern = FastWildPatternCompile(pWild);
+        size_t cMatches = 0;
+        double fInterpreted = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                bSink = FastWildCompareUtf8(pWild, rgTame[iTame]);
+            }
+        }) / cTame;
+        double fCompiled = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                bSink = FastWildPatternCompareUtf8(pPattern, rgTame[iTame]);
+            }
+        }) / cTame;
+
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            cMatches += FastWildPatternCompareUtf8(pPattern, rgTame[iTame]);
+        }
+
+        printf("  %-22s %5.1f%% matched  FastWildCompareUtf8() %6.1f  "
+               "compiled %6.1f\n", pWild, 100.0 * cMatches / cTame, 
+               fInterpreted, fCompiled);
+        FastWildPatternFree(pPattern);
+    }
+
+    free(rgTame);
+    return;
+}
+
+// Compares compiled patterns, which search for their rarest literal first, 
+// against FastWildCompareUtf8(), over generated lines of words where the 
+// rare literal appears at a varying rate.
+//
+void benchprefilter(void)
+{
+    static char *rgWords[] =
+    {
+        "make", "vision", "data", "fast", "wild", "string", "match", "code",
+        "radio", "table", "index", "name", "value", "idol", "ironic",
+    };
+    static int rgPermille[] = { 1, 10, 100, 500, 900 };
+    char *pWild = "*a?e*i?o*jazz*";
+    WildPattern *pPattern = FastWildPatternCompile(pWild);
+    size_t cTame = 100000;
+    char (*rgTame)[96] = (char (*)[96]) malloc(cTame * 96);
+    volatile bool bSink;
+
+    if (!rgTame || !pPattern)
+    {
+        printf("Prefilter benchmark skipped: out of memory\n");
+        free(rgTame);
+        FastWildPatternFree(pPattern);
+        return;
+    }
+
+    printf("Compiled patterns with a rare literal, %s (ns per match):\n", 
+           pWild);
+    srand(8642);
+
+    for (size_t iRate = 0; iRate < sizeof(rgPermille) / sizeof(int); iRate++)
+    {
+        size_t cMatches = 0;
+
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            // A matching line starts with "make idol" and ends with "jazz".
+            bool bMatch = rand() % 1000 < rgPermille[iRate];
+            char *pLine = rgTame[iTame];
+
+            strcpy(pLine, bMatch ? "make idol " : "");
+
+            for (int iWord = bMatch ? 2 : 0; iWord < 8; iWord++)
+            {
+                strcat(pLine, bMatch && iWord == 7 ? "jazz" : 
+                              rgWords[rand() % (sizeof(rgWords) / 
+                                                sizeof(rgWords[0]))]);
+                strcat(pLine, " ");
+            }
+        }
+
+        double fInterpreted = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                bSink = FastWildCompareUtf8(pWild, rgTame[iTame]);
+            }
+        }) / cTame;
+        double fCompiled = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                bSink = FastWildPatternCompareUtf8(pPattern, rgTame[iTame]);
+            }
+        }) / cTame;
+
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            cMatches += FastWildPatternCompareUtf8(pPattern, rgTame[iTame]);
+        }
+
+        printf("  %5.1f%% matched  FastWildCompareUtf8() %6.1f  compiled "
+               "%6.1f\n", 100.0 * cMatches / cTame, fInterpreted, fCompiled);
+    }
+
+    FastWildPatternFree(pPattern);
+    free(rgTame);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_PATTERN
+
+
+#if defined(COMPARE_PERFORMANCE) && \
+    (defined(COMPARE_SET) || defined(COMPARE_NFA))
+// Generates patterns and log lines for the multiple-pattern benchmarks.
+//
+void generatelogs(char (*rgWild)[32], char **ppWild, size_t cWild, 
+                  char (*rgTame)[96], size_t cTame)
+{
+    static char *rgForms[] = 
+    {
+        "*user%05d*", "*.x%04d", "host%05d*", "*id=%05d*?", "*k%d*ok*"
+    };
+
+    srand(9753);
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        sprintf(rgWild[iWild], rgForms[iWild % 5], rand() % 100000);
+        ppWild[iWild] = rgWild[iWild];
+    }
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        sprintf(rgTame[iTame], "host%05d GET /users/user%05d/file.x%04d "
+                "id=%05d k%d ok", rand() % 100000, rand() % 100000, 
+                rand() % 10000, rand() % 100000, rand() % 100000);
+    }
+
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && (COMPARE_SET || COMPARE_NFA)
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_SET)
+// Compares pattern sets against matching each compiled pattern in turn, 
+// over generated log lines, for sets of 10 to 100,000 patterns.
+//
+void benchset(void)
+{
+    static size_t rgSetSizes[] = { 10, 100, 1000, 10000, 100000 };
+    size_t cMaxWild = 100000;
+    size_t cTame = 1000;
+    char (*rgWild)[32] = (char (*)[32]) malloc(cMaxWild * 32);
+    char **ppWild = (char **) malloc(cMaxWild * sizeof(char *));
+    WildPattern **ppPatterns = 
+        (WildPattern **) malloc(cMaxWild * sizeof(WildPattern *));
+    size_t *piMatches = (size_t *) malloc(cMaxWild * sizeof(size_t));
+    char (*rgTame)[96] = (char (*)[96]) malloc(cTame * 96);
+    volatile size_t cSink;
+
+    if (!rgWild || !ppWild || !ppPatterns || !piMatches || !rgTame)
+    {
+        printf("Set benchmark skipped: out of memory\n");
+        free(rgWild);
+        free(ppWild);
+        free(ppPatterns);
+        free(piMatches);
+        free(rgTame);
+        return;
+    }
+
+    generatelogs(rgWild, ppWild, cMaxWild, rgTame, cTame);
+    printf("Pattern sets (ns per tame string):\n");
+
+    for (size_t iSize = 0; iSize < sizeof(rgSetSizes) / sizeof(size_t); 
+         iSize++)
+    {
+        size_t cWild = rgSetSizes[iSize];
+        WildPatternSet *pSet = NULL;
+        double fCompile = averagenanoseconds(1, [&]() {
+            pSet = FastWildSetCompile(ppWild, cWild);
+        });
+
+        if (!pSet)
+        {
+            printf("  %6zu patterns: out of memory\n", cWild);
+            continue;
+        }
+
+        for (size_t iWild = 0; iWild < cWild; iWild++)
+        {
+            ppPatterns[iWild] = FastWildPatternCompile(ppWild[iWild]);
+        }
+
+        double fEach = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                size_t cMatches = 0;
+
+                for (size_t iWild = 0; iWild < cWild; iWild++)
+                {
+                    cMatches += FastWildPatternCompareUtf8(ppPatterns[iWild], 
+                                                           rgTame[iTame]);
+                }
+
+                cSink = cMatches;
+            }
+        }) / cTame;
+        double fSet = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                cSink = FastWildSetCompareUtf8(pSet, rgTame[iTame], 
+                                               piMatches);
+            }
+        }) / cTame;
+
+        printf("  %6zu patterns  each compiled pattern %10.1f  set %8.1f  "
+               "(set compiled in %.1f ms)\n", cWild, fEach, fSet, 
+               fCompile / 1000000.0);
+
+        for (size_t iWild = 0; iWild < cWild; iWild++)
+        {
+            FastWildPatternFree(ppPatterns[iWild]);
+        }
+
+        FastWildSetFree(pSet);
+    }
+
+    // Finds the crossover points between the strategies for small sets. 
+    // Forced strategies search for every pattern's literal, while the 
+    // automatic one hashes the patterns it can (2 of the 5 forms here) and 
+    // picks a strategy for the number of patterns left over.
+    static char *rgStrategies[] = { "auto", "each", "Aho-Corasick", "Teddy" };
+
+    printf("Pattern set strategies (ns per tame string):\n");
+
+    for (size_t cWild = 2; cWild <= 256; cWild *= 2)
+    {
+        printf("  %3zu patterns", cWild);
+
+        for (int iStrategy = WILD_SET_STRATEGY_AUTO; 
+             iStrategy <= WILD_SET_STRATEGY_TEDDY; iStrategy++)
+        {
+            WildPatternSet *pSet = 
+                FastWildSetCompileStrategy(ppWild, cWild, iStrategy);
+
+            if (!pSet || (iStrategy != WILD_SET_STRATEGY_AUTO && 
+                          FastWildSetStrategy(pSet) != iStrategy))
+            {
+                printf("  %s %7s", rgStrategies[iStrategy], "-");
+                FastWildSetFree(pSet);
+                continue;
+            }
+
+            double fSet = averagenanoseconds(1, [&]() {
+                for (size_t iTame = 0; iTame < cTame; iTame++)
+                {
+                    cSink = FastWildSetCompareUtf8(pSet, rgTame[iTame], 
+                                                   piMatches);
+                }
+            }) / cTame;
+
+            printf("  %s %7.1f", rgStrategies[iStrategy], fSet);
+            FastWildSetFree(pSet);
+        }
+
+        WildPatternSet *pSet = FastWildSetCompile(ppWild, cWild);
+
+        printf("  (auto: %s)\n", 
+               pSet ? rgStrategies[FastWildSetStrategy(pSet)] : "-");
+        FastWildSetFree(pSet);
+    }
+
+    free(rgWild);
+    free(ppWild);
+    free(ppPatterns);
+    free(piMatches);
+    free(rgTame);
+    return;
+}
+
+
+// Orders timings for finding percentiles.
+//
+int compareseconds(const void *pLeft, const void *pRight)
+{
+    double fLeft = *(const double *) pLeft;
+    double fRight = *(const double *) pRight;
+
+    return fLeft < fRight ? -1 : fLeft > fRight;
+}
+
+
+// Times lookups of file paths in a set of 50,000 patterns, most of them 
+// exact names, "dir/*" prefixes, or "*.ext" suffixes, with and without the 
+// hash indexes that automatic sets keep for those shapes.
+//
+void benchindex(void)
+{
+    static char *rgStrategies[] = { "indexed", "", "Aho-Corasick" };
+    size_t cWild = 50000;
+    size_t cTame = 10000;
+    char (*rgWild)[32] = (char (*)[32]) malloc(cWild * 32);
+    char **ppWild = (char **) malloc(cWild * sizeof(char *));
+    size_t *piMatches = (size_t *) malloc(cWild * sizeof(size_t));
+    char (*rgTame)[48] = (char (*)[48]) malloc(cTame * 48);
+    double *pTimes = (double *) malloc(cTame * sizeof(double));
+    volatile size_t cSink;
+
+    if (!rgWild || !ppWild || !piMatches || !rgTame || !pTimes)
+    {
+        printf("Index benchmark skipped: out of memory\n");
+        free(rgWild);
+        free(ppWild);
+        free(piMatches);
+        free(rgTame);
+        free(pTimes);
+        return;
+    }
+
+    srand(8642);
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        int iForm = rand() % 20;
+
+        if (iForm < 8)
+        {
+            sprintf(rgWild[iWild], "*.e%04d", rand() % 10000);
+        }
+        else if (iForm < 14)
+        {
+            sprintf(rgWild[iWild], "d%04d/*", rand() % 10000);
+        }
+        else if (iForm < 19)
+        {
+            sprintf(rgWild[iWild], "d%04d/f%05d.e%04d", rand() % 10000, 
+                    rand() % 100000, rand() % 10000);
+        }
+        else
+        {
+            sprintf(rgWild[iWild], "*/t%03d/*.o?", rand() % 1000);
+        }
+
+        ppWild[iWild] = rgWild[iWild];
+    }
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        sprintf(rgTame[iTame], "d%04d/t%03d/f%05d.e%04d", rand() % 10000, 
+                rand() % 1000, rand() % 100000, rand() % 10000);
+    }
+
+    printf("Indexed pattern set, %zu patterns (ns per tame string):\n", 
+           cWild);
+
+    for (int iStrategy = WILD_SET_STRATEGY_AUTO; 
+         iStrategy <= WILD_SET_STRATEGY_AHO_CORASICK; 
+         iStrategy += WILD_SET_STRATEGY_AHO_CORASICK)
+    {
+        WildPatternSet *pSet = NULL;
+        double fCompile = averagenanoseconds(1, [&]() {
+            pSet = FastWildSetCompileStrategy(ppWild, cWild, iStrategy);
+        });
+        double fTotal = 0;
+
+        if (!pSet)
+        {
+            printf("  %-12s out of memory\n", rgStrategies[iStrategy]);
+            continue;
+        }
+
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            pTimes[iTame] = averagenanoseconds(1, [&]() {
+                cSink = FastWildSetCompareUtf8(pSet, rgTame[iTame], 
+                                               piMatches);
+            });
+            fTotal += pTimes[iTame];
+        }
+
+        qsort(pTimes, cTame, sizeof(double), compareseconds);
+        printf("  %-12s  mean %8.1f  median %8.1f  p99 %8.1f  "
+               "(compiled in %.1f ms)\n", rgStrategies[iStrategy], 
+               fTotal / cTame, pTimes[cTame / 2], pTimes[cTame * 99 / 100], 
+               fCompile / 1000000.0);
+        FastWildSetFree(pSet);
+    }
+
+    free(rgWild);
+    free(ppWild);
+    free(piMatches);
+    free(rgTame);
+    free(pTimes);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_SET
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_NFA)
+// Compares the bit-parallel automaton against matching each compiled 
+// pattern in turn, for 100 to 2,000 patterns, over generated log lines.  
+// Most of the generated patterns start with '*', which keeps their part of 
+// the automaton alive through every byte, so the patterns anchored at the 
+// start ("host%05d*") are also compared on their own.
+//
+void benchnfa(void)
+{
+    static size_t rgSizes[] = { 100, 250, 500, 1000, 2000 };
+    size_t cMaxWild = 2000;
+    size_t cTame = 1000;
+    char (*rgWild)[32] = (char (*)[32]) malloc(5 * cMaxWild * 32);
+    char **ppWild = (char **) malloc(5 * cMaxWild * sizeof(char *));
+    char **ppAnchored = (char **) malloc(cMaxWild * sizeof(char *));
+    WildPattern **ppPatterns = 
+        (WildPattern **) malloc(cMaxWild * sizeof(WildPattern *));
+    uint64_t *pMatches = (uint64_t *) malloc((cMaxWild + 63) / 64 * 8);
+    char (*rgTame)[96] = (char (*)[96]) malloc(cTame * 96);
+    volatile size_t cSink;
+
+    if (!rgWild || !ppWild || !ppAnchored || !ppPatterns || !pMatches || 
+        !rgTame)
+    {
+        printf("NFA benchmark skipped: out of memory\n");
+        free(rgWild);
+        free(ppWild);
+        free(ppAnchored);
+        free(ppPatterns);
+        free(pMatches);
+        free(rgTame);
+        return;
+    }
+
+    generatelogs(rgWild, ppWild, 5 * cMaxWild, rgTame, cTame);
+
+    for (size_t iWild = 0; iWild < cMaxWild; iWild++)
+    {
+        ppAnchored[iWild] = ppWild[5 * iWild + 2];
+    }
+
+    printf("Bit-parallel NFA (ns per tame string):\n");
+
+    for (int bAnchored = 0; bAnchored < 2; bAnchored++)
+    {
+        char **ppSetWild = bAnchored ? ppAnchored : ppWild;
+
+        for (size_t iSize = 0; iSize < sizeof(rgSizes) / sizeof(size_t); 
+             iSize++)
+        {
+            size_t cWild = rgSizes[iSize];
+            WildNfaSet *pNfa = FastWildNfaCompile(ppSetWild, cWild);
+            uint64_t *pState = pNfa ? (uint64_t *) malloc(
+                FastWildNfaStateWords(pNfa) * sizeof(uint64_t)) : NULL;
+
+            if (!pState)
+            {
+                printf("  %5zu patterns: out of memory\n", cWild);
+                FastWildNfaFree(pNfa);
+                continue;
+            }
+
+            for (size_t iWild = 0; iWild < cWild; iWild++)
+            {
+                ppPatterns[iWild] = FastWildPatternCompile(ppSetWild[iWild]);
+            }
+
+            double fEach = averagenanoseconds(1, [&]() {
+                for (size_t iTame = 0; iTame < cTame; iTame++)
+                {
+                    size_t cMatches = 0;
+
+                    for (size_t iWild = 0; iWild < cWild; iWild++)
+                    {
+                        cMatches += FastWildPatternCompareUtf8(
+                            ppPatterns[iWild], rgTame[iTame]);
+                    }
+
+                    cSink = cMatches;
+                }
+            }) / cTame;
+            double fNfa = averagenanoseconds(1, [&]() {
+                for (size_t iTame = 0; iTame < cTame; iTame++)
+                {
+                    FastWildNfaCompareUtf8State(pNfa, rgTame[iTame], 
+                                                pMatches, pState);
+                    cSink = (size_t) pMatches[0];
+                }
+            }) / cTame;
+
+            printf("  %-8s %5zu patterns  each compiled pattern %9.1f  "
+                   "NFA %9.1f\n", bAnchored ? "anchored" : "mixed", cWild, 
+                   fEach, fNfa);
+
+            for (size_t iWild = 0; iWild < cWild; iWild++)
+            {
+                FastWildPatternFree(ppPatterns[iWild]);
+            }
+
+            free(pState);
+            FastWildNfaFree(pNfa);
+        }
+    }
+
+    free(rgWild);
+    free(ppWild);
+    free(ppAnchored);
+    free(ppPatterns);
+    free(pMatches);
+    free(rgTame);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_NFA
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_RULES)
+// Compares a rule table against trying each rule in priority order via 
+// FastWildCompareUtf8(), for a web access list of about 1,500 rules and 
+// request paths that mostly hit a few broad rules of equal priority.  The 
+// rule table is timed over the requests twice, first while it learns 
+// which of those rules to try first and then with what it's learned.
+//
+void benchrules(void)
+{
+    static char *rgBroad[] = 
+    {
+        "*/static/*", "*/img/*", "*.png", "*/img/*.png", "*/img/*.jpg", 
+        "*/css/*.css", "*.js", "*?debug=*"
+    };
+    size_t cBroad = sizeof(rgBroad) / sizeof(rgBroad[0]);
+    size_t cRules = 200 + 800 + 500 + cBroad + 1;
+    size_t cTame = 4 * 4096;
+    char (*rgWild)[32] = (char (*)[32]) malloc(cRules * 32);
+    char **ppWild = (char **) malloc(cRules * sizeof(char *));
+    int *piPriorities = (int *) malloc(cRules * sizeof(int));
+    size_t *piOrder = (size_t *) malloc(cRules * sizeof(size_t));
+    char (*rgTame)[48] = (char (*)[48]) malloc(cTame * 48);
+    volatile size_t cSink;
+
+    if (!rgWild || !ppWild || !piPriorities || !piOrder || !rgTame)
+    {
+        printf("Rule table benchmark skipped: out of memory\n");
+        free(rgWild);
+        free(ppWild);
+        free(piPriorities);
+        free(piOrder);
+        free(rgTame);
+        return;
+    }
+
+    srand(4321);
+
+    for (size_t iRule = 0; iRule < cRules; iRule++)
+    {
+        if (iRule < 200)
+        {
+            sprintf(rgWild[iRule], "/admin/u%04d/*", rand() % 10000);
+            piPriorities[iRule] = 0;
+        }
+        else if (iRule < 1000)
+        {
+            sprintf(rgWild[iRule], "*/api/v?/k%04d/*", (int) iRule - 200);
+            piPriorities[iRule] = 1;
+        }
+        else if (iRule < 1500)
+        {
+            sprintf(rgWild[iRule], "*.p%03d", rand() % 1000);
+            piPriorities[iRule] = 2;
+        }
+        else if (iRule < 1500 + cBroad)
+        {
+            strcpy(rgWild[iRule], rgBroad[iRule - 1500]);
+            piPriorities[iRule] = 3;
+        }
+        else
+        {
+            strcpy(rgWild[iRule], "*");
+            piPriorities[iRule] = 4;
+        }
+
+        ppWild[iRule] = rgWild[iRule];
+    }
+
+    // Shuffles the rules, and then lists them in priority order for 
+    // trying them one at a time.
+    for (size_t iRule = cRules - 1; iRule > 0; iRule--)
+    {
+        size_t iSwap = rand() % (iRule + 1);
+        char *pWild = ppWild[iRule];
+        int iPriority = piPriorities[iRule];
+
+        ppWild[iRule] = ppWild[iSwap];
+        piPriorities[iRule] = piPriorities[iSwap];
+        ppWild[iSwap] = pWild;
+        piPriorities[iSwap] = iPriority;
+    }
+
+    for (size_t iRule = 0, iPriority = 0; iPriority <= 4; iPriority++)
+    {
+        for (size_t iWild = 0; iWild < cRules; iWild++)
+        {
+            if (piPriorities[iWild] == (int) iPriority)
+            {
+                piOrder[iRule++] = iWild;
+            }
+        }
+    }
+
+    // Most requests are for static content, and the API requests favor 
+    // a few keys.
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        int iKind = rand() % 100;
+        double fSkew = (double) rand() / RAND_MAX;
+
+        if (iKind < 35)
+        {
+            sprintf(rgTame[iTame], "/static/img/a%04d.png", rand() % 10000);
+        }
+        else if (iKind < 55)
+        {
+            sprintf(rgTame[iTame], "/static/js/app%03d.js", rand() % 1000);
+        }
+        else if (iKind < 70)
+        {
+            sprintf(rgTame[iTame], "/static/css/s%03d.css", rand() % 1000);
+        }
+        else if (iKind < 90)
+        {
+            sprintf(rgTame[iTame], "/api/v2/k%04d/orders", 
+                    (int) (800 * fSkew * fSkew * fSkew * fSkew));
+        }
+        else if (iKind < 95)
+        {
+            sprintf(rgTame[iTame], "/admin/u%04d/home", rand() % 10000);
+        }
+        else
+        {
+            sprintf(rgTame[iTame], "/home/page%03d.html", rand() % 1000);
+        }
+    }
+
+    printf("Rule table, %zu rules (ns per request):\n", cRules);
+
+    double fEach = averagenanoseconds(1, [&]() {
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            size_t iRule = 0;
+
+            while (iRule < cRules && 
+                   !FastWildCompareUtf8(ppWild[piOrder[iRule]], rgTame[iTame]))
+            {
+                iRule++;
+            }
+
+            cSink = iRule;
+        }
+    }) / cTame;
+    WildRuleTable *pTable = NULL;
+    double fCompile = averagenanoseconds(1, [&]() {
+        pTable = FastWildRulesCompile(ppWild, piPriorities, cRules);
+    });
+
+    if (pTable)
+    {
+        double fLearning = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                cSink = FastWildRulesMatchUtf8(pTable, rgTame[iTame]);
+            }
+        }) / cTame;
+        double fLearned = averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                cSink = FastWildRulesMatchUtf8(pTable, rgTame[iTame]);
+            }
+        }) / cTame;
+
+        printf("  each rule in turn %8.1f  rule table %8.1f, then %8.1f  "
+               "(compiled in %.1f ms)\n", fEach, fLearning, fLearned, 
+               fCompile / 1000000.0);
+    }
+    else
+    {
+        printf("  rule table: out of memory\n");
+    }
+
+    FastWildRulesFree(pTable);
+    free(rgWild);
+    free(ppWild);
+    free(piPriorities);
+    free(piOrder);
+    free(rgTame);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_RULES
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_PRUNE)
+// Prunes an accumulated set of 20,000 patterns, many of them made 
+// redundant by broader ones ("d123/*" covers "d123/f4567*.txt") or written 
+// differently from equivalent ones ("**.e12", "*?x123"), and compares the 
+// FastWildCompareUtf8() calls needed to find whether any pattern matches.
+//
+void benchprune(void)
+{
+    size_t cWild = 20000;
+    size_t cTame = 2000;
+    char (*rgWild)[32] = (char (*)[32]) malloc(cWild * 32);
+    char **ppWild = (char **) malloc(cWild * sizeof(char *));
+    size_t *piKept = (size_t *) malloc(cWild * sizeof(size_t));
+    char (*rgTame)[32] = (char (*)[32]) malloc(cTame * 32);
+    size_t cKept = 0;
+    size_t cCalls = 0;
+    size_t cCallsKept = 0;
+    volatile size_t cSink;
+
+    if (!rgWild || !ppWild || !piKept || !rgTame)
+    {
+        printf("Pruning benchmark skipped: out of memory\n");
+        free(rgWild);
+        free(ppWild);
+        free(piKept);
+        free(rgTame);
+        return;
+    }
+
+    srand(2468);
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        switch (rand() % 8)
+        {
+        case 0:
+            sprintf(rgWild[iWild], "d%03d/*", rand() % 1000);
+            break;
+        case 1:
+        case 2:
+            sprintf(rgWild[iWild], "d%03d/f%04d*.txt", rand() % 1000, 
+                    rand() % 10000);
+            break;
+        case 3:
+            sprintf(rgWild[iWild], "**.e%02d", rand() % 100);
+            break;
+        case 4:
+            sprintf(rgWild[iWild], "*.e%02d", rand() % 100);
+            break;
+        case 5:
+            sprintf(rgWild[iWild], "*?x%03d", rand() % 1000);
+            break;
+        case 6:
+            sprintf(rgWild[iWild], "?*x%03d", rand() % 1000);
+            break;
+        default:
+            sprintf(rgWild[iWild], "*k%05d*v", rand() % 100000);
+            break;
+        }
+
+        ppWild[iWild] = rgWild[iWild];
+    }
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        sprintf(rgTame[iTame], rand() % 2 ? "d%03d/f%04d.txt" : "p%03d/a%04d", 
+                rand() % 2000, rand() % 10000);
+    }
+
+    double fPrune = averagenanoseconds(1, [&]() {
+        cKept = FastWildPrune(ppWild, cWild, piKept);
+    });
+
+    // Counts and times the calls needed to find whether any pattern 
+    // matches each string.
+    double fAll = averagenanoseconds(1, [&]() {
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            size_t iWild = 0;
+
+            while (iWild < cWild && 
+                   !FastWildCompareUtf8(ppWild[iWild], rgTame[iTame]))
+            {
+                iWild++;
+            }
+
+            cCalls += iWild + (iWild < cWild);
+        }
+    }) / cTame;
+    double fKept = averagenanoseconds(1, [&]() {
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            size_t iKept = 0;
+
+            while (iKept < cKept && 
+                   !FastWildCompareUtf8(ppWild[piKept[iKept]], rgTame[iTame]))
+            {
+                iKept++;
+            }
+
+            cCallsKept += iKept + (iKept < cKept);
+        }
+
+        cSink = cCalls + cCallsKept;
+    }) / cTame;
+
+    printf("Pruning %zu patterns: %zu kept, in %.1f ms\n", cWild, cKept, 
+           fPrune / 1000000.0);
+    printf("  calls per string %8.1f, then %8.1f (%.1f saved)  "
+           "ns per string %10.1f, then %10.1f\n", 
+           (double) cCalls / cTame, (double) cCallsKept / cTame, 
+           (double) (cCalls - cCallsKept) / cTame, fAll, fKept);
+
+    free(rgWild);
+    free(ppWild);
+    free(piKept);
+    free(rgTame);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_PRUNE
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_CACHE)
+// Compares compiling a pattern for every call against a cache of 256 
+// compiled patterns, from 1 to 64 threads, for requests that name one of 
+// 1,000 patterns, 95% of them one of the first 100.
+//
+void benchcache(void)
+{
+    size_t cWild = 1000;
+    size_t cTame = 1000;
+    size_t cOps = 4096;
+    size_t cOpsPerThread = 20000;
+    std::vector<std::vector<char>> vWild(cWild, std::vector<char>(40));
+    std::vector<std::vector<char>> vTame(cTame, std::vector<char>(64));
+    std::vector<size_t> vWildOps(cOps);
+    std::vector<size_t> vTameOps(cOps);
+    volatile size_t cSink;
+
+    srand(1357);
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        sprintf(vWild[iWild].data(), "host%03d*GET /v?/*/item%04d*", 
+                (int) (iWild % 100), rand() % 10000);
+    }
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        sprintf(vTame[iTame].data(), "host%03d GET /v2/shop/item%04d 200", 
+                rand() % 100, rand() % 10000);
+    }
+
+    for (size_t iOp = 0; iOp < cOps; iOp++)
+    {
+        vWildOps[iOp] = rand() % 100 < 95 ? rand() % 100 : rand() % cWild;
+        vTameOps[iOp] = rand() % cTame;
+    }
+
+    printf("Compiled pattern cache (million calls per second):\n");
+
+    for (size_t cThreads = 1; cThreads <= 64; cThreads *= 2)
+    {
+        WildPatternCache *pCache = FastWildCacheCreate(256);
+
+        if (!pCache)
+        {
+            printf("  %2zu threads: out of memory\n", cThreads);
+            continue;
+        }
+
+        // Runs the calls on each thread, starting at different requests.
+        auto runthreads = [&](bool bCache) {
+            std::vector<std::thread> vThreads;
+
+            for (size_t iThread = 0; iThread < cThreads; iThread++)
+            {
+                vThreads.emplace_back([&, iThread, bCache]() {
+                    WildCacheReader *pReader = 
+                        bCache ? FastWildCacheReaderOpen(pCache) : NULL;
+                    size_t cMatches = 0;
+
+                    for (size_t iCall = 0; iCall < cOpsPerThread; iCall++)
+                    {
+                        size_t iOp = (iThread * 997 + iCall) % cOps;
+                        char *pWild = vWild[vWildOps[iOp]].data();
+                        char *pTame = vTame[vTameOps[iOp]].data();
+
+                        if (pReader)
+                        {
+                            cMatches += 
+                                FastWildCacheCompareUtf8(pReader, pWild, pTame);
+                        }
+                        else
+                        {
+                            WildPattern *pPattern = 
+                                FastWildPatternCompile(pWild);
+
+                            cMatches += FastWildPatternCompareUtf8(pPattern, 
+                                                                   pTame);
+                            FastWildPatternFree(pPattern);
+                        }
+                    }
+
+                    if (pReader)
+                    {
+                        FastWildCacheReaderClose(pReader);
+                    }
+
+                    cSink = cMatches;
+                });
+            }
+
+            for (size_t iThread = 0; iThread < cThreads; iThread++)
+            {
+                vThreads[iThread].join();
+            }
+        };
+
+        double fCalls = (double) cThreads * cOpsPerThread * 1000.0;
+        double fCompile = fCalls / averagenanoseconds(1, [&]() {
+            runthreads(false);
+        });
+        double fCache = fCalls / averagenanoseconds(1, [&]() {
+            runthreads(true);
+        });
+        uint64_t cHits, cMisses, cEvictions;
+
+        FastWildCacheCounts(pCache, &cHits, &cMisses, &cEvictions);
+        printf("  %2zu threads  compile each call %7.2f  cache %7.2f  "
+               "(hits %llu, misses %llu, evictions %llu)\n", cThreads, 
+               fCompile, fCache, (unsigned long long) cHits, 
+               (unsigned long long) cMisses, (unsigned long long) cEvictions);
+        FastWildCacheFree(pCache);
+    }
+
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_CACHE
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_MEMO)
+// Compares memoized matching against FastWildCompareUtf8() for 
+// authorization checks that repeat 4,000 (pattern, resource) pairs, most 
+// checks being for a small share of them, with resource paths of about 
+// 200 bytes, and for batches in which the same resources recur.
+//
+void benchmemo(void)
+{
+    size_t cWild = 100;
+    size_t cResources = 4000;
+    size_t cChecks = 200000;
+    size_t cBatch = 256;
+    std::vector<std::vector<char>> vWild(cWild, std::vector<char>(64));
+    std::vector<std::vector<char>> vResources(cResources, 
+                                              std::vector<char>(256));
+    std::vector<size_t> vWildChecks(cChecks);
+    std::vector<char *> vTameChecks(cChecks);
+    bool rgResults[256];
+    volatile size_t cSink;
+
+    srand(8080);
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        sprintf(vWild[iWild].data(), "arn:*:tenant%02d/*/project?/*/%s*", 
+                (int) iWild / 2, iWild % 2 ? "read" : "write");
+    }
+
+    for (size_t iResource = 0; iResource < cResources; iResource++)
+    {
+        char *pResource = vResources[iResource].data();
+        int cbResource = sprintf(pResource, "arn:storage:tenant%02d", 
+                                 (int) iResource % 50);
+
+        while (cbResource < 180)
+        {
+            cbResource += sprintf(pResource + cbResource, "/d%04d", 
+                                  rand() % 10000);
+        }
+
+        sprintf(pResource + cbResource, "/project%d/o/%s", rand() % 10, 
+                rand() % 2 ? "read" : "write");
+    }
+
+    // Each resource is checked against either pattern for its tenant, and 
+    // most checks are for a small share of the resources.
+    for (size_t iCheck = 0; iCheck < cChecks; iCheck++)
+    {
+        double fSkew = (double) rand() / RAND_MAX;
+        size_t iResource = (size_t) (cResources * fSkew * fSkew * fSkew);
+
+        vWildChecks[iCheck] = iResource % 50 * 2 + iResource / 50 % 2;
+        vTameChecks[iCheck] = vResources[iResource].data();
+    }
+
+    WildMemo *pMemo = FastWildMemoCreate(256 * 1024);
+
+    if (!pMemo)
+    {
+        printf("Memo benchmark skipped: out of memory\n");
+        return;
+    }
+
+    double fPlain = averagenanoseconds(1, [&]() {
+        size_t cMatches = 0;
+
+        for (size_t iCheck = 0; iCheck < cChecks; iCheck++)
+        {
+            cMatches += FastWildCompareUtf8(vWild[vWildChecks[iCheck]].data(), 
+                                            vTameChecks[iCheck]);
+        }
+
+        cSink = cMatches;
+    }) / cChecks;
+    double fMemo = averagenanoseconds(1, [&]() {
+        size_t cMatches = 0;
+
+        for (size_t iCheck = 0; iCheck < cChecks; iCheck++)
+        {
+            cMatches += FastWildMemoCompareUtf8(pMemo, 
+                vWild[vWildChecks[iCheck]].data(), vTameChecks[iCheck]);
+        }
+
+        cSink = cMatches;
+    }) / cChecks;
+    uint64_t cHits, cMisses;
+    size_t cbMemo;
+
+    FastWildMemoCounts(pMemo, &cHits, &cMisses, &cbMemo);
+    printf("Memoized results, %zu checks (ns per check):\n", cChecks);
+    printf("  FastWildCompareUtf8() %8.1f  memo %8.1f  "
+           "(hit rate %.1f%%, %zu KB)\n", fPlain, fMemo, 
+           100.0 * cHits / (cHits + cMisses), cbMemo / 1024);
+
+    // Batches of checks against one pattern at a time, each for the 
+    // resources of the pattern's tenant, in a fresh memo.
+    FastWildMemoFree(pMemo);
+    pMemo = FastWildMemoCreate(256 * 1024);
+
+    if (!pMemo)
+    {
+        return;
+    }
+
+    for (size_t iCheck = 0; iCheck < cChecks; iCheck++)
+    {
+        double fSkew = (double) rand() / RAND_MAX;
+        size_t iWild = iCheck / cBatch % cWild;
+
+        vWildChecks[iCheck] = iWild;
+        vTameChecks[iCheck] = vResources[iWild / 2 + 50 * (iWild % 2 + 
+            2 * (size_t) (cResources / 100 * fSkew * fSkew))].data();
+    }
+
+    double fBatch = averagenanoseconds(1, [&]() {
+        for (size_t iCheck = 0; iCheck + cBatch <= cChecks; iCheck += cBatch)
+        {
+            FastWildCompareUtf8Batch(vWild[vWildChecks[iCheck]].data(), 
+                                     &vTameChecks[iCheck], rgResults, cBatch);
+        }
+    }) / cChecks;
+    double fMemoBatch = averagenanoseconds(1, [&]() {
+        for (size_t iCheck = 0; iCheck + cBatch <= cChecks; iCheck += cBatch)
+        {
+            FastWildMemoCompareUtf8Batch(pMemo, 
+                vWild[vWildChecks[iCheck]].data(), &vTameChecks[iCheck], 
+                rgResults, cBatch);
+        }
+    }) / cChecks;
+
+    cSink = rgResults[0];
+    FastWildMemoCounts(pMemo, &cHits, &cMisses, &cbMemo);
+    printf("  FastWildCompareUtf8Batch() %8.1f  memo batch %8.1f  "
+           "(%.1f lookups per batch of %zu)\n", fBatch, fMemoBatch, 
+           (double) (cHits + cMisses) / (cChecks / cBatch), cBatch);
+    FastWildMemoFree(pMemo);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_MEMO
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_LIVE) && \
+    defined(COMPARE_SET)
+// Measures matching throughput against a set of 1,000 patterns, on 1 to 
+// 4 threads, while another thread continuously compiles and publishes 
+// replacement sets.  Compares a live set against a set swapped under a 
+// mutex, which the writer holds while compiling and readers hold while 
+// matching, and against matching with no updates at all.
+//
+void benchlive(void)
+{
+    size_t cWild = 1000;
+    size_t cTame = 1000;
+    size_t cVariants = 8;
+    int iMilliseconds = 200;
+    std::vector<char> vWild(cVariants * cWild * 32);
+    std::vector<char *> vpWild(cVariants * cWild);
+    std::vector<char> vTame(cTame * 96);
+    char (*rgWild)[32] = (char (*)[32]) vWild.data();
+    char (*rgTame)[96] = (char (*)[96]) vTame.data();
+
+    // Each variant is a different slice of the generated patterns.
+    generatelogs(rgWild, vpWild.data(), cVariants * cWild, rgTame, cTame);
+    printf("Live set updates, %zu patterns (thousand matches per second):\n",
+           cWild);
+
+    for (size_t cThreads = 1; cThreads <= 4; cThreads *= 2)
+    {
+        double rgRates[3];
+
+        for (int iMode = 0; iMode < 3; iMode++)
+        {
+            WildLiveSet *pLive = FastWildLiveCreate(vpWild.data(), cWild);
+            WildPatternSet *pLocked = FastWildSetCompile(vpWild.data(), cWild);
+            std::mutex lock;
+            std::atomic<bool> bStop(false);
+            std::atomic<size_t> cMatched(0);
+            std::vector<std::thread> vThreads;
+
+            if (!pLive || !pLocked)
+            {
+                FastWildLiveFree(pLive);
+                FastWildSetFree(pLocked);
+                rgRates[iMode] = 0;
+                continue;
+            }
+
+            for (size_t iThread = 0; iThread < cThreads; iThread++)
+            {
+                vThreads.emplace_back([&, iThread, iMode]() {
+                    WildLiveReader *pReader = FastWildLiveReaderOpen(pLive);
+                    std::vector<size_t> vMatches(cWild);
+                    size_t cCalls = 0;
+                    size_t cPatterns;
+
+                    while (!bStop.load(std::memory_order_relaxed))
+                    {
+                        char *pTame = rgTame[(iThread * 331 + cCalls) % cTame];
+
+                        if (iMode == 2)
+                        {
+                            std::lock_guard<std::mutex> guard(lock);
+
+                            FastWildSetCompareUtf8(pLocked, pTame, 
+                                                   vMatches.data());
+                        }
+                        else
+                        {
+                            WildPatternSet *pSet = 
+                                FastWildLiveEnter(pReader, &cPatterns);
+
+                            FastWildSetCompareUtf8(pSet, pTame, 
+                                                   vMatches.data());
+                            FastWildLiveExit(pReader);
+                        }
+
+                        cCalls++;
+                    }
+
+                    FastWildLiveReaderClose(pReader);
+                    cMatched += cCalls;
+                });
+            }
+
+            // The writer publishes each variant in turn, except when 
+            // measuring without updates.
+            auto timeStart = std::chrono::high_resolution_clock::now();
+
+            for (size_t iVariant = 1; 
+                 std::chrono::high_resolution_clock::now() - timeStart < 
+                     std::chrono::milliseconds(iMilliseconds); 
+                 iVariant = (iVariant + 1) % cVariants)
+            {
+                char **ppVariant = vpWild.data() + iVariant * cWild;
+
+                if (iMode == 1)
+                {
+                    FastWildLivePublish(pLive, ppVariant, cWild);
+                }
+                else if (iMode == 2)
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    WildPatternSet *pSet = FastWildSetCompile(ppVariant, cWild);
+
+                    if (pSet)
+                    {
+                        FastWildSetFree(pLocked);
+                        pLocked = pSet;
+                    }
+                }
+                else
+                {
+                    std::this_thread::sleep_for(
+                        std::chrono::milliseconds(iMilliseconds));
+                }
+            }
+
+            bStop = true;
+
+            for (size_t iThread = 0; iThread < cThreads; iThread++)
+            {
+                vThreads[iThread].join();
+            }
+
+            rgRates[iMode] = cMatched / (double) iMilliseconds;
+            FastWildLiveFree(pLive);
+            FastWildSetFree(pLocked);
+        }
+
+        printf("  %zu threads  no updates %8.1f  live set %8.1f  "
+               "mutex %8.1f\n", cThreads, rgRates[0], rgRates[1], rgRates[2]);
+    }
+
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_LIVE && COMPARE_SET
+
+
+#if defined(COMPARE_PERFORMANCE) && (defined(COMPARE_IMAGE) || \
+    defined(COMPARE_ARENA) || defined(COMPARE_PARALLEL))
+// Generates patterns of a large rule set, most of them for file paths, 
+// along with file paths to match against them.
+//
+void generatepaths(char (*rgWild)[40], char **ppWild, size_t cWild, 
+                   char (*rgTame)[48], size_t cTame)
+{
+    srand(9753);
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        int iForm = rand() % 10;
+
+        if (iForm < 3)
+        {
+            sprintf(rgWild[iWild], "d%04d/f%05d.e%04d", rand() % 10000, 
+                    rand() % 100000, rand() % 10000);
+        }
+        else if (iForm < 5)
+        {
+            sprintf(rgWild[iWild], "*.e%04d", rand() % 10000);
+        }
+        else if (iForm < 8)
+        {
+            sprintf(rgWild[iWild], "d%04d/*/f%05d*", rand() % 10000, 
+                    rand() % 100000);
+        }
+        else
+        {
+            sprintf(rgWild[iWild], "*/t%03d/*f%04d?.e*", rand() % 1000, 
+                    rand() % 10000);
+        }
+
+        ppWild[iWild] = rgWild[iWild];
+    }
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        sprintf(rgTame[iTame], "d%04d/t%03d/f%05d.e%04d", rand() % 10000, 
+                rand() % 1000, rand() % 100000, rand() % 10000);
+    }
+
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && (COMPARE_IMAGE || COMPARE_ARENA ||
+        // COMPARE_PARALLEL)
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_IMAGE)
+// Compares the startup time of compiling a set of 200,000 patterns against 
+// loading the same set from an image file, along with the time taken by 
+// the first match after startup and by matches after that.
+//
+void benchimage(void)
+{
+    size_t cWild = 200000;
+    size_t cTame = 10000;
+    const char *pPath = "wildbenchimage.bin";
+    char (*rgWild)[40] = (char (*)[40]) malloc(cWild * 40);
+    char **ppWild = (char **) malloc(cWild * sizeof(char *));
+    size_t *piMatches = (size_t *) malloc(cWild * sizeof(size_t));
+    char (*rgTame)[48] = (char (*)[48]) malloc(cTame * 48);
+    WildPatternSet *rgSets[2] = { NULL, NULL };
+    double rgStartup[2];
+    double rgFirst[2];
+    double fSave;
+    volatile size_t cSink;
+
+    if (!rgWild || !ppWild || !piMatches || !rgTame)
+    {
+        printf("Image benchmark skipped: out of memory\n");
+        free(rgWild);
+        free(ppWild);
+        free(piMatches);
+        free(rgTame);
+        return;
+    }
+
+    generatepaths(rgWild, ppWild, cWild, rgTame, cTame);
+
+    fSave = averagenanoseconds(1, [&]() {
+        FastWildSetSave(ppWild, cWild, WILD_SET_STRATEGY_AUTO, pPath);
+    });
+    rgStartup[0] = averagenanoseconds(1, [&]() {
+        rgSets[0] = FastWildSetCompile(ppWild, cWild);
+    });
+    rgStartup[1] = averagenanoseconds(1, [&]() {
+        rgSets[1] = FastWildSetLoad(pPath);
+    });
+
+    printf("Pattern set startup, %zu patterns (image written in %.1f ms):\n", 
+           cWild, fSave / 1000000.0);
+
+    for (int iSet = 0; iSet < 2; iSet++)
+    {
+        double fTotal = 0;
+
+        if (!rgSets[iSet])
+        {
+            printf("  %-9s failed\n", iSet ? "loaded" : "compiled");
+            continue;
+        }
+
+        rgFirst[iSet] = averagenanoseconds(1, [&]() {
+            cSink = FastWildSetCompareUtf8(rgSets[iSet], rgTame[0], 
+                                           piMatches);
+        });
+
+        for (size_t iTame = 1; iTame < cTame; iTame++)
+        {
+            fTotal += averagenanoseconds(1, [&]() {
+                cSink = FastWildSetCompareUtf8(rgSets[iSet], rgTame[iTame], 
+                                               piMatches);
+            });
+        }
+
+        printf("  %-9s  ready in %9.3f ms  first match %8.1f us  "
+               "then %6.1f ns per match\n", iSet ? "loaded" : "compiled", 
+               rgStartup[iSet] / 1000000.0, rgFirst[iSet] / 1000.0, 
+               fTotal / (cTame - 1));
+        FastWildSetFree(rgSets[iSet]);
+    }
+
+    remove(pPath);
+    free(rgWild);
+    free(ppWild);
+    free(piMatches);
+    free(rgTame);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_IMAGE
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_ARENA)
+// Returns the bytes of heap in use, where the C library reports them, or 
+// 0 otherwise.
+//
+size_t heapbytes(void)
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return mallinfo2().uordblks;
+#else
+    return 0;
+#endif
+}
+
+
+// Compares 200,000 patterns compiled one at a time onto the heap against 
+// the same patterns compiled into an arena, for bytes per pattern, for 
+// the time to match every pattern against a tame string, and for the 
+// time to release them.  The heap patterns are compiled in between other 
+// short-lived allocations, as in a long-running process.  Also reports the 
+// bytes per pattern of a set of the same patterns, which packs them into 
+// one block along with its tables.
+//
+void bencharena(void)
+{
+    size_t cWild = 200000;
+    size_t cTame = 20;
+    char (*rgWild)[40] = (char (*)[40]) malloc(cWild * 40);
+    char **ppWild = (char **) malloc(cWild * sizeof(char *));
+    char (*rgTame)[48] = (char (*)[48]) malloc(cTame * 48);
+    WildPattern **ppHeap = (WildPattern **) calloc(cWild, 
+                                                   sizeof(WildPattern *));
+    WildPattern **ppArena = (WildPattern **) calloc(cWild, 
+                                                    sizeof(WildPattern *));
+    void **ppOther = (void **) calloc(cWild, sizeof(void *));
+    WildArena *pArena = FastWildArenaCreate(1024 * 1024);
+    WildPatternSet *pSet = NULL;
+    size_t cbHeap = heapbytes();
+    size_t cbArena;
+    size_t cbReserved;
+    double rgMatch[2] = { 0, 0 };
+    double rgFree[2];
+    double fSetCompile;
+    volatile size_t cSink = 0;
+
+    if (!rgWild || !ppWild || !rgTame || !ppHeap || !ppArena || !ppOther || 
+        !pArena)
+    {
+        printf("Arena benchmark skipped: out of memory\n");
+        free(rgWild);
+        free(ppWild);
+        free(rgTame);
+        free(ppHeap);
+        free(ppArena);
+        free(ppOther);
+        FastWildArenaFree(pArena);
+        return;
+    }
+
+    generatepaths(rgWild, ppWild, cWild, rgTame, cTame);
+
+    // The heap's footprint is taken before other allocations join in.
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        ppHeap[iWild] = FastWildPatternCompile(ppWild[iWild]);
+    }
+
+    cbHeap = heapbytes() - cbHeap;
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        FastWildPatternFree(ppHeap[iWild]);
+    }
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        ppHeap[iWild] = FastWildPatternCompile(ppWild[iWild]);
+        ppOther[iWild] = malloc(16 + rand() % 240);
+    }
+
+    for (size_t iWild = 0; iWild < cWild; iWild += 2)
+    {
+        free(ppOther[iWild]);
+        ppOther[iWild] = NULL;
+    }
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        ppArena[iWild] = FastWildPatternCompileArena(ppWild[iWild], pArena);
+    }
+
+    FastWildArenaBytes(pArena, &cbArena, &cbReserved);
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        rgMatch[0] += averagenanoseconds(1, [&]() {
+            for (size_t iWild = 0; iWild < cWild; iWild++)
+            {
+                cSink += FastWildPatternCompareUtf8(ppHeap[iWild], 
+                                                    rgTame[iTame]);
+            }
+        });
+        rgMatch[1] += averagenanoseconds(1, [&]() {
+            for (size_t iWild = 0; iWild < cWild; iWild++)
+            {
+                cSink += FastWildPatternCompareUtf8(ppArena[iWild], 
+                                                    rgTame[iTame]);
+            }
+        });
+    }
+
+    rgFree[0] = averagenanoseconds(1, [&]() {
+        for (size_t iWild = 0; iWild < cWild; iWild++)
+        {
+            FastWildPatternFree(ppHeap[iWild]);
+        }
+    });
+    rgFree[1] = averagenanoseconds(1, [&]() {
+        FastWildArenaFree(pArena);
+    });
+    fSetCompile = averagenanoseconds(1, [&]() {
+        pSet = FastWildSetCompile(ppWild, cWild);
+    });
+
+    printf("Compiled pattern storage, %zu patterns:\n", cWild);
+
+    if (cbHeap)
+    {
+        printf("  heap    %6.1f bytes per pattern", (double) cbHeap / cWild);
+    }
+    else
+    {
+        printf("  heap       n/a bytes per pattern");
+    }
+
+    printf("  %5.1f ns per match  released in %6.2f ms\n", 
+           rgMatch[0] / (cTame * cWild), rgFree[0] / 1000000.0);
+    printf("  arena   %6.1f bytes per pattern  %5.1f ns per match  "
+           "released in %6.2f ms\n", (double) cbArena / cWild, 
+           rgMatch[1] / (cTame * cWild), rgFree[1] / 1000000.0);
+
+    if (pSet)
+    {
+        printf("  set     %6.1f bytes per pattern, tables included "
+               "(compiled in %.1f ms)\n", 
+               (double) FastWildSetBytes(pSet) / cWild, 
+               fSetCompile / 1000000.0);
+    }
+
+    for (size_t iWild = 0; iWild < cWild; iWild++)
+    {
+        free(ppOther[iWild]);
+    }
+
+    FastWildSetFree(pSet);
+    free(rgWild);
+    free(ppWild);
+    free(rgTame);
+    free(ppHeap);
+    free(ppArena);
+    free(ppOther);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_ARENA
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_PARALLEL)
+// Times compiling a set of 1,000,000 patterns on 1 thread, then on twice 
+// as many threads at a time, up to one per processor, and reports each 
+// speedup over 1 thread.  Every set should be the same size.
+//
+void benchparallel(void)
+{
+    size_t cWild = 1000000;
+    size_t cTame = 1;
+    char (*rgWild)[40] = (char (*)[40]) malloc(cWild * 40);
+    char **ppWild = (char **) malloc(cWild * sizeof(char *));
+    char (*rgTame)[48] = (char (*)[48]) malloc(cTame * 48);
+    unsigned cProcessors = std::thread::hardware_concurrency();
+    size_t cbFirst = 0;
+    double fFirst = 0;
+
+    if (!rgWild || !ppWild || !rgTame)
+    {
+        printf("Parallel compile benchmark skipped: out of memory\n");
+        free(rgWild);
+        free(ppWild);
+        free(rgTame);
+        return;
+    }
+
+    generatepaths(rgWild, ppWild, cWild, rgTame, cTame);
+    printf("Set compile time, %zu patterns, %u processors:\n", cWild, 
+           cProcessors);
+
+    for (unsigned cThreads = 1;; cThreads *= 2)
+    {
+        WildPatternSet *pSet = NULL;
+        double fCompile;
+
+        cThreads = cThreads < cProcessors ? cThreads : cProcessors;
+        cThreads = cThreads ? cThreads : 1;
+        fCompile = averagenanoseconds(1, [&]() {
+            pSet = FastWildSetCompileThreads(ppWild, cWild, 
+                WILD_SET_STRATEGY_AUTO, NULL, cThreads);
+        });
+
+        if (cThreads == 1)
+        {
+            cbFirst = FastWildSetBytes(pSet);
+            fFirst = fCompile;
+        }
+
+        printf("  %3u threads  %8.1f ms  %5.2fx%s\n", cThreads, 
+               fCompile / 1000000.0, fFirst / fCompile, 
+               FastWildSetBytes(pSet) == cbFirst ? "" : "  (size differs)");
+        FastWildSetFree(pSet);
+
+        if (cThreads >= cProcessors)
+        {
+            break;
+        }
+    }
+
+    free(rgWild);
+    free(ppWild);
+    free(rgTame);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_PARALLEL
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_CAPTURE)
+// Compares matching with captures against matching alone, over key paths 
+// of the kind a rewrite rule picks apart.
+//
+void benchcapture(void)
+{
+    static char *rgWild[] =
+    {
+        "users/*/orders/*/item?", "*/orders/*", "users/????\?/*/*", 
+        "*.json", "users/*4*/orders/*7*/*", 
+    };
+    size_t cTame = 10000;
+    char (*rgTame)[64] = (char (*)[64]) malloc(cTame * 64);
+    size_t cWild = sizeof(rgWild) / sizeof(rgWild[0]);
+    size_t cMatches = 0;
+    size_t cCaptures = 0;
+    WildSpan rgSpans[8];
+    size_t cSpans;
+    volatile size_t cSink;
+
+    if (!rgTame)
+    {
+        printf("Capture benchmark skipped: out of memory\n");
+        return;
+    }
+
+    srand(1357);
+
+    for (size_t iTame = 0; iTame < cTame; iTame++)
+    {
+        sprintf(rgTame[iTame], rand() % 4 ? "users/%05d/orders/%d/item%d" : 
+                "users/%05d/orders/%d/item%d.json", rand() % 100000, 
+                rand() % 10000, rand() % 10);
+    }
+
+    double fCompare = averagenanoseconds(10, [&]() {
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            for (size_t iWild = 0; iWild < cWild; iWild++)
+            {
+                cMatches += FastWildCompareUtf8(rgWild[iWild], rgTame[iTame]);
+            }
+        }
+    }) / (cTame * cWild);
+    double fCapture = averagenanoseconds(10, [&]() {
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            for (size_t iWild = 0; iWild < cWild; iWild++)
+            {
+                cCaptures += FastWildCaptureUtf8(rgWild[iWild], rgTame[iTame], 
+                                                 rgSpans, 8, &cSpans);
+            }
+        }
+
+        cSink = cMatches + cCaptures;
+    }) / (cTame * cWild);
+
+    printf("Capture, %zu patterns by %zu key paths (%.1f%% matching):\n", 
+           cWild, cTame, 100.0 * cMatches / (10.0 * cTame * cWild));
+    printf("  ns per pair: compare %6.1f  capture %6.1f  (%.2fx)\n", 
+           fCompare, fCapture, fCapture / fCompare);
+    free(rgTame);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_CAPTURE
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_REWRITE)
+// Compares batch rewriting of 10^7 keys, a million at a time, against 
+// matching each key, then capturing its spans, then formatting the result 
+// by walking the template, as a rename job might otherwise do.
+//
+void benchrewrite(void)
+{
+    char *pWild = (char *) "logs/*/*.txt";
+    char *pTemplate = (char *) "archive/#1/#2.txt.gz";
+    size_t cTame = 1000000;
+    size_t cRounds = 10;
+    char (*rgTame)[32] = (char (*)[32]) malloc(cTame * 32);
+    char **ppTame = (char **) malloc(cTame * sizeof(char *));
+    char **ppOut = (char **) malloc(cTame * sizeof(char *));
+    WildArena *pArena = FastWildArenaCreate(64 << 20);
+    WildRewrite *pRewrite = FastWildRewriteCompile(pWild, pTemplate);
+    double fBatch = 0;
+    double fSteps = 0;
+    size_t cMatches = 0;
+    volatile size_t cSink;
+
+    if (!rgTame || !ppTame || !ppOut || !pArena || !pRewrite)
+    {
+        printf("Rewrite benchmark skipped: out of memory\n");
+        free(rgTame);
+        free(ppTame);
+        free(ppOut);
+        FastWildArenaFree(pArena);
+        FastWildRewriteFree(pRewrite);
+        return;
+    }
+
+    srand(8642);
+
+    for (size_t iRound = 0; iRound < cRounds; iRound++)
+    {
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            sprintf(rgTame[iTame], rand() % 8 ? "logs/d%03d/f%06d.txt" : 
+                    "logs/d%03d/f%06d.log", rand() % 1000, rand() % 1000000);
+            ppTame[iTame] = rgTame[iTame];
+        }
+
+        FastWildArenaReset(pArena);
+        fBatch += averagenanoseconds(1, [&]() {
+            FastWildRewriteBatchUtf8(pRewrite, ppTame, cTame, pArena, ppOut);
+        });
+
+        for (size_t iTame = 0; iTame < cTame; iTame++)
+        {
+            cMatches += ppOut[iTame] != NULL;
+        }
+
+        FastWildArenaReset(pArena);
+        fSteps += averagenanoseconds(1, [&]() {
+            for (size_t iTame = 0; iTame < cTame; iTame++)
+            {
+                WildSpan rgSpans[8];
+                char szOut[96];
+                size_t cbOut = 0;
+
+                ppOut[iTame] = NULL;
+
+                if (!FastWildCompareUtf8(pWild, ppTame[iTame]))
+                {
+                    continue;
+                }
+
+                FastWildCaptureUtf8(pWild, ppTame[iTame], rgSpans, 8, NULL);
+
+                for (char *pChar = pTemplate; *pChar;)
+                {
+                    if (*pChar == '#')
+                    {
+                        WildSpan *pSpan = &rgSpans[strtoul(pChar + 1, &pChar, 
+                                                           10) - 1];
+
+                        memcpy(szOut + cbOut, ppTame[iTame] + pSpan->iOffset, 
+                               pSpan->cbSpan);
+                        cbOut += pSpan->cbSpan;
+                    }
+                    else
+                    {
+                        szOut[cbOut++] = *pChar++;
+                    }
+                }
+
+                szOut[cbOut] = '\0';
+                ppOut[iTame] = (char *) FastWildArenaAlloc(pArena, cbOut + 1, 
+                                                           1);
+                memcpy(ppOut[iTame], szOut, cbOut + 1);
+                cSink = cbOut;
+            }
+        });
+    }
+
+    printf("Rewriting %zu keys, %zu matching:\n", cTame * cRounds, cMatches);
+    printf("  ns per key: batch %6.1f  match, capture, format %6.1f  "
+           "(%.2fx)\n", fBatch / (cTame * cRounds), 
+           fSteps / (cTame * cRounds), fSteps / fBatch);
+
+    free(rgTame);
+    free(ppTame);
+    free(ppOut);
+    FastWildArenaFree(pArena);
+    FastWildRewriteFree(pRewrite);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_REWRITE
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_SEARCH)
+// Compares finding every match of a few patterns within a large buffer of 
+// log lines against matching each line, as a null-terminated string, to 
+// the pattern with stars added at both ends.
+//
+void benchsearch(void)
+{
+    static const char *rgWild[] = 
+    {
+        "ERROR*full", "user=42?? ", "latency=9?ms", 
+    };
+    static const char *rgLevels[] = { "INFO", "WARN", "DEBUG" };
+    size_t cbMax = 64 << 20;
+    size_t cbText = 0;
+    size_t cLines = 0;
+    char *pText = (char *) malloc(cbMax);
+    char *pLines = (char *) malloc(cbMax);
+    char **ppLines = (char **) malloc(cbMax / 32 * sizeof(char *));
+    WildSpan rgMatches[256];
+
+    if (!pText || !pLines || !ppLines)
+    {
+        printf("Search benchmark skipped: out of memory\n");
+        free(pText);
+        free(pLines);
+        free(ppLines);
+        return;
+    }
+
+    srand(97531);
+
+    while (cbText + 160 < cbMax)
+    {
+        if (rand() % 1000)
+        {
+            cbText += sprintf(pText + cbText, "2025-10-16T%02d:%02d:%02d %s "
+                              "user=%d req=%08x latency=%dms "
+                              "path=/api/v1/items/%d\n", rand() % 24, 
+                              rand() % 60, rand() % 60, rgLevels[rand() % 3], 
+                              rand() % 10000, rand(), rand() % 200, 
+                              rand() % 100000);
+        }
+        else
+        {
+            cbText += sprintf(pText + cbText, "2025-10-16T%02d:%02d:%02d "
+                              "ERROR disk full on /dev/sd%c%d\n", 
+                              rand() % 24, rand() % 60, rand() % 60, 
+                              'a' + rand() % 4, rand() % 8);
+        }
+    }
+
+    memcpy(pLines, pText, cbText);
+
+    for (char *pLine = pLines; pLine < pLines + cbText;)
+    {
+        char *pEnd = (char *) memchr(pLine, '\n', pLines + cbText - pLine);
+
+        *pEnd = '\0';
+        ppLines[cLines++] = pLine;
+        pLine = pEnd + 1;
+    }
+
+    printf("Search of %.0f MB of log lines (%zu lines):\n", 
+           cbText / 1048576.0, cLines);
+
+    for (size_t iWild = 0; iWild < sizeof(rgWild) / sizeof(char *); iWild++)
+    {
+        char szStarred[64];
+        size_t cMatches = 0;
+        size_t cLinesMatched = 0;
+
+        sprintf(szStarred, "*%s*", rgWild[iWild]);
+
+        double fSearch = averagenanoseconds(1, [&]() {
+            size_t iNext = 0;
+
+            do
+            {
+                cMatches += FastWildSearchUtf8((char *) rgWild[iWild], pText, 
+                                               cbText, iNext, rgMatches, 
+                                               256, &iNext);
+            } while (iNext < cbText);
+        });
+        double fLines = averagenanoseconds(1, [&]() {
+            for (size_t iLine = 0; iLine < cLines; iLine++)
+            {
+                cLinesMatched += FastWildCompareUtf8(szStarred, 
+                                                     ppLines[iLine]);
+            }
+        });
+
+        printf("  %-14s %8zu matches  %7.0f MB/s  "
+               "(%8zu lines, %7.0f MB/s line by line)\n", rgWild[iWild], 
+               cMatches, cbText / 1048576.0 / (fSearch / 1000000000.0), 
+               cLinesMatched, cbText / 1048576.0 / (fLines / 1000000000.0));
+    }
+
+    free(pText);
+    free(pLines);
+    free(ppLines);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_SEARCH
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_PARTIAL)
+// A synthetic tree of 1,011,110 nodes, five levels deep, whose names are 
+// made from each node's level and index among its siblings.
+//
+#define TREE_LEVELS  5
+
+static const size_t rgTreeFanout[TREE_LEVELS] = { 10, 10, 10, 10, 100 };
+
+
+// Appends the name of a node in the synthetic tree to its parent's path.  
+// Returns the length of the node's path.
+//
+size_t treepath(char *pPath, size_t cbPath, size_t iLevel, size_t iChild)
+{
+    char *pName = pPath + cbPath;
+
+    if (cbPath)
+    {
+        *pName++ = '/';
+    }
+
+    switch (iLevel)
+    {
+    case 0:
+        pName += sprintf(pName, "team%02zu", iChild);
+        break;
+    case 1:
+        pName += sprintf(pName, "proj%02zu", iChild);
+        break;
+    case 2:
+        pName += sprintf(pName, "v%zu", iChild);
+        break;
+    case 3:
+        pName += sprintf(pName, "mod%02zu", iChild);
+        break;
+    default:
+        pName += sprintf(pName, "f%03zu.%s", iChild, 
+                         iChild % 2 ? "log" : "txt");
+        break;
+    }
+
+    return pName - pPath;
+}
+
+
+// Walks the synthetic tree below a path, counting the nodes visited and 
+// returning the number whose paths match a pattern.  With iMode 0, every 
+// node is visited and matched via FastWildCompareUtf8().  With iMode 1, 
+// each node's path is passed to FastWildPartialUtf8(), and with iMode 2, 
+// the parent's state is extended via FastWildPartialExtendUtf8(), and in 
+// either case the walk goes no deeper than a path that can't match.
+//
+size_t treewalk(char *pWild, int iMode, char *pPath, size_t cbPath, 
+                size_t iLevel, WildPartial *pState, size_t *pcVisited)
+{
+    size_t cMatches = 0;
+
+    for (size_t iChild = 0; iChild < rgTreeFanout[iLevel]; iChild++)
+    {
+        size_t cbChild = treepath(pPath, cbPath, iLevel, iChild);
+        WildPartial state = *pState;
+        int iResult;
+
+        if (iMode == 0)
+        {
+            iResult = FastWildCompareUtf8(pWild, pPath) ? 
+                      WILD_PARTIAL_FULL_MATCH : WILD_PARTIAL_POSSIBLE;
+        }
+        else if (iMode == 1)
+        {
+            iResult = FastWildPartialUtf8(pWild, pPath);
+        }
+        else
+        {
+            iResult = FastWildPartialExtendUtf8(pWild, &state, pPath, 
+                                                cbChild);
+        }
+
+        (*pcVisited)++;
+        cMatches += iResult == WILD_PARTIAL_FULL_MATCH;
+
+        if (iResult != WILD_PARTIAL_NO && iLevel + 1 < TREE_LEVELS)
+        {
+            cMatches += treewalk(pWild, iMode, pPath, cbChild, iLevel + 1, 
+                                 &state, pcVisited);
+        }
+    }
+
+    pPath[cbPath] = '\0';
+    return cMatches;
+}
+
+
+// Compares walks of the synthetic tree that visit every node against 
+// walks pruned by partial matching, whole-path and incremental.
+//
+void benchpartial(void)
+{
+    static char *rgWild[] =
+    {
+        "team03/proj0?/v2/*/f0*.txt", "team0?/proj07/v?/mod0?/f01?.log", 
+        "*/proj07/*/mod0?/f01?.log", "team0?/*", 
+    };
+    static const char *rgModes[] = { "every node", "whole path", 
+                                     "incremental" };
+    char szPath[256];
+
+    printf("Tree walk, %zu levels, pruned by partial matching:\n", 
+           (size_t) TREE_LEVELS);
+
+    for (size_t iWild = 0; iWild < sizeof(rgWild) / sizeof(char *); iWild++)
+    {
+        printf("  %s\n", rgWild[iWild]);
+
+        for (int iMode = 0; iMode < 3; iMode++)
+        {
+            WildPartial state;
+            size_t cVisited = 0;
+            size_t cMatches = 0;
+
+            FastWildPartialStart(&state);
+            szPath[0] = '\0';
+
+            double fWalk = averagenanoseconds(1, [&]() {
+                cMatches = treewalk(rgWild[iWild], iMode, szPath, 0, 0, 
+                                    &state, &cVisited);
+            });
+
+            printf("    %-12s %8zu nodes visited  %7zu matches  %8.1f ms\n", 
+                   rgModes[iMode], cVisited, cMatches, fWalk / 1000000.0);
+        }
+    }
+
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_PARTIAL
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_FILTER)
+// Times each keystroke of a search pattern being typed over 500,000 file 
+// names, filtered incrementally, against matching every name to the 
+// pattern with '*' appended.
+//
+void benchfilter(void)
+{
+    static const char *rgDirs[] = { "src", "lib", "test", "docs", "tools" };
+    static const char *rgWords[] =
+    {
+        "net", "core", "util", "io", "http", "json", "parse", "render", 
+        "audio", "video", "cache", "store", "index", "query", "table", 
+        "log", "crypt", "auth", "user", "image", 
+    };
+    static const char *rgExts[] = { "cpp", "h", "py", "js", "md", "txt" };
+    static const char *rgTyped = "src/*cache_?u*.h\b\b.cpp";
+    size_t cNames = 500000;
+    char (*rgNames)[48] = (char (*)[48]) malloc(cNames * 48);
+    char **ppNames = (char **) malloc(cNames * sizeof(char *));
+    WildFilter *pFilter = NULL;
+    char szTyped[64];
+    char szWild[sizeof(szTyped) + 1];
+    size_t cbTyped = 0;
+    double fTotal = 0;
+    double fTotalFull = 0;
+
+    if (rgNames && ppNames)
+    {
+        srand(24680);
+
+        for (size_t iName = 0; iName < cNames; iName++)
+        {
+            sprintf(rgNames[iName], "%s/%s/%s_%s%d.%s", rgDirs[rand() % 5], 
+                    rgWords[rand() % 20], rgWords[rand() % 20], 
+                    rgWords[rand() % 20], rand() % 100, rgExts[rand() % 6]);
+            ppNames[iName] = rgNames[iName];
+        }
+
+        pFilter = FastWildFilterCreate(ppNames, cNames);
+    }
+
+    if (!pFilter)
+    {
+        printf("Filter benchmark skipped: out of memory\n");
+        free(rgNames);
+        free(ppNames);
+        return;
+    }
+
+    printf("Filtering %zu names per keystroke, incrementally and in full "
+           "(us):\n", cNames);
+
+    // Each '\b' deletes the last code point typed.
+    for (const char *pKey = rgTyped; *pKey; pKey++)
+    {
+        size_t *piSelected;
+        size_t cSelected = 0;
+        size_t cFull = 0;
+
+        cbTyped = *pKey == '\b' ? cbTyped - 1 : cbTyped + 1;
+        szTyped[cbTyped - (*pKey != '\b')] = *pKey;
+        szTyped[cbTyped] = '\0';
+        sprintf(szWild, "%s*", szTyped);
+
+        double fFilter = averagenanoseconds(1, [&]() {
+            FastWildFilterUtf8(pFilter, szTyped, &piSelected, &cSelected);
+        });
+        double fFull = averagenanoseconds(1, [&]() {
+            for (size_t iName = 0; iName < cNames; iName++)
+            {
+                cFull += FastWildCompareUtf8(szWild, ppNames[iName]);
+            }
+        });
+
+        fTotal += fFilter;
+        fTotalFull += fFull;
+        printf("  %-18s %7zu selected %9.1f %9.1f%s\n", szTyped, cSelected, 
+               fFilter / 1000.0, fFull / 1000.0, 
+               cFull == cSelected ? "" : "  MISMATCH");
+    }
+
+    printf("  %-18s %16s %9.1f %9.1f\n", "per keystroke", "", 
+           fTotal / 1000.0 / strlen(rgTyped), 
+           fTotalFull / 1000.0 / strlen(rgTyped));
+    FastWildFilterFree(pFilter);
+    free(rgNames);
+    free(ppNames);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_FILTER
+
+
+#if defined(COMPARE_PERFORMANCE) && defined(COMPARE_PATH)
+// Compares path-aware matching against splitting each path and pattern 
+// into components and matching those, over a million generated paths of 
+// one to eight components, for patterns of the kinds found in .gitignore 
+// files and build scripts.
+//
+void benchpath(void)
+{
+    static const char *rgRoots[] =
+    {
+        "src", "lib", "test", "docs", "node_modules", "home/kim", 
+        "home/ana", "usr/share", "build", ".git", 
+    };
+    static const char *rgWords[] =
+    {
+        "net", "core", "util", "io", "http", "json", "parse", "render", 
+        "audio", "video", "cache", "store", "index", "query", "table", 
+        "log", "crypt", "auth", "user", "image", "projects", "vendor", 
+        "internal", "api", 
+    };
+    static const char *rgFiles[] =
+    {
+        "main.c", "util.h", "test_io.py", "index.js", "package.json", 
+        "README.md", "Makefile", "config.yaml", "cache.cpp", "notes.txt", 
+    };
+    static char *rgWild[] =
+    {
+        "src/**/*.c", "**/test_*.py", "**/node_modules/**/package.json", 
+        "home/*/projects/**", "*/*/README.md", "**/*cache*/**/*.h", 
+        "build/*/*", 
+    };
+    size_t cPaths = 1000000;
+    char (*rgPaths)[128] = (char (*)[128]) malloc(cPaths * 128);
+
+    if (!rgPaths)
+    {
+        printf("Path benchmark skipped: out of memory\n");
+        return;
+    }
+
+    srand(13579);
+
+    for (size_t iPath = 0; iPath < cPaths; iPath++)
+    {
+        size_t cbPath = sprintf(rgPaths[iPath], "%s", rgRoots[rand() % 10]);
+
+        for (int cDirs = rand() % 6; cDirs > 0; cDirs--)
+        {
+            cbPath += sprintf(rgPaths[iPath] + cbPath, "/%s", 
+                              rgWords[rand() % 24]);
+        }
+
+        sprintf(rgPaths[iPath] + cbPath, "/%s", rgFiles[rand() % 10]);
+    }
+
+    printf("Matching %zu paths, path-aware and split into components " 
+           "(ms):\n", cPaths);
+
+    for (size_t iWild = 0; iWild < sizeof(rgWild) / sizeof(char *); iWild++)
+    {
+        size_t cMatches = 0;
+        size_t cSplitMatches = 0;
+
+        double fPath = averagenanoseconds(1, [&]() { 
+            for (size_t iPath = 0; iPath < cPaths; iPath++)
+            {
+                cMatches += FastWildPathCompareUtf8(rgWild[iWild], 
+                                                    rgPaths[iPath]);
+            }
+        });
+        double fSplit = averagenanoseconds(1, [&]() { 
+            for (size_t iPath = 0; iPath < cPaths; iPath++)
+            {
+                cSplitMatches += pathslowly(rgWild[iWild], rgPaths[iPath]);
+            }
+        });
+
+        printf("  %-32s %7zu matches %8.1f %8.1f%s\n", rgWild[iWild], 
+               cMatches, fPath / 1000000.0, fSplit / 1000000.0, 
+               cMatches == cSplitMatches ? "" : "  MISMATCH");
+    }
+
+    free(rgPaths);
+    return;
+}
+#endif  // COMPARE_PERFORMANCE && COMPARE_PATH
+
+
+int main(void)
+{
+#if defined(COMPARE_PERFORMANCE)
+	// Clear accumulated times and the UTF-8 test status flag.
+	iAccumulatedTimeUtf8 = iAccumulatedTimeLenUtf8 = iAccumulatedTimeAscii = 0;
+#endif
+
+#if defined(COMPARE_TAME)
+	testtame();
+#endif
+
+#if defined(COMPARE_EMPTY)
+	testempty();
+#endif
+
+#if defined(COMPARE_WILD)
+	testwild();
+#endif
+
+#if defined(COMPARE_UTF8)
+	testutf8();
+#endif
+
+#if defined(COMPARE_BATCH)
+	testbatch();
+#endif
+
+#if defined(COMPARE_SET)
+	testset();
+#endif
+
+#if defined(COMPARE_NFA)
+	testnfa();
+#endif
+
+#if defined(COMPARE_RULES)
+	testrules();
+#endif
+
+#if defined(COMPARE_PRUNE)
+	testprune();
+#endif
+
+#if defined(COMPARE_CACHE)
+	testcache();
+#endif
+
+#if defined(COMPARE_MEMO)
+	testmemo();
+#endif
+
+#if defined(COMPARE_LIVE)
+	testlive();
+#endif
+
+#if defined(COMPARE_IMAGE)
+	testimage();
+#endif
+
+#if defined(COMPARE_ARENA)
+	testarena();
+#endif
+
+#if defined(COMPARE_PARALLEL)
+	testparallel();
+#endif
+
+#if defined(COMPARE_CAPTURE)
+	testcapture();
+#endif
+
+#if defined(COMPARE_REWRITE)
+	testrewrite();
+#endif
+
+#if defined(COMPARE_SEARCH)
+	testsearch();
+#endif
+
+#if defined(COMPARE_PARTIAL)
+	testpartial();
+#endif
+
+#if defined(COMPARE_FILTER)
+	testfilter();
+#endif
+
+#if defined(COMPARE_PATH)
+	testpath();
+#endif
+
+#if defined(COMPARE_PERFORMANCE)
+    // Timings have been accumulated via file-scope data.
+    double fBase = 10.0;
+    double fExpNanoseconds = 9.0;
+    double fExpMilliseconds = 3.0;
+
+    // Represent the timings in seconds, to millisecond precision.
+    double fTimeCumulativeAsciiVersion = 
+            ((double) (iAccumulatedTimeAscii) /
+                pow(fBase, fExpNanoseconds)) * pow(fBase, fExpMilliseconds);
+    double fTimeCumulativeUtf8Version = 
+            ((double) (iAccumulatedTimeUtf8) /
+                pow(fBase, fExpNanoseconds)) * pow(fBase, fExpMilliseconds);
+    double fTimeCumulativeLenUtf8Version = 
+            ((double) (iAccumulatedTimeLenUtf8) /
+                pow(fBase, fExpNanoseconds)) * pow(fBase, fExpMilliseconds);
+    // Can set up similar calculations for more performance comparisons.
+
+    float fAsciiVersionTimeInSeconds = fTimeCumulativeAsciiVersion / 1000;
+    float fUtf8VersionTimeInSeconds = fTimeCumulativeUtf8Version / 1000;
+    float fUtf8LenVersionTimeInSeconds = fTimeCumulativeLenUtf8Version / 1000;
+
+    // Show the timing results.
+    printf(
+       "FastWildCompare() - for ASCII strings: %.3f seconds\n",
+           fAsciiVersionTimeInSeconds);
+    printf(
+       "FastWildCompareUtf8() - for UTF-8-encoded strings: %.3f seconds\n",
+           fUtf8VersionTimeInSeconds);
+    printf(
+       "FastWildLenCompareUtf8() - for UTF-8-encoded strings: %.3f seconds\n",
+           fUtf8LenVersionTimeInSeconds);
+
+#if defined(COMPARE_JIT)
+    benchjit();
+#endif
+
+#if defined(COMPARE_BATCH)
+    benchbatch();
+    benchlanes();
+#endif
+
+#if defined(COMPARE_PATTERN)
+    benchpattern();
+    benchshapes();
+    benchanchors();
+    benchprefilter();
+#endif
+
+#if defined(COMPARE_SET)
+    benchset();
+    benchindex();
+#endif
+
+#if defined(COMPARE_NFA)
+    benchnfa();
+#endif
+
+#if defined(COMPARE_RULES)
+    benchrules();
+#endif
+
+#if defined(COMPARE_PRUNE)
+    benchprune();
+#endif
+
+#if defined(COMPARE_CACHE)
+    benchcache();
+#endif
+
+#if defined(COMPARE_MEMO)
+    benchmemo();
+#endif
+
+#if defined(COMPARE_LIVE) && defined(COMPARE_SET)
+    benchlive();
+#endif
+
+#if defined(COMPARE_IMAGE)
+    benchimage();
+#endif
+
+#if defined(COMPARE_ARENA)
+    bencharena();
+#endif
+
+#if defined(COMPARE_PARALLEL)
+    benchparallel();
+#endif
+
+#if defined(COMPARE_CAPTURE)
+    benchcapture();
+#endif
+
+#if defined(COMPARE_REWRITE)
+    benchrewrite();
+#endif
+
+#if defined(COMPARE_SEARCH)
+    benchsearch();
+#endif
+
+#if defined(COMPARE_PARTIAL)
+    benchpartial();
+#endif
+
+#if defined(COMPARE_FILTER)
+    benchfilter();
+#endif
+
+#if defined(COMPARE_PATH)
+    benchpath();
+#endif
 #endif
 
 	return 0;
@@ -0,0 +1,155 @@
+// A tool for building pattern set images from pattern lists in C/C++.
+//
+// Copyright 2025 Kirk J Krauss.  This is a Derivative Work based on 
+// material that is copyright 2018 IBM Corporation and available at
+//
+//     https://developforperformance.com/MatchingWildcards_AnImprovedAlgorithmForBigData.html
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     https://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// Usage: wildsetbuild <pattern list> <image file> [auto|each|ac|teddy]
+//
+// Reads UTF-8 patterns, one per line, and writes a compiled set of them
+// via FastWildSetSave(), for loading via FastWildSetLoad().  Pattern i of
+// the set is line i of the list, counting from 0.  Line endings, whether
+// "\n" or "\r\n", aren't part of the patterns.  Build it along with the
+// library:
+//
+//     g++ -O2 -o wildsetbuild wildsetbuild.cpp fastwild*.cpp -lpthread
+//
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "fastwildset.h"
+
+
+int main(int argc, char **argv)
+{
+    static const char *rgStrategies[] = { "auto", "each", "ac", "teddy" };
+    int iStrategy = WILD_SET_STRATEGY_AUTO;
+    FILE *pList;
+    char *pText = NULL;
+    char **ppWild = NULL;
+    size_t cbText = 0;
+    size_t cWild = 0;
+
+    if (argc == 4)
+    {
+        for (iStrategy = 3; iStrategy > 0; iStrategy--)
+        {
+            if (!strcmp(argv[3], rgStrategies[iStrategy]))
+            {
+                break;
+            }
+        }
+    }
+
+    if (argc < 3 || argc > 4 ||
+        (argc == 4 && strcmp(argv[3], rgStrategies[iStrategy])))
+    {
+        fprintf(stderr, "Usage: %s <pattern list> <image file> "
+                "[auto|each|ac|teddy]\n", argv[0]);
+        return 2;
+    }
+
+    pList = fopen(argv[1], "rb");
+
+    if (!pList)
+    {
+        fprintf(stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    // The whole list is read into memory, and each line ending is
+    // replaced by a null terminator.
+    for (size_t cbMax = 0;;)
+    {
+        size_t cbRead;
+
+        if (cbText == cbMax)
+        {
+            char *pGrown;
+
+            cbMax = cbMax ? cbMax * 2 : 65536;
+            pGrown = (char *) realloc(pText, cbMax + 1);
+
+            if (!pGrown)
+            {
+                fprintf(stderr, "Out of memory\n");
+                fclose(pList);
+                free(pText);
+                return 1;
+            }
+
+            pText = pGrown;
+        }
+
+        cbRead = fread(pText + cbText, 1, cbMax - cbText, pList);
+
+        if (!cbRead)
+        {
+            break;
+        }
+
+        cbText += cbRead;
+    }
+
+    fclose(pList);
+    pText[cbText] = '\0';
+
+    for (size_t iByte = 0; iByte < cbText; iByte++)
+    {
+        cWild += pText[iByte] == '\n';
+    }
+
+    cWild += cbText && pText[cbText - 1] != '\n';
+    ppWild = (char **) malloc((cWild + 1) * sizeof(char *));
+
+    if (!ppWild)
+    {
+        fprintf(stderr, "Out of memory\n");
+        free(pText);
+        return 1;
+    }
+
+    cWild = 0;
+
+    for (char *pLine = pText; pLine < pText + cbText;)
+    {
+        char *pEnd = (char *) memchr(pLine, '\n', pText + cbText - pLine);
+
+        pEnd = pEnd ? pEnd : pText + cbText;
+        *pEnd = '\0';
+
+        if (pEnd > pLine && pEnd[-1] == '\r')
+        {
+            pEnd[-1] = '\0';
+        }
+
+        ppWild[cWild++] = pLine;
+        pLine = pEnd + 1;
+    }
+
+    if (!FastWildSetSave(ppWild, cWild, iStrategy, argv[2]))
+    {
+        fprintf(stderr, "Can't build %s\n", argv[2]);
+        free(ppWild);
+        free(pText);
+        return 1;
+    }
+
+    printf("Wrote %zu patterns to %s\n", cWild, argv[2]);
+    free(ppWild);
+    free(pText);
+    return 0;
+}